@@ -0,0 +1,479 @@
+#include <libcaer/libcaer.h>
+#include <libcaer/devices/edvs.h>
+#include <libcaer/devices/serial.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+// Simulates an eDVS4337 on a pseudo-terminal, so the serial data path can be
+// tested and benchmarked without a device. Open the printed port name with
+// caerDeviceOpenSerial() (for example by changing edvs_simple.c), any baud
+// rate works. Supports the reset, echo, event format (only E2, 4 bytes per
+// event), bias, timestamp reset and streaming commands libcaer uses.
+// With 'check', the simulator runs in a thread instead, and libcaer's eDVS
+// support reads from it: every event returned by caerDeviceDataGetBatch()
+// must match the one sent, in address, polarity, order and timestamp (which
+// in this mode is the event's number, in µs, so it wraps often). Exits with
+// an error on any difference, or if events stop arriving.
+// POSIX only (Linux, MacOS X).
+//
+// Usage: edvs_simulator [events per second, 0 = as fast as possible] [bytes lost per million]
+//        edvs_simulator check [millions of events] [events per second, 0 = as fast as possible]
+#define SIM_ARRAY_SIZE_X 128
+#define SIM_ARRAY_SIZE_Y 128
+#define SIM_EVENT_SIZE 4
+#define SIM_BIAS_NUMBER 12
+#define SIM_WRITE_CHUNK_EVENTS 1024
+#define SIM_COMMAND_MAX_LENGTH 128
+#define SIM_LCG_SEED 12345
+#define SIM_CHECK_TIMEOUT_US 2000000
+#define SIM_CHECK_MAX_ERRORS_PRINTED 10
+
+static atomic_bool globalShutdown = ATOMIC_VAR_INIT(false);
+
+static void globalShutdownSignalHandler(int signal) {
+	// Simply set the running flag to false on SIGTERM and SIGINT (CTRL+C) for global shutdown.
+	if (signal == SIGTERM || signal == SIGINT) {
+		atomic_store(&globalShutdown, true);
+	}
+}
+
+struct simulator_state {
+	int masterFd;
+	int slaveFd;
+	char portName[128];
+	bool checkMode;
+	bool echo;
+	bool streaming;
+	uint32_t biases[SIM_BIAS_NUMBER];
+	char command[SIM_COMMAND_MAX_LENGTH];
+	size_t commandLength;
+	// Event generation.
+	uint64_t eventRate;
+	uint32_t lossRate;
+	struct timespec streamStart;
+	uint64_t eventsSent;
+	uint64_t bytesLost;
+	uint64_t timestampOffset;
+	uint32_t lcgState;
+	uint32_t lossLcgState;
+	// Bytes generated, but not yet accepted by the pseudo-terminal.
+	uint8_t pending[SIM_WRITE_CHUNK_EVENTS * SIM_EVENT_SIZE];
+	size_t pendingLength;
+	size_t pendingPosition;
+};
+
+struct simulator_event {
+	uint8_t x;
+	uint8_t y;
+	bool polarity;
+};
+
+static inline uint32_t lcgNext(uint32_t *lcgState) {
+	*lcgState = (*lcgState * 1103515245U) + 12345U;
+	return (*lcgState >> 8);
+}
+
+// Next event of the synthetic stream. The check mode generates the same
+// sequence from the same seed, to know what to expect.
+static inline void simulatorNextEvent(uint32_t *lcgState, struct simulator_event *event) {
+	uint32_t rnd = lcgNext(lcgState);
+
+	event->y = (uint8_t) ((rnd & 0xFF) % SIM_ARRAY_SIZE_Y);
+	event->polarity = ((rnd >> 8) & 0x01);
+	event->x = (uint8_t) (((rnd >> 9) & 0xFF) % SIM_ARRAY_SIZE_X);
+}
+
+static uint64_t elapsedMicroseconds(const struct timespec *start) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return ((uint64_t) ((now.tv_sec - start->tv_sec) * 1000000LL) + (uint64_t) ((now.tv_nsec - start->tv_nsec) / 1000));
+}
+
+static void simulatorWrite(struct simulator_state *state, const char *message) {
+	// Responses are short, a pseudo-terminal always has room for them.
+	if (write(state->masterFd, message, strlen(message)) < 0) {
+		caerLog(CAER_LOG_WARNING, "eDVS Simulator", "Failed to write response. Error: %d.", errno);
+	}
+}
+
+static void simulatorCommand(struct simulator_state *state, const char *command) {
+	unsigned int biasID, biasValue;
+
+	if (state->echo) {
+		simulatorWrite(state, command);
+		simulatorWrite(state, "\n");
+	}
+
+	if (strcmp(command, "R") == 0) {
+		state->echo = true;
+		state->streaming = false;
+		simulatorWrite(state, "EDVS-4337 simulator, libcaer " LIBCAER_VERSION_STRING "\r\n");
+	}
+	else if (strcmp(command, "!U0") == 0) {
+		state->echo = false;
+	}
+	else if (strcmp(command, "!U1") == 0) {
+		state->echo = true;
+	}
+	else if (strcmp(command, "!E2") == 0) {
+		// 4 byte events with 16 bit timestamp, the only format simulated.
+	}
+	else if (strcmp(command, "E+") == 0) {
+		if (!state->streaming) {
+			state->streaming = true;
+			state->eventsSent = 0;
+			clock_gettime(CLOCK_MONOTONIC, &state->streamStart);
+		}
+	}
+	else if (strcmp(command, "E-") == 0) {
+		state->streaming = false;
+		state->pendingLength = 0;
+		state->pendingPosition = 0;
+	}
+	else if (strcmp(command, "!ET0") == 0) {
+		state->timestampOffset = elapsedMicroseconds(&state->streamStart);
+	}
+	else if (strcmp(command, "!BF") == 0) {
+		caerLog(CAER_LOG_DEBUG, "eDVS Simulator", "Biases flushed to chip.");
+	}
+	else if ((sscanf(command, "!B%u=%u", &biasID, &biasValue) == 2) && (biasID < SIM_BIAS_NUMBER)) {
+		state->biases[biasID] = biasValue;
+		caerLog(CAER_LOG_DEBUG, "eDVS Simulator", "Bias %u set to %u.", biasID, biasValue);
+	}
+	else {
+		caerLog(CAER_LOG_NOTICE, "eDVS Simulator", "Unknown command '%s'.", command);
+	}
+}
+
+static void simulatorRead(struct simulator_state *state) {
+	char buffer[256];
+
+	ssize_t bytesRead = read(state->masterFd, buffer, sizeof(buffer));
+
+	for (ssize_t i = 0; i < bytesRead; i++) {
+		if ((buffer[i] == '\n') || (buffer[i] == '\r')) {
+			if (state->commandLength > 0) {
+				state->command[state->commandLength] = '\0';
+				simulatorCommand(state, state->command);
+				state->commandLength = 0;
+			}
+		}
+		else if (state->commandLength < (SIM_COMMAND_MAX_LENGTH - 1)) {
+			state->command[state->commandLength++] = buffer[i];
+		}
+	}
+}
+
+static void simulatorGenerate(struct simulator_state *state) {
+	uint64_t elapsed = elapsedMicroseconds(&state->streamStart);
+
+	size_t eventsNumber = SIM_WRITE_CHUNK_EVENTS;
+
+	if (state->eventRate != 0) {
+		uint64_t eventsDue = (elapsed * state->eventRate) / 1000000 - state->eventsSent;
+
+		if (eventsDue < eventsNumber) {
+			eventsNumber = (size_t) eventsDue;
+		}
+	}
+
+	uint16_t timestamp = (uint16_t) (elapsed - state->timestampOffset);
+
+	state->pendingLength = 0;
+	state->pendingPosition = 0;
+
+	for (size_t i = 0; i < eventsNumber; i++) {
+		struct simulator_event event;
+		simulatorNextEvent(&state->lcgState, &event);
+
+		if (state->checkMode) {
+			// Timestamp is the event's number, so it can be checked exactly.
+			timestamp = (uint16_t) (state->eventsSent + i);
+		}
+
+		uint8_t eventBytes[SIM_EVENT_SIZE] = {
+			(uint8_t) (0x80 | event.y),
+			(uint8_t) ((event.polarity << 7) | event.x),
+			(uint8_t) (timestamp >> 8),
+			(uint8_t) timestamp,
+		};
+
+		for (size_t j = 0; j < SIM_EVENT_SIZE; j++) {
+			// Simulate bytes lost on the serial line.
+			if ((state->lossRate != 0) && ((lcgNext(&state->lossLcgState) % 1000000) < state->lossRate)) {
+				state->bytesLost++;
+				continue;
+			}
+
+			state->pending[state->pendingLength++] = eventBytes[j];
+		}
+	}
+
+	state->eventsSent += eventsNumber;
+}
+
+static bool simulatorOpen(struct simulator_state *state) {
+	state->masterFd = posix_openpt(O_RDWR | O_NOCTTY);
+	if ((state->masterFd < 0) || (grantpt(state->masterFd) != 0) || (unlockpt(state->masterFd) != 0)) {
+		caerLog(CAER_LOG_CRITICAL, "eDVS Simulator", "Failed to create pseudo-terminal. Error: %d.", errno);
+		return (false);
+	}
+
+	snprintf(state->portName, sizeof(state->portName), "%s", ptsname(state->masterFd));
+
+	// Keep the slave side open: this puts it in raw mode for binary data,
+	// and avoids errors on the master side while no client is connected.
+	state->slaveFd = open(state->portName, O_RDWR | O_NOCTTY);
+	if (state->slaveFd < 0) {
+		caerLog(CAER_LOG_CRITICAL, "eDVS Simulator", "Failed to open pseudo-terminal slave. Error: %d.", errno);
+		close(state->masterFd);
+		return (false);
+	}
+
+	struct termios attributes;
+	tcgetattr(state->slaveFd, &attributes);
+	cfmakeraw(&attributes);
+	tcsetattr(state->slaveFd, TCSANOW, &attributes);
+
+	fcntl(state->masterFd, F_SETFL, fcntl(state->masterFd, F_GETFL) | O_NONBLOCK);
+
+	return (true);
+}
+
+static void simulatorClose(struct simulator_state *state) {
+	close(state->slaveFd);
+	close(state->masterFd);
+}
+
+// Runs until globalShutdown is set.
+static void *simulatorRun(void *statePtr) {
+	struct simulator_state *state = statePtr;
+
+	uint64_t lastEventsSent = 0;
+	struct timespec lastPrint;
+	clock_gettime(CLOCK_MONOTONIC, &lastPrint);
+
+	while (!atomic_load_explicit(&globalShutdown, memory_order_relaxed)) {
+		if (state->streaming && (state->pendingPosition == state->pendingLength)) {
+			simulatorGenerate(state);
+		}
+
+		struct pollfd pollMaster = {.fd = state->masterFd, .events = POLLIN};
+
+		// Only wait for room to write if there is something to write, else
+		// the poll() below would return right away and spin.
+		if (state->streaming && (state->pendingPosition < state->pendingLength)) {
+			pollMaster.events |= POLLOUT;
+		}
+
+		// Wake up at least every millisecond to pace event generation.
+		if (poll(&pollMaster, 1, 1) < 0) {
+			continue;
+		}
+
+		if (pollMaster.revents & POLLIN) {
+			simulatorRead(state);
+		}
+
+		if (state->streaming && (pollMaster.revents & POLLOUT)) {
+			ssize_t bytesWritten = write(state->masterFd, state->pending + state->pendingPosition,
+				state->pendingLength - state->pendingPosition);
+			if (bytesWritten > 0) {
+				state->pendingPosition += (size_t) bytesWritten;
+			}
+		}
+
+		if (state->checkMode) {
+			continue;
+		}
+
+		uint64_t sinceLastPrint = elapsedMicroseconds(&lastPrint);
+		if (sinceLastPrint >= 1000000) {
+			uint64_t events = state->eventsSent - lastEventsSent;
+
+			printf("Sent %llu events/s (%.2f Mbit/s on the wire), %llu bytes lost in total.\n",
+				(unsigned long long) ((events * 1000000) / sinceLastPrint),
+				(double) (events * SIM_EVENT_SIZE * 10) / (double) sinceLastPrint,
+				(unsigned long long) state->bytesLost);
+			fflush(stdout);
+
+			lastEventsSent = state->eventsSent;
+			clock_gettime(CLOCK_MONOTONIC, &lastPrint);
+		}
+	}
+
+	return (NULL);
+}
+
+// Compare the events in a container to the expected sequence. Returns the
+// number of differences, and advances 'received' and the expected stream.
+static uint64_t simulatorCheckContainer(caerEventPacketContainer container, uint32_t *lcgState, uint64_t *received,
+	uint64_t errors) {
+	caerPolarityEventPacketConst polarity
+		= (caerPolarityEventPacketConst) caerEventPacketContainerFindEventPacketByTypeConst(container, POLARITY_EVENT);
+
+	if (polarity == NULL) {
+		return (errors);
+	}
+
+	CAER_POLARITY_CONST_ITERATOR_VALID_START(polarity)
+		struct simulator_event expected;
+		simulatorNextEvent(lcgState, &expected);
+
+		int64_t timestamp = caerPolarityEventGetTimestamp64(caerPolarityIteratorElement, polarity);
+		uint16_t x = caerPolarityEventGetX(caerPolarityIteratorElement);
+		uint16_t y = caerPolarityEventGetY(caerPolarityIteratorElement);
+		bool pol = caerPolarityEventGetPolarity(caerPolarityIteratorElement);
+
+		if ((x != expected.x) || (y != expected.y) || (pol != expected.polarity) || (timestamp != (int64_t) *received)) {
+			if (errors < SIM_CHECK_MAX_ERRORS_PRINTED) {
+				printf("Event %llu: got (%u, %u, %d) at %lld, expected (%u, %u, %d) at %llu.\n",
+					(unsigned long long) *received, x, y, pol, (long long) timestamp, expected.x, expected.y,
+					expected.polarity, (unsigned long long) *received);
+			}
+
+			errors++;
+		}
+
+		(*received)++;
+	CAER_POLARITY_ITERATOR_VALID_END
+
+	return (errors);
+}
+
+static int simulatorCheck(struct simulator_state *state, uint64_t eventsNumber) {
+	pthread_t simulatorThread;
+
+	if (pthread_create(&simulatorThread, NULL, &simulatorRun, state) != 0) {
+		caerLog(CAER_LOG_CRITICAL, "eDVS Simulator", "Failed to start simulator thread.");
+		return (EXIT_FAILURE);
+	}
+
+	uint64_t received = 0;
+	uint64_t errors = 0;
+	double duration = 0;
+
+	caerDeviceHandle edvsHandle
+		= caerDeviceOpenSerial(1, CAER_DEVICE_EDVS, state->portName, CAER_HOST_CONFIG_SERIAL_BAUD_RATE_12M);
+
+	if (edvsHandle == NULL) {
+		printf("Failed to open simulated eDVS on '%s'.\n", state->portName);
+		errors++;
+	}
+	else {
+		// Sends all biases, and makes sure data isn't dropped while waiting.
+		caerDeviceSendDefaultConfig(edvsHandle);
+		caerDeviceConfigSet(edvsHandle, CAER_HOST_CONFIG_DATAEXCHANGE, CAER_HOST_CONFIG_DATAEXCHANGE_BUFFER_SIZE, 1024);
+
+		caerDeviceDataStart(edvsHandle, NULL, NULL, NULL, NULL, NULL);
+
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		uint32_t lcgState = SIM_LCG_SEED;
+		caerEventPacketContainer containers[16];
+
+		while (received < eventsNumber) {
+			size_t containersNumber = caerDeviceDataGetBatch(edvsHandle, containers, 16, SIM_CHECK_TIMEOUT_US);
+
+			if (containersNumber == 0) {
+				printf("No events for %d ms.\n", SIM_CHECK_TIMEOUT_US / 1000);
+				errors++;
+				break;
+			}
+
+			for (size_t i = 0; i < containersNumber; i++) {
+				errors = simulatorCheckContainer(containers[i], &lcgState, &received, errors);
+
+				caerEventPacketContainerFree(containers[i]);
+			}
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		duration = (double) (end.tv_sec - start.tv_sec) + ((double) (end.tv_nsec - start.tv_nsec) / 1.0e9);
+
+		caerDeviceDataStop(edvsHandle);
+		caerDeviceClose(&edvsHandle);
+	}
+
+	atomic_store(&globalShutdown, true);
+	pthread_join(simulatorThread, NULL);
+
+	printf("Received %llu of %llu events in %.2f s, %.0f events/s, %llu errors.\n", (unsigned long long) received,
+		(unsigned long long) eventsNumber, duration, (duration > 0) ? ((double) received / duration) : (0.0),
+		(unsigned long long) errors);
+
+	return ((errors == 0) ? (EXIT_SUCCESS) : (EXIT_FAILURE));
+}
+
+int main(int argc, char *argv[]) {
+	struct sigaction shutdownAction;
+
+	shutdownAction.sa_handler = &globalShutdownSignalHandler;
+	shutdownAction.sa_flags = 0;
+	sigemptyset(&shutdownAction.sa_mask);
+	sigaddset(&shutdownAction.sa_mask, SIGTERM);
+	sigaddset(&shutdownAction.sa_mask, SIGINT);
+
+	if (sigaction(SIGTERM, &shutdownAction, NULL) == -1) {
+		caerLog(CAER_LOG_CRITICAL, "ShutdownAction", "Failed to set signal handler for SIGTERM. Error: %d.", errno);
+		return (EXIT_FAILURE);
+	}
+
+	if (sigaction(SIGINT, &shutdownAction, NULL) == -1) {
+		caerLog(CAER_LOG_CRITICAL, "ShutdownAction", "Failed to set signal handler for SIGINT. Error: %d.", errno);
+		return (EXIT_FAILURE);
+	}
+
+	static struct simulator_state state;
+	state.echo = true;
+	state.lcgState = SIM_LCG_SEED;
+	state.lossLcgState = SIM_LCG_SEED;
+	clock_gettime(CLOCK_MONOTONIC, &state.streamStart);
+
+	uint64_t checkEvents = 0;
+
+	if ((argc > 1) && (strcmp(argv[1], "check") == 0)) {
+		state.checkMode = true;
+		checkEvents = ((argc > 2) ? strtoull(argv[2], NULL, 10) : 1) * 1000 * 1000;
+		state.eventRate = (argc > 3) ? strtoull(argv[3], NULL, 10) : 0;
+	}
+	else {
+		state.eventRate = (argc > 1) ? strtoull(argv[1], NULL, 10) : 1000000;
+		state.lossRate = (argc > 2) ? (uint32_t) strtoul(argv[2], NULL, 10) : 0;
+	}
+
+	if (!simulatorOpen(&state)) {
+		return (EXIT_FAILURE);
+	}
+
+	if (state.checkMode) {
+		int result = simulatorCheck(&state, checkEvents);
+
+		simulatorClose(&state);
+
+		return (result);
+	}
+
+	printf("eDVS4337 simulator on '%s', %llu events/s (0 = unlimited), %u bytes lost per million.\n", state.portName,
+		(unsigned long long) state.eventRate, state.lossRate);
+	fflush(stdout);
+
+	simulatorRun(&state);
+
+	simulatorClose(&state);
+
+	printf("Shutdown successful.\n");
+
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,240 @@
+#include <libcaer/libcaer.h>
+#include <libcaer/ringbuffer.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+
+// Streams 16bit words from a producer thread to the main thread through
+// caerRingBuffer (one pointer per word, single and batched calls) and through
+// caerStreamRingBuffer (contiguous spans of words), and measures the words per
+// second that arrive.
+// The consumer checks that all words arrive in order. Both sides yield the
+// CPU when the ring is full/empty, so that this also works on one core.
+// The batched calls also run on a ring of only 16 places, where producer and
+// consumer keep hitting the same places: a stress test for the memory
+// ordering, most telling on weakly ordered CPUs such as ARM.
+// No device needed.
+//
+// Usage: ringbuffer_benchmark [millions of words]
+#define BENCH_RING_SIZE 65536
+#define BENCH_SMALL_RING_SIZE 16
+#define BENCH_BATCH_SIZE 256
+
+static uint64_t wordsNumber = 100 * 1000 * 1000;
+
+static double timespecDiff(const struct timespec *start, const struct timespec *end) {
+	return ((double) (end->tv_sec - start->tv_sec) + ((double) (end->tv_nsec - start->tv_nsec) / 1.0e9));
+}
+
+static void *pointerProducer(void *ringPtr) {
+	caerRingBuffer ring = ringPtr;
+
+	for (uint64_t i = 0; i < wordsNumber; i++) {
+		// NULL is not allowed in caerRingBuffer, so offset the word by one.
+		while (!caerRingBufferPut(ring, (void *) (uintptr_t) (((uint16_t) i) + 1))) {
+			sched_yield();
+		}
+	}
+
+	return (NULL);
+}
+
+static uint64_t pointerConsumer(caerRingBuffer ring) {
+	uint64_t errors = 0;
+
+	for (uint64_t i = 0; i < wordsNumber; i++) {
+		void *elem;
+
+		while ((elem = caerRingBufferGet(ring)) == NULL) {
+			sched_yield();
+		}
+
+		if ((uint16_t) ((uintptr_t) elem - 1) != (uint16_t) i) {
+			errors++;
+		}
+	}
+
+	return (errors);
+}
+
+static void *pointerBatchProducer(void *ringPtr) {
+	caerRingBuffer ring = ringPtr;
+
+	void *elems[BENCH_BATCH_SIZE];
+	uint64_t i = 0;
+
+	while (i < wordsNumber) {
+		size_t elemsNumber = 0;
+
+		while ((elemsNumber < BENCH_BATCH_SIZE) && ((i + elemsNumber) < wordsNumber)) {
+			elems[elemsNumber] = (void *) (uintptr_t) (((uint16_t) (i + elemsNumber)) + 1);
+			elemsNumber++;
+		}
+
+		size_t putNumber = 0;
+
+		while (putNumber < elemsNumber) {
+			size_t put = caerRingBufferPutBatch(ring, elems + putNumber, elemsNumber - putNumber);
+
+			if (put == 0) {
+				sched_yield();
+			}
+
+			putNumber += put;
+		}
+
+		i += elemsNumber;
+	}
+
+	return (NULL);
+}
+
+static uint64_t pointerBatchConsumer(caerRingBuffer ring) {
+	void *elems[BENCH_BATCH_SIZE];
+	uint64_t errors = 0;
+	uint64_t i = 0;
+
+	while (i < wordsNumber) {
+		size_t elemsNumber = caerRingBufferGetBatch(ring, elems, BENCH_BATCH_SIZE);
+
+		if (elemsNumber == 0) {
+			sched_yield();
+			continue;
+		}
+
+		for (size_t j = 0; j < elemsNumber; j++) {
+			if ((uint16_t) ((uintptr_t) elems[j] - 1) != (uint16_t) i++) {
+				errors++;
+			}
+		}
+	}
+
+	return (errors);
+}
+
+static void *streamProducer(void *ringPtr) {
+	caerStreamRingBuffer ring = ringPtr;
+
+	uint64_t i = 0;
+
+	while (i < wordsNumber) {
+		size_t length;
+		uint16_t *span = caerStreamRingBufferReserve(ring, &length);
+
+		if (length == 0) {
+			sched_yield();
+			continue;
+		}
+
+		if ((uint64_t) length > (wordsNumber - i)) {
+			length = (size_t) (wordsNumber - i);
+		}
+
+		for (size_t j = 0; j < length; j++) {
+			span[j] = (uint16_t) i++;
+		}
+
+		caerStreamRingBufferCommit(ring, length);
+	}
+
+	return (NULL);
+}
+
+static uint64_t streamConsumer(caerStreamRingBuffer ring) {
+	uint64_t errors = 0;
+	uint64_t i = 0;
+
+	while (i < wordsNumber) {
+		size_t length;
+		const uint16_t *span = caerStreamRingBufferPeek(ring, &length);
+
+		if (length == 0) {
+			sched_yield();
+			continue;
+		}
+
+		for (size_t j = 0; j < length; j++) {
+			if (span[j] != (uint16_t) i++) {
+				errors++;
+			}
+		}
+
+		caerStreamRingBufferRelease(ring, length);
+	}
+
+	return (errors);
+}
+
+static void printResult(const char *name, const struct timespec *start, const struct timespec *end, uint64_t errors) {
+	double duration = timespecDiff(start, end);
+
+	printf("%s: %llu words in %.2f s, %.1f Mwords/s, %llu errors.\n", name, (unsigned long long) wordsNumber,
+		duration, ((double) wordsNumber / duration) / 1.0e6, (unsigned long long) errors);
+}
+
+int main(int argc, char *argv[]) {
+	if (argc > 1) {
+		wordsNumber = strtoull(argv[1], NULL, 10) * 1000 * 1000;
+	}
+
+	struct timespec start, end;
+	pthread_t producer;
+
+	caerRingBuffer pointerRing = caerRingBufferInit(BENCH_RING_SIZE);
+	caerRingBuffer smallPointerRing = caerRingBufferInit(BENCH_SMALL_RING_SIZE);
+	caerStreamRingBuffer streamRing = caerStreamRingBufferInit(BENCH_RING_SIZE, sizeof(uint16_t));
+
+	if ((pointerRing == NULL) || (smallPointerRing == NULL) || (streamRing == NULL)) {
+		printf("Failed to allocate ring-buffers.\n");
+		return (EXIT_FAILURE);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	pthread_create(&producer, NULL, &pointerProducer, pointerRing);
+	uint64_t pointerErrors = pointerConsumer(pointerRing);
+	pthread_join(producer, NULL);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	printResult("caerRingBuffer", &start, &end, pointerErrors);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	pthread_create(&producer, NULL, &pointerBatchProducer, pointerRing);
+	uint64_t pointerBatchErrors = pointerBatchConsumer(pointerRing);
+	pthread_join(producer, NULL);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	printResult("caerRingBuffer (batches)", &start, &end, pointerBatchErrors);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	pthread_create(&producer, NULL, &pointerBatchProducer, smallPointerRing);
+	uint64_t smallBatchErrors = pointerBatchConsumer(smallPointerRing);
+	pthread_join(producer, NULL);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	printResult("caerRingBuffer (batches, 16 places)", &start, &end, smallBatchErrors);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	pthread_create(&producer, NULL, &streamProducer, streamRing);
+	uint64_t streamErrors = streamConsumer(streamRing);
+	pthread_join(producer, NULL);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	printResult("caerStreamRingBuffer", &start, &end, streamErrors);
+
+	caerRingBufferFree(pointerRing);
+	caerRingBufferFree(smallPointerRing);
+	caerStreamRingBufferFree(streamRing);
+
+	return (((pointerErrors == 0) && (pointerBatchErrors == 0) && (smallBatchErrors == 0) && (streamErrors == 0))
+				? (EXIT_SUCCESS)
+				: (EXIT_FAILURE));
+}
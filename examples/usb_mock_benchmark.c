@@ -0,0 +1,98 @@
+#include <libcaer/libcaer.h>
+#include <libcaer/devices/davis.h>
+#include <libcaer/devices/dvs128.h>
+#include <libcaer/devices/dynapse.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Runs the complete USB device path (open, configuration, USB transfers,
+// event translation, data exchange) of a DAVIS, DVS128 or Dynap-se against
+// the in-process mock device, and measures the events per second that
+// arrive at caerDeviceDataGet(). No device needed.
+//
+// Usage: usb_mock_benchmark [davis|dvs128|dynapse] [events per second, 0 = as fast as possible] [seconds]
+static double timespecDiff(const struct timespec *start, const struct timespec *end) {
+	return ((double) (end->tv_sec - start->tv_sec) + ((double) (end->tv_nsec - start->tv_nsec) / 1.0e9));
+}
+
+int main(int argc, char *argv[]) {
+	const char *deviceName = (argc > 1) ? (argv[1]) : ("davis");
+	const char *eventRate = (argc > 2) ? (argv[2]) : ("0");
+	double seconds = (argc > 3) ? (strtod(argv[3], NULL)) : (5.0);
+
+	uint16_t deviceType;
+
+	if (strcmp(deviceName, "davis") == 0) {
+		deviceType = CAER_DEVICE_DAVIS;
+	}
+	else if (strcmp(deviceName, "dvs128") == 0) {
+		deviceType = CAER_DEVICE_DVS128;
+	}
+	else if (strcmp(deviceName, "dynapse") == 0) {
+		deviceType = CAER_DEVICE_DYNAPSE;
+	}
+	else {
+		printf("Unknown device '%s', use davis, dvs128 or dynapse.\n", deviceName);
+		return (EXIT_FAILURE);
+	}
+
+	// Select the mock device, must happen before caerDeviceOpen().
+	setenv("CAER_USB_TRANSPORT", "mock", 1);
+	setenv("CAER_USB_MOCK_RATE", eventRate, 1);
+
+	caerDeviceHandle handle = caerDeviceOpen(1, deviceType, 0, 0, NULL);
+	if (handle == NULL) {
+		return (EXIT_FAILURE);
+	}
+
+	caerDeviceSendDefaultConfig(handle);
+
+	// The mock device starts streaming as soon as the data transfers are up.
+	struct timespec start, now;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	caerDeviceDataStart(handle, NULL, NULL, NULL, NULL, NULL);
+
+	// Let's turn on blocking data-get mode to avoid wasting resources.
+	caerDeviceConfigSet(handle, CAER_HOST_CONFIG_DATAEXCHANGE, CAER_HOST_CONFIG_DATAEXCHANGE_BLOCKING, true);
+
+	uint64_t eventsNumber = 0;
+	uint64_t containersNumber = 0;
+
+	do {
+		caerEventPacketContainer packetContainer = caerDeviceDataGet(handle);
+
+		clock_gettime(CLOCK_MONOTONIC, &now);
+
+		if (packetContainer == NULL) {
+			continue; // Skip if nothing there.
+		}
+
+		containersNumber++;
+
+		for (int32_t i = 0; i < caerEventPacketContainerGetEventPacketsNumber(packetContainer); i++) {
+			caerEventPacketHeader packetHeader = caerEventPacketContainerGetEventPacket(packetContainer, i);
+
+			if ((packetHeader != NULL)
+				&& ((caerEventPacketHeaderGetEventType(packetHeader) == POLARITY_EVENT)
+					|| (caerEventPacketHeaderGetEventType(packetHeader) == SPIKE_EVENT))) {
+				eventsNumber += (uint64_t) caerEventPacketHeaderGetEventValid(packetHeader);
+			}
+		}
+
+		caerEventPacketContainerFree(packetContainer);
+	} while (timespecDiff(&start, &now) < seconds);
+
+	caerDeviceDataStop(handle);
+
+	double duration = timespecDiff(&start, &now);
+
+	printf("%s (mock, %s events/s requested): %llu events in %.2f s, %.0f events/s, %.0f containers/s.\n", deviceName,
+		eventRate, (unsigned long long) eventsNumber, duration, (double) eventsNumber / duration,
+		(double) containersNumber / duration);
+
+	caerDeviceClose(&handle);
+
+	return (EXIT_SUCCESS);
+}
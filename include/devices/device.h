@@ -33,6 +33,13 @@ typedef struct caer_device_handle *caerDeviceHandle;
  * Module address: host-side logging configuration.
  */
 #define CAER_HOST_CONFIG_LOG -4
+/**
+ * Module address: host-side scheduling of the data acquisition
+ * threads (USB, serial or GPIO thread, and decode thread).
+ * On the DAVIS RPi, only the GPIO thread is affected, so it can be
+ * pinned to a CPU of its own, away from the translator thread.
+ */
+#define CAER_HOST_CONFIG_THREAD -5
 
 /**
  * Parameter address for module CAER_HOST_CONFIG_DATAEXCHANGE:
@@ -100,6 +107,67 @@ typedef struct caer_device_handle *caerDeviceHandle;
  */
 #define CAER_HOST_CONFIG_LOG_LEVEL 0
 
+/**
+ * Parameter address for module CAER_HOST_CONFIG_THREAD:
+ * pin the data acquisition threads to a set of CPUs, given as
+ * a bit-mask where bit N stands for CPU N (only CPUs 0 to 31).
+ * Zero means no pinning, which is the default.
+ * Only supported on Linux.
+ * Like all parameters of this module, changes are applied by the
+ * threads themselves within a second, see
+ * CAER_HOST_CONFIG_THREAD_STATUS for the result.
+ */
+#define CAER_HOST_CONFIG_THREAD_CPU_AFFINITY      0
+/**
+ * Parameter address for module CAER_HOST_CONFIG_THREAD:
+ * run the data acquisition threads with the real-time SCHED_FIFO
+ * policy at this priority (1 to 99). Zero means normal scheduling,
+ * which is the default. Usually needs elevated privileges
+ * (CAP_SYS_NICE or an rtprio limit on Linux).
+ */
+#define CAER_HOST_CONFIG_THREAD_REALTIME_PRIORITY 1
+/**
+ * Parameter address for module CAER_HOST_CONFIG_THREAD:
+ * nice value of the data acquisition threads (-20 to 19), as
+ * a signed 32 bit integer cast to uint32_t. Only used with normal
+ * scheduling; zero, the default, keeps the nice value the threads
+ * started with, or restores it if another one was set before.
+ * Values below zero usually need elevated privileges.
+ * Only supported on Linux.
+ */
+#define CAER_HOST_CONFIG_THREAD_NICE              2
+/**
+ * Parameter address for module CAER_HOST_CONFIG_THREAD:
+ * read-only parameter, bit-mask of the settings currently in
+ * effect on any of the data acquisition threads, see the
+ * CAER_HOST_CONFIG_THREAD_STATUS_* flags.
+ */
+#define CAER_HOST_CONFIG_THREAD_STATUS            3
+/**
+ * Parameter address for module CAER_HOST_CONFIG_THREAD:
+ * read-only parameter, bit-mask of the settings that could not be
+ * applied, on any of the data acquisition threads, the last time
+ * they were changed, see the
+ * CAER_HOST_CONFIG_THREAD_STATUS_* flags. Failures are also logged.
+ */
+#define CAER_HOST_CONFIG_THREAD_FAILED            4
+
+/**
+ * Flag for CAER_HOST_CONFIG_THREAD_STATUS and
+ * CAER_HOST_CONFIG_THREAD_FAILED: CPU affinity.
+ */
+#define CAER_HOST_CONFIG_THREAD_STATUS_AFFINITY (1 << 0)
+/**
+ * Flag for CAER_HOST_CONFIG_THREAD_STATUS and
+ * CAER_HOST_CONFIG_THREAD_FAILED: real-time priority.
+ */
+#define CAER_HOST_CONFIG_THREAD_STATUS_REALTIME (1 << 1)
+/**
+ * Flag for CAER_HOST_CONFIG_THREAD_STATUS and
+ * CAER_HOST_CONFIG_THREAD_FAILED: nice value.
+ */
+#define CAER_HOST_CONFIG_THREAD_STATUS_NICE     (1 << 2)
+
 /**
  * Close a previously opened device and invalidate its handle.
  *
@@ -139,6 +207,38 @@ bool caerDeviceSendDefaultConfig(caerDeviceHandle handle);
  */
 bool caerDeviceConfigSet(caerDeviceHandle handle, int8_t modAddr, uint8_t paramAddr, uint32_t param);
 
+/**
+ * One configuration parameter update, for caerDeviceConfigSetBatch().
+ */
+struct caer_device_config {
+	/// Module address, see caerDeviceConfigSet().
+	int8_t modAddr;
+	/// Parameter address, see caerDeviceConfigSet().
+	uint8_t paramAddr;
+	/// Parameter's new value.
+	uint32_t param;
+};
+
+/**
+ * Set several configuration parameters at once, in the given order.
+ * Same as calling caerDeviceConfigSet() for each of them, but on USB
+ * devices with a configuration interface over SPI (DAVIS, Dynap-se) the
+ * device-side parameters are packed into as few USB transfers as possible,
+ * and these are sent without waiting for each one to complete. This is
+ * much faster than single updates, for example when changing many biases.
+ * Processing stops at the first parameter that fails, parameters before
+ * it may already have been applied. Device-side failures are only known
+ * once all transfers completed, so parameters after a failed transfer
+ * may have been applied too.
+ *
+ * @param handle a valid device handle.
+ * @param configs array of parameter updates.
+ * @param configsNumber number of parameter updates in the array.
+ *
+ * @return true if all parameters were set successfully, false on errors.
+ */
+bool caerDeviceConfigSetBatch(caerDeviceHandle handle, const struct caer_device_config *configs, size_t configsNumber);
+
 /**
  * Get the value of a configuration parameter.
  *
@@ -234,6 +334,30 @@ bool caerDeviceDataStop(caerDeviceHandle handle);
  */
 caerEventPacketContainer caerDeviceDataGet(caerDeviceHandle handle);
 
+/**
+ * Get all the event packet containers that are available, up to a maximum,
+ * in one call. This is cheaper than calling caerDeviceDataGet() repeatedly,
+ * especially when catching up after falling behind. The data-not-available
+ * call-back (see caerDeviceDataStart()) is still called once per container.
+ * The returned containers need to be freed, as with caerDeviceDataGet().
+ * The CAER_HOST_CONFIG_DATAEXCHANGE_BLOCKING setting does not apply here,
+ * the timeout is used instead.
+ *
+ * @param handle a valid device handle.
+ * @param containers array to store the event packet containers into,
+ *                   must have space for at least containersMax elements.
+ * @param containersMax maximum number of containers to get. If zero, returns right away.
+ * @param timeout if no container is available right away, wait up to this
+ *                many microseconds for one to arrive. Zero means return
+ *                right away.
+ *
+ * @return the number of containers stored in the array. Zero will be returned
+ *         on errors, such as exceptional device shutdown, or when no container
+ *         became available within the timeout.
+ */
+size_t caerDeviceDataGetBatch(caerDeviceHandle handle, caerEventPacketContainer *containers, size_t containersMax,
+	uint32_t timeout);
+
 #ifdef __cplusplus
 }
 #endif
@@ -895,6 +895,95 @@ bool caerDynapseWriteCam(caerDeviceHandle handle, uint16_t inputNeuronAddr, uint
  */
 bool caerDynapseSendDataToUSB(caerDeviceHandle handle, const uint32_t *data, size_t numConfig);
 
+/**
+ * One CAM entry of a network, see caerDynapseWriteCam() for the meaning
+ * and range of the fields.
+ */
+struct caer_dynapse_cam_entry {
+	/// Neuron address that should be let in as input to this neuron, range [0,1023].
+	uint16_t inputNeuronAddr;
+	/// Neuron address whose CAM should be programmed, range [0,1023].
+	uint16_t neuronAddr;
+	/// CAM address (synapse), each neuron has 64, range [0,63].
+	uint8_t camId;
+	/// One of the DYNAPSE_CONFIG_CAMTYPE_* synaptic weights.
+	uint8_t synapseType;
+};
+
+/**
+ * One SRAM entry of a network, see caerDynapseWriteSramN() for the meaning
+ * and range of the fields.
+ */
+struct caer_dynapse_sram_entry {
+	/// Neuron address whose SRAM should be programmed, range [0,1023].
+	uint16_t neuronAddr;
+	/// SRAM address, each neuron has 4, range [0,3].
+	uint8_t sramId;
+	/// Fake source core ID, set it to this value instead of the actual source core ID, range [0,3].
+	uint8_t virtualCoreId;
+	/// X direction, one of DYNAPSE_CONFIG_SRAM_DIRECTION_X_*.
+	bool sx;
+	/// X delta, number of chips to jumps before reaching destination, range [0,3].
+	uint8_t dx;
+	/// Y direction, one of DYNAPSE_CONFIG_SRAM_DIRECTION_Y_*.
+	bool sy;
+	/// Y delta, number of chips to jumps before reaching destination, range [0,3].
+	uint8_t dy;
+	/// Spike destination cores, one-hot coded, range [0,15].
+	uint8_t destinationCore;
+};
+
+/**
+ * Write a whole network (or a large part of it) to the CAMs and SRAMs of
+ * the currently selected chip. All configuration words are computed on
+ * the host, and sent with several USB transfers in flight at the same
+ * time, verifying that the device accepted them only once at the end.
+ * This is much faster than writing entries one by one with
+ * caerDynapseWriteCam() and caerDynapseWriteSramN().
+ *
+ * Remember to select the chip you want to configure before calling this function!
+ *
+ * @param handle a valid device handle.
+ * @param camEntries array of CAM entries to write, can be NULL if camEntriesNumber is zero.
+ * @param camEntriesNumber number of CAM entries.
+ * @param sramEntries array of SRAM entries to write, can be NULL if sramEntriesNumber is zero.
+ * @param sramEntriesNumber number of SRAM entries.
+ *
+ * @return true on success, false otherwise.
+ */
+bool caerDynapseWriteNetwork(caerDeviceHandle handle, const struct caer_dynapse_cam_entry *camEntries,
+	size_t camEntriesNumber, const struct caer_dynapse_sram_entry *sramEntries, size_t sramEntriesNumber);
+
+/**
+ * Program the CAMs and SRAMs of the currently selected chip so that they
+ * hold exactly the given network: the given entries, with all other CAMs
+ * and SRAMs cleared (like DYNAPSE_CONFIG_CLEAR_CAM and
+ * DYNAPSE_CONFIG_DEFAULT_SRAM_EMPTY do). Only entries that differ from
+ * what was last written to the chip are sent, which makes changing a
+ * few synapses between experiments very fast.
+ * To know what was last written, libcaer keeps a host-side copy of all
+ * CAM and SRAM writes done through this handle, with any function:
+ * caerDynapseWriteCam(), caerDynapseWriteSramN(), caerDynapseSendDataToUSB(),
+ * caerDynapseWriteNetwork() and the DYNAPSE_CONFIG_CHIP_CONTENT,
+ * DYNAPSE_CONFIG_CLEAR_CAM and DYNAPSE_CONFIG_DEFAULT_SRAM* configuration
+ * parameters. Entries never written since the device was opened are
+ * always sent, so the first call programs the whole chip.
+ * If an entry appears more than once in the tables, the last one wins.
+ *
+ * Remember to select the chip you want to configure before calling this function!
+ * The chip must have been selected through this handle (DYNAPSE_CONFIG_CHIP_ID).
+ *
+ * @param handle a valid device handle.
+ * @param camEntries array of CAM entries, can be NULL if camEntriesNumber is zero.
+ * @param camEntriesNumber number of CAM entries.
+ * @param sramEntries array of SRAM entries, can be NULL if sramEntriesNumber is zero.
+ * @param sramEntriesNumber number of SRAM entries.
+ *
+ * @return true on success, false otherwise.
+ */
+bool caerDynapseApplyNetwork(caerDeviceHandle handle, const struct caer_dynapse_cam_entry *camEntries,
+	size_t camEntriesNumber, const struct caer_dynapse_sram_entry *sramEntries, size_t sramEntriesNumber);
+
 /**
  * Generate bits to write a single CAM, to specify which spikes are allowed as input into a neuron.
  *
@@ -929,6 +1018,43 @@ uint32_t caerDynapseGenerateCamBits(uint16_t inputNeuronAddr, uint16_t neuronAdd
 uint32_t caerDynapseGenerateSramBits(uint16_t neuronAddr, uint8_t sramId, uint8_t virtualCoreId, bool sx, uint8_t dx,
 	bool sy, uint8_t dy, uint8_t destinationCore);
 
+/**
+ * Generate bits to write many CAMs at once, the same as calling
+ * caerDynapseGenerateCamBits() for each element, but much faster.
+ * Inputs are separate arrays (structure of arrays), one per parameter.
+ * The output can be sent directly with caerDynapseSendDataToUSB().
+ *
+ * @param inputNeuronAddr array of input neuron addresses, range [0,1023].
+ * @param neuronAddr array of neuron addresses whose CAM should be programmed, range [0,1023].
+ * @param camId array of CAM addresses, range [0,63].
+ * @param synapseType array of synaptic weights, see caerDynapseGenerateCamBits().
+ * @param camBits array receiving the bits to send to device.
+ * @param number number of elements in all the arrays.
+ */
+void caerDynapseGenerateCamBitsArray(const uint16_t *inputNeuronAddr, const uint16_t *neuronAddr, const uint8_t *camId,
+	const uint8_t *synapseType, uint32_t *camBits, size_t number);
+
+/**
+ * Generate bits to write many SRAMs at once, the same as calling
+ * caerDynapseGenerateSramBits() for each element, but much faster.
+ * Inputs are separate arrays (structure of arrays), one per parameter.
+ * The output can be sent directly with caerDynapseSendDataToUSB().
+ *
+ * @param neuronAddr array of neuron addresses to program, range [0,1023].
+ * @param sramId array of SRAM addresses, range [0,3].
+ * @param virtualCoreId array of fake source core IDs, range [0,3].
+ * @param sx array of X directions, see caerDynapseGenerateSramBits().
+ * @param dx array of X deltas, range [0,3].
+ * @param sy array of Y directions, see caerDynapseGenerateSramBits().
+ * @param dy array of Y deltas, range [0,3].
+ * @param destinationCore array of spike destination cores, one-hot coded, range [0,15].
+ * @param sramBits array receiving the bits to send to device.
+ * @param number number of elements in all the arrays.
+ */
+void caerDynapseGenerateSramBitsArray(const uint16_t *neuronAddr, const uint8_t *sramId, const uint8_t *virtualCoreId,
+	const bool *sx, const uint8_t *dx, const bool *sy, const uint8_t *dy, const uint8_t *destinationCore,
+	uint32_t *sramBits, size_t number);
+
 /**
  * Map core ID and column/row address to the correct chip global neuron address.
  *
@@ -984,6 +1110,23 @@ uint16_t caerDynapseSpikeEventGetY(caerSpikeEventConst event);
  */
 struct caer_spike_event caerDynapseSpikeEventFromXY(uint16_t x, uint16_t y);
 
+/**
+ * Convert the valid spike events in a packet to separate arrays of
+ * global neuron IDs and of timestamps (structure of arrays), for fast
+ * processing by simulators and analysis tools.
+ * The global neuron ID is: chipID * DYNAPSE_CONFIG_NUMNEURONS +
+ * coreID * DYNAPSE_CONFIG_NUMNEURONS_CORE + neuronID.
+ *
+ * @param packet a spike event packet, as returned by the Dynap-se.
+ * @param neuronIds array receiving the global neuron IDs.
+ * @param timestamps array receiving the 64bit timestamps, in microseconds.
+ * @param maxSpikes size of the two arrays. Spikes beyond it are ignored.
+ *
+ * @return number of spikes written to the arrays.
+ */
+size_t caerDynapseSpikeEventPacketToArrays(caerSpikeEventPacketConst packet, uint32_t *neuronIds,
+	int64_t *timestamps, size_t maxSpikes);
+
 #ifdef __cplusplus
 }
 #endif
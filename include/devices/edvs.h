@@ -40,6 +40,19 @@ extern "C" {
  * configuration switch and will reset itself right away.
  */
 #define EDVS_CONFIG_DVS_TIMESTAMP_RESET 1
+/**
+ * Parameter address for module EDVS_CONFIG_DVS:
+ * read-only parameter, representing the number of times the
+ * serial data stream was found not aligned to event boundaries,
+ * and had to be re-synchronized (due to lost bytes).
+ */
+#define EDVS_CONFIG_DVS_STATISTICS_RESYNCS       2
+/**
+ * Parameter address for module EDVS_CONFIG_DVS:
+ * read-only parameter, representing the number of bytes skipped
+ * while re-synchronizing the serial data stream.
+ */
+#define EDVS_CONFIG_DVS_STATISTICS_SKIPPED_BYTES 3
 
 /**
  * Parameter address for module EDVS_CONFIG_BIAS:
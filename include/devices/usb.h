@@ -4,6 +4,14 @@
  * Common functions to access, configure and exchange data with
  * supported USB devices. Also contains defines for USB specific
  * configuration options.
+ *
+ * For testing and benchmarking without hardware, set the environment
+ * variable CAER_USB_TRANSPORT to "mock" before opening a DAVIS, DVS128 or
+ * Dynap-se: the device is then simulated inside the library, keeping its
+ * configuration in memory and streaming random events at the rate given
+ * by CAER_USB_MOCK_RATE (events per second, default 1000000, 0 means as
+ * fast as possible). Everything on the host side, from USB transfers to
+ * event packets, runs as it would with a real device.
  */
 
 #ifndef LIBCAER_DEVICES_USB_H_
@@ -34,6 +42,83 @@ extern "C" {
  * them if you're running into I/O limits.
  */
 #define CAER_HOST_CONFIG_USB_BUFFER_SIZE   1
+/**
+ * Parameter address for module CAER_HOST_CONFIG_USB:
+ * enable the host-side copy of the device configuration. Values written
+ * with caerDeviceConfigSet() (or read once from the device) are then
+ * returned by caerDeviceConfigGet() without a USB round-trip. Statistics,
+ * system information and other registers the device changes on its own
+ * are always read from the device. Enabled by default.
+ */
+#define CAER_HOST_CONFIG_USB_CONFIG_CACHE         2
+/**
+ * Parameter address for module CAER_HOST_CONFIG_USB:
+ * drop the host-side copy of the device configuration, so that the next
+ * caerDeviceConfigGet() calls read the current values from the device.
+ * This is an impulse, it always reads back as false.
+ */
+#define CAER_HOST_CONFIG_USB_CONFIG_CACHE_REFRESH 3
+/**
+ * Parameter address for module CAER_HOST_CONFIG_USB:
+ * decode the data in a separate thread. The USB thread then only hands
+ * completed buffers over and resubmits the transfers right away, with a
+ * spare buffer, instead of waiting for the event translation to finish.
+ * This avoids device-side stalls when translation is slow, for example
+ * with many frames, at the cost of one more thread and twice the buffer
+ * memory. Disabled by default. Changing it restarts the data transfers.
+ */
+#define CAER_HOST_CONFIG_USB_DECODE_THREAD        4
+/**
+ * Parameter address for module CAER_HOST_CONFIG_USB:
+ * read-only parameter, representing the number of bytes received
+ * in data transfers since the data acquisition was started.
+ * This is a 64bit value, and should always be read using the
+ * function: caerDeviceConfigGet64().
+ */
+#define CAER_HOST_CONFIG_USB_STATISTICS_BYTES     5
+/**
+ * Parameter address for module CAER_HOST_CONFIG_USB:
+ * read-only parameter, representing the number of times a data
+ * transfer could not be resubmitted right away, because the decode
+ * thread had not yet released any buffer. Only counted while
+ * CAER_HOST_CONFIG_USB_DECODE_THREAD is enabled.
+ * This is a 64bit value, and should always be read using the
+ * function: caerDeviceConfigGet64().
+ */
+#define CAER_HOST_CONFIG_USB_STATISTICS_DECODE_STALLS 7
+/**
+ * Parameter address for module CAER_HOST_CONFIG_USB:
+ * adapt the size and number of data transfers in flight to the observed
+ * data rate. Transfers are sized so that they fill up in about the time
+ * set with CAER_HOST_CONFIG_USB_AUTO_TUNE_LATENCY, and enough of them are
+ * kept in flight to hold 10ms of data. CAER_HOST_CONFIG_USB_BUFFER_NUMBER
+ * and CAER_HOST_CONFIG_USB_BUFFER_SIZE are the upper limits, so raise them
+ * if bursts need more room. Transfers take on the new values one by one
+ * as they complete, without restarting. Disabled by default. Changing it
+ * restarts the data transfers.
+ */
+#define CAER_HOST_CONFIG_USB_AUTO_TUNE 9
+/**
+ * Parameter address for module CAER_HOST_CONFIG_USB:
+ * target time in microseconds to fill up one data transfer, used by
+ * CAER_HOST_CONFIG_USB_AUTO_TUNE. Lower values mean less latency at low
+ * data rates, but more transfers per second. Default is 1000.
+ */
+#define CAER_HOST_CONFIG_USB_AUTO_TUNE_LATENCY 10
+/**
+ * Parameter address for module CAER_HOST_CONFIG_USB:
+ * read-only parameter, the number of data transfers currently kept in
+ * flight. Equal to CAER_HOST_CONFIG_USB_BUFFER_NUMBER if
+ * CAER_HOST_CONFIG_USB_AUTO_TUNE is disabled.
+ */
+#define CAER_HOST_CONFIG_USB_AUTO_TUNE_BUFFER_NUMBER 11
+/**
+ * Parameter address for module CAER_HOST_CONFIG_USB:
+ * read-only parameter, the size in bytes data transfers are currently
+ * submitted with. Equal to CAER_HOST_CONFIG_USB_BUFFER_SIZE if
+ * CAER_HOST_CONFIG_USB_AUTO_TUNE is disabled.
+ */
+#define CAER_HOST_CONFIG_USB_AUTO_TUNE_BUFFER_SIZE 12
 
 /**
  * Open a specified USB device, assign an ID to it and return a handle for further usage.
@@ -54,6 +139,42 @@ extern "C" {
 caerDeviceHandle caerDeviceOpen(uint16_t deviceID, uint16_t deviceType, uint8_t busNumberRestrict,
 	uint8_t devAddressRestrict, const char *serialNumberRestrict);
 
+/**
+ * Maximum number of shared libusb contexts and event-handling threads,
+ * see caerDeviceUSBSharedContextSet().
+ */
+#define CAER_USB_SHARED_CONTEXTS_MAX 99
+
+/**
+ * Share libusb contexts and their event-handling threads among all USB
+ * devices opened from now on, instead of giving each device its own
+ * context and thread. Useful with many devices on one host.
+ * Devices are spread evenly over the shared contexts, each of which has
+ * one thread handling the events of all its devices. Data and shutdown
+ * callbacks work as before, but a slow data callback now also delays the
+ * other devices on the same thread: enable CAER_HOST_CONFIG_USB_DECODE_THREAD
+ * if decoding is expensive. CAER_HOST_CONFIG_THREAD settings only apply
+ * to the decode threads of such devices, not to the shared threads.
+ * This is a process-wide setting, and does not apply to the mock device.
+ *
+ * @param eventThreads number of shared contexts and event-handling threads.
+ *                     Zero, the default, means one context and thread per device.
+ *                     At most CAER_USB_SHARED_CONTEXTS_MAX.
+ *
+ * @return true on success, false if eventThreads is too big or devices
+ *         that use the current shared contexts are still open.
+ */
+bool caerDeviceUSBSharedContextSet(uint32_t eventThreads);
+
+/**
+ * Get the number of shared libusb contexts and event-handling threads
+ * used for newly opened USB devices, see caerDeviceUSBSharedContextSet().
+ *
+ * @return the number of shared event-handling threads, zero if every
+ *         device gets its own.
+ */
+uint32_t caerDeviceUSBSharedContextGet(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,212 @@
+/**
+ * @file dvs_accumulator.h
+ *
+ * Host-side accumulation of DVS polarity events into 2D images, for
+ * display or as input to frame-based algorithms (CNNs for example).
+ * Events are integrated over windows of either a fixed number of events
+ * or a fixed time duration. At the end of each window the image is
+ * published, and then decayed (or cleared) before accumulation continues.
+ * Images can be read back as raw float buffers or as frame event packets.
+ * One thread calls caerFilterDVSAccumulatorApply(), while another thread
+ * (a renderer for example) can concurrently get the last published image,
+ * without ever blocking the first one. Only one reader thread at a time
+ * is supported. All other functions must be called from the thread
+ * calling caerFilterDVSAccumulatorApply().
+ */
+
+#ifndef LIBCAER_FILTERS_DVS_ACCUMULATOR_H_
+#define LIBCAER_FILTERS_DVS_ACCUMULATOR_H_
+
+#include "../events/polarity.h"
+#include "../events/frame.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Pointer to a DVS accumulator instance.
+ */
+typedef struct caer_filter_dvs_accumulator *caerFilterDVSAccumulator;
+
+/**
+ * List of all accumulation window types.
+ * Used with the CAER_FILTER_DVS_ACCUMULATOR_WINDOW_TYPE parameter.
+ */
+enum caer_filter_dvs_accumulator_window {
+	CAER_FILTER_DVS_ACCUMULATOR_WINDOW_EVENTS = 0, //!< Window closes after a fixed number of valid events.
+	CAER_FILTER_DVS_ACCUMULATOR_WINDOW_TIME = 1,   //!< Window closes after a fixed time in microseconds.
+};
+
+/**
+ * List of all ways polarity is integrated into the image.
+ * Used with the CAER_FILTER_DVS_ACCUMULATOR_POLARITY_MODE parameter.
+ */
+enum caer_filter_dvs_accumulator_polarity {
+	CAER_FILTER_DVS_ACCUMULATOR_POLARITY_COUNT = 0,  //!< One channel, every event adds one, polarity is ignored.
+	CAER_FILTER_DVS_ACCUMULATOR_POLARITY_SIGNED = 1, //!< One channel, ON events add one, OFF events subtract one.
+	CAER_FILTER_DVS_ACCUMULATOR_POLARITY_SPLIT = 2,  //!< Two channels, ON events count in the first, OFF in the second.
+};
+
+/**
+ * Parameter address for DVS accumulator:
+ * type of accumulation window, see 'enum caer_filter_dvs_accumulator_window'.
+ */
+#define CAER_FILTER_DVS_ACCUMULATOR_WINDOW_TYPE   0
+/**
+ * Parameter address for DVS accumulator:
+ * size of the accumulation window, either in number of valid events,
+ * or in microseconds, depending on CAER_FILTER_DVS_ACCUMULATOR_WINDOW_TYPE.
+ * Time windows follow each other back to back: windows without any event
+ * are not published, but still decay the image. An event older than the
+ * current window start (after a timestamp reset, for example) ends the
+ * current window, and the next one starts at that event.
+ */
+#define CAER_FILTER_DVS_ACCUMULATOR_WINDOW_SIZE   1
+/**
+ * Parameter address for DVS accumulator:
+ * percentage (0-100) of the accumulated value that is removed from every
+ * pixel at the end of a window. 100 (the default) starts each window from
+ * a clear image, lower values let past activity fade out over time.
+ */
+#define CAER_FILTER_DVS_ACCUMULATOR_DECAY         2
+/**
+ * Parameter address for DVS accumulator:
+ * how event polarity is integrated, see 'enum caer_filter_dvs_accumulator_polarity'.
+ * Changing this clears the current accumulation.
+ */
+#define CAER_FILTER_DVS_ACCUMULATOR_POLARITY_MODE 3
+/**
+ * Parameter address for DVS accumulator:
+ * value, in 16 bit frame pixel units, added for each event when converting
+ * to frame events. For the signed polarity mode, zero maps to the middle
+ * of the pixel range. Values are clamped to the pixel range.
+ */
+#define CAER_FILTER_DVS_ACCUMULATOR_FRAME_SCALE   4
+/**
+ * Parameter address for DVS accumulator:
+ * write-only parameter, clear the current accumulation and restart
+ * the window with the next event.
+ */
+#define CAER_FILTER_DVS_ACCUMULATOR_RESET         5
+/**
+ * Parameter address for DVS accumulator:
+ * read-only parameter, number of windows completed and published
+ * since initialization.
+ */
+#define CAER_FILTER_DVS_ACCUMULATOR_STATISTICS    6
+
+/**
+ * Accumulated image, as published at the end of a window.
+ * Pixels are stored one channel after the other (planar), each channel
+ * laid out row by row (increasing X axis), going from top to bottom
+ * (increasing Y axis). The (0, 0) pixel is in the upper left corner.
+ */
+struct caer_filter_dvs_accumulator_frame {
+	/// Window number, starting at 1, increases by one for each published window.
+	uint64_t sequence;
+	/// Timestamp (64 bit) of the start of the window.
+	int64_t timestampStart;
+	/// Timestamp (64 bit) of the last event in the window.
+	int64_t timestampEnd;
+	/// Source of the polarity events that generated this image.
+	int16_t eventSource;
+	/// X axis resolution.
+	uint16_t sizeX;
+	/// Y axis resolution.
+	uint16_t sizeY;
+	/// Number of channels (1 or 2).
+	uint8_t channels;
+	/// Pixel values, sizeX * sizeY * channels.
+	const float *pixels;
+};
+
+/**
+ * Allocate memory and initialize the DVS accumulator.
+ * The defaults are windows of 10000 events, a full clear
+ * between windows, and the count polarity mode.
+ *
+ * @param sizeX maximum X axis resolution.
+ * @param sizeY maximum Y axis resolution.
+ *
+ * @return DVS accumulator instance, NULL on error.
+ */
+caerFilterDVSAccumulator caerFilterDVSAccumulatorInitialize(uint16_t sizeX, uint16_t sizeY);
+
+/**
+ * Destroy a DVS accumulator instance and free its memory.
+ * No reader may be accessing it anymore.
+ *
+ * @param accumulator a valid DVS accumulator instance.
+ */
+void caerFilterDVSAccumulatorDestroy(caerFilterDVSAccumulator accumulator);
+
+/**
+ * Accumulate the valid events from the given polarity events packet.
+ * Every window that completes while doing so is published.
+ * Events outside of the resolution given at initialization are ignored.
+ *
+ * @param accumulator a valid DVS accumulator instance.
+ * @param polarity a valid polarity event packet. If NULL, no operation
+ *                 is performed.
+ */
+void caerFilterDVSAccumulatorApply(caerFilterDVSAccumulator accumulator, caerPolarityEventPacketConst polarity);
+
+/**
+ * Get the last published image, if it is newer than the one returned by
+ * the previous call. Never blocks. Can be called from a different thread
+ * than caerFilterDVSAccumulatorApply().
+ * The returned pixels stay valid and unchanged until the next call to
+ * caerFilterDVSAccumulatorGetFrame() or caerFilterDVSAccumulatorGetFramePacket().
+ *
+ * @param accumulator a valid DVS accumulator instance.
+ * @param frame pointer to a structure to fill with the image information.
+ *
+ * @return true if a new image is available, false otherwise.
+ */
+bool caerFilterDVSAccumulatorGetFrame(caerFilterDVSAccumulator accumulator,
+	struct caer_filter_dvs_accumulator_frame *frame);
+
+/**
+ * Get the last published image, if it is newer than the one returned by
+ * the previous call, as a new frame event packet with one frame event.
+ * Single channel modes give grayscale frames, the split polarity mode
+ * gives RGB frames, with ON events in red and OFF events in green.
+ * Never blocks. Can be called from a different thread than
+ * caerFilterDVSAccumulatorApply().
+ *
+ * @param accumulator a valid DVS accumulator instance.
+ *
+ * @return a new frame event packet, which the caller must free, or NULL
+ *         if no new image is available or on allocation error.
+ */
+caerFrameEventPacket caerFilterDVSAccumulatorGetFramePacket(caerFilterDVSAccumulator accumulator);
+
+/**
+ * Set DVS accumulator configuration parameters.
+ *
+ * @param accumulator a valid DVS accumulator instance.
+ * @param paramAddr a configuration parameter address, see defines CAER_FILTER_DVS_ACCUMULATOR_*.
+ * @param param a configuration parameter value integer.
+ *
+ * @return true if operation successful, false otherwise.
+ */
+bool caerFilterDVSAccumulatorConfigSet(caerFilterDVSAccumulator accumulator, uint8_t paramAddr, uint64_t param);
+
+/**
+ * Get DVS accumulator configuration parameters.
+ *
+ * @param accumulator a valid DVS accumulator instance.
+ * @param paramAddr a configuration parameter address, see defines CAER_FILTER_DVS_ACCUMULATOR_*.
+ * @param param a pointer to a configuration parameter value integer,
+ *              in which to store the current value.
+ *
+ * @return true if operation successful, false otherwise.
+ */
+bool caerFilterDVSAccumulatorConfigGet(caerFilterDVSAccumulator accumulator, uint8_t paramAddr, uint64_t *param);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBCAER_FILTERS_DVS_ACCUMULATOR_H_ */
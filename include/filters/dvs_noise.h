@@ -0,0 +1,220 @@
+/**
+ * @file dvs_noise.h
+ *
+ * Host-side noise filters for DVS polarity events: hot pixel masking,
+ * background-activity and refractory period filtering. They work like
+ * the equivalent FPGA filters present on newer DAVIS devices, and are
+ * meant for all the sensors that don't have them in hardware (DVS128,
+ * eDVS, older DAVIS logic revisions).
+ * Hot pixels are learned from a calibration window of events, and can
+ * also be programmed into the (up to 8) FPGA pixel filters of a DAVIS.
+ * Events are filtered in place, by invalidating them inside the given
+ * polarity event packet. Invalid events are ignored on input.
+ * A filter instance is not thread-safe, and should only be used by
+ * one thread at a time.
+ */
+
+#ifndef LIBCAER_FILTERS_DVS_NOISE_H_
+#define LIBCAER_FILTERS_DVS_NOISE_H_
+
+#include "../events/polarity.h"
+#include "../devices/device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Pointer to a DVS noise filter instance.
+ */
+typedef struct caer_filter_dvs_noise *caerFilterDVSNoise;
+
+/**
+ * Address of a single DVS pixel, as used to report learned hot pixels.
+ */
+struct caer_filter_dvs_pixel {
+	/// X (column) address.
+	uint16_t x;
+	/// Y (row) address.
+	uint16_t y;
+};
+
+/**
+ * Parameter address for DVS noise filter:
+ * enable the background-activity filter, which tries to remove events
+ * caused by transistor leakage, by rejecting uncorrelated events.
+ * An event is uncorrelated if none of its eight direct neighbor pixels
+ * had an event in the last CAER_FILTER_DVS_BACKGROUND_ACTIVITY_TIME
+ * microseconds.
+ */
+#define CAER_FILTER_DVS_BACKGROUND_ACTIVITY_ENABLE     0
+/**
+ * Parameter address for DVS noise filter:
+ * specify the time difference constant for the background-activity
+ * filter in microseconds. Events that do correlated within this
+ * time-frame are let through, while others are filtered out.
+ */
+#define CAER_FILTER_DVS_BACKGROUND_ACTIVITY_TIME       1
+/**
+ * Parameter address for DVS noise filter:
+ * read-only parameter, representing the number of events filtered
+ * out by the background-activity filter since the last reset.
+ */
+#define CAER_FILTER_DVS_BACKGROUND_ACTIVITY_STATISTICS 2
+/**
+ * Parameter address for DVS noise filter:
+ * enable the refractory period filter, which limits the firing rate
+ * of pixels by rejecting events that follow too closely on an event
+ * from the same pixel.
+ */
+#define CAER_FILTER_DVS_REFRACTORY_PERIOD_ENABLE       3
+/**
+ * Parameter address for DVS noise filter:
+ * specify the time constant for the refractory period filter.
+ * Pixels will be inhibited from generating new events during this
+ * time after the last event has fired.
+ */
+#define CAER_FILTER_DVS_REFRACTORY_PERIOD_TIME         4
+/**
+ * Parameter address for DVS noise filter:
+ * read-only parameter, representing the number of events filtered
+ * out by the refractory period filter since the last reset.
+ */
+#define CAER_FILTER_DVS_REFRACTORY_PERIOD_STATISTICS   5
+/**
+ * Parameter address for DVS noise filter:
+ * write-only parameter, clear the internal per-pixel timestamp map
+ * and all statistics. Use this after a TIMESTAMP_RESET special event,
+ * or when switching to a different input source.
+ * The learned hot pixels are kept.
+ */
+#define CAER_FILTER_DVS_RESET                          6
+/**
+ * Parameter address for DVS noise filter:
+ * enable the hot pixel filter, which removes all events coming
+ * from the pixels found to be hot during the last learning run.
+ */
+#define CAER_FILTER_DVS_HOTPIXEL_ENABLE                7
+/**
+ * Parameter address for DVS noise filter:
+ * start learning which pixels are hot, by counting events per pixel
+ * for CAER_FILTER_DVS_HOTPIXEL_TIME microseconds, starting with the
+ * next event. Read back to see if learning is still in progress.
+ * A new learning run replaces the previous results.
+ */
+#define CAER_FILTER_DVS_HOTPIXEL_LEARN                 8
+/**
+ * Parameter address for DVS noise filter:
+ * duration in microseconds of the hot pixel learning window.
+ */
+#define CAER_FILTER_DVS_HOTPIXEL_TIME                  9
+/**
+ * Parameter address for DVS noise filter:
+ * minimum number of events a pixel must generate during the
+ * learning window to be considered hot.
+ */
+#define CAER_FILTER_DVS_HOTPIXEL_COUNT                 10
+/**
+ * Parameter address for DVS noise filter:
+ * read-only parameter, representing the number of events filtered
+ * out by the hot pixel filter since the last reset.
+ */
+#define CAER_FILTER_DVS_HOTPIXEL_STATISTICS            11
+
+/**
+ * Allocate memory and initialize the DVS noise filter.
+ * All filters start out disabled.
+ *
+ * @param sizeX maximum X axis resolution.
+ * @param sizeY maximum Y axis resolution.
+ *
+ * @return DVS noise filter instance, NULL on error.
+ */
+caerFilterDVSNoise caerFilterDVSNoiseInitialize(uint16_t sizeX, uint16_t sizeY);
+
+/**
+ * Destroy a DVS noise filter instance and free its memory.
+ *
+ * @param noiseFilter a valid DVS noise filter instance.
+ */
+void caerFilterDVSNoiseDestroy(caerFilterDVSNoise noiseFilter);
+
+/**
+ * Apply the DVS noise filter to the given polarity events packet.
+ * This will filter out events by marking them as invalid.
+ * Events outside of the resolution given at initialization are
+ * left untouched.
+ *
+ * @param noiseFilter a valid DVS noise filter instance.
+ * @param polarity a valid polarity event packet. If NULL, no operation
+ *                 is performed.
+ */
+void caerFilterDVSNoiseApply(caerFilterDVSNoise noiseFilter, caerPolarityEventPacket polarity);
+
+/**
+ * Get the hot pixels found during the last learning run, ordered from
+ * the most to the least active one.
+ *
+ * @param noiseFilter a valid DVS noise filter instance.
+ * @param hotPixels pointer in which to store the address of the hot pixels
+ *                  array. The memory belongs to the filter and stays valid
+ *                  until the next learning run completes, or the filter is
+ *                  destroyed. Set to NULL if there are no hot pixels.
+ *
+ * @return number of hot pixels.
+ */
+size_t caerFilterDVSNoiseGetHotPixels(caerFilterDVSNoise noiseFilter, const struct caer_filter_dvs_pixel **hotPixels);
+
+/**
+ * Program the most active hot pixels found during the last learning run
+ * into the FPGA pixel filters of a DAVIS device (up to 8, see the
+ * DAVIS_CONFIG_DVS_FILTER_PIXEL_* parameters). Unused pixel filters
+ * are disabled.
+ *
+ * @param noiseFilter a valid DVS noise filter instance.
+ * @param davisHandle a valid DAVIS device handle, whose DVS resolution
+ *                    should match the one of the filter.
+ *
+ * @return true if operation successful, false otherwise, such as when
+ *         the device does not have any FPGA pixel filters.
+ */
+bool caerFilterDVSNoiseHotPixelsProgramDevice(caerFilterDVSNoise noiseFilter, caerDeviceHandle davisHandle);
+
+/**
+ * Attach a DAVIS device to the DVS noise filter, so that the most active
+ * hot pixels are programmed into its FPGA pixel filters automatically at
+ * the end of every learning run, see caerFilterDVSNoiseHotPixelsProgramDevice().
+ *
+ * @param noiseFilter a valid DVS noise filter instance.
+ * @param davisHandle a valid DAVIS device handle, or NULL to detach.
+ */
+void caerFilterDVSNoiseHotPixelsAttachDevice(caerFilterDVSNoise noiseFilter, caerDeviceHandle davisHandle);
+
+/**
+ * Set DVS noise filter configuration parameters.
+ *
+ * @param noiseFilter a valid DVS noise filter instance.
+ * @param paramAddr a configuration parameter address, see defines CAER_FILTER_DVS_*.
+ * @param param a configuration parameter value integer.
+ *
+ * @return true if operation successful, false otherwise.
+ */
+bool caerFilterDVSNoiseConfigSet(caerFilterDVSNoise noiseFilter, uint8_t paramAddr, uint64_t param);
+
+/**
+ * Get DVS noise filter configuration parameters.
+ *
+ * @param noiseFilter a valid DVS noise filter instance.
+ * @param paramAddr a configuration parameter address, see defines CAER_FILTER_DVS_*.
+ * @param param a pointer to a configuration parameter value integer,
+ *              in which to store the current value.
+ *
+ * @return true if operation successful, false otherwise.
+ */
+bool caerFilterDVSNoiseConfigGet(caerFilterDVSNoise noiseFilter, uint8_t paramAddr, uint64_t *param);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBCAER_FILTERS_DVS_NOISE_H_ */
@@ -0,0 +1,149 @@
+/**
+ * @file dvs_time_surface.h
+ *
+ * Surface of Active Events (SAE): keeps the 64 bit timestamp of the last
+ * event of each polarity for every DVS pixel, updated from polarity event
+ * packets. Timestamps are stored in small square tiles, so that reading
+ * the neighborhood of a pixel touches as few cache lines as possible.
+ * An exponentially decaying time surface can be exported as a float image.
+ * A time surface instance is not thread-safe, and should only be used by
+ * one thread at a time.
+ */
+
+#ifndef LIBCAER_FILTERS_DVS_TIME_SURFACE_H_
+#define LIBCAER_FILTERS_DVS_TIME_SURFACE_H_
+
+#include "../events/polarity.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Pointer to a DVS time surface instance.
+ */
+typedef struct caer_filter_dvs_time_surface *caerFilterDVSTimeSurface;
+
+/**
+ * Timestamp of pixels that never had an event (of a certain polarity).
+ * Far enough in the past that subtracting it from any valid 64 bit
+ * timestamp gives a very large, but still positive, time difference.
+ */
+#define CAER_FILTER_DVS_TIME_SURFACE_EMPTY (INT64_MIN / 2)
+
+/**
+ * List of all polarity selections for reading and exporting the surface.
+ */
+enum caer_filter_dvs_time_surface_polarity {
+	CAER_FILTER_DVS_TIME_SURFACE_OFF = 0,  //!< Only OFF events.
+	CAER_FILTER_DVS_TIME_SURFACE_ON = 1,   //!< Only ON events.
+	CAER_FILTER_DVS_TIME_SURFACE_BOTH = 2, //!< Latest event, regardless of polarity.
+};
+
+/**
+ * Allocate memory and initialize the DVS time surface.
+ * All pixels start out empty, see CAER_FILTER_DVS_TIME_SURFACE_EMPTY.
+ *
+ * @param sizeX maximum X axis resolution.
+ * @param sizeY maximum Y axis resolution.
+ *
+ * @return DVS time surface instance, NULL on error.
+ */
+caerFilterDVSTimeSurface caerFilterDVSTimeSurfaceInitialize(uint16_t sizeX, uint16_t sizeY);
+
+/**
+ * Destroy a DVS time surface instance and free its memory.
+ *
+ * @param surface a valid DVS time surface instance.
+ */
+void caerFilterDVSTimeSurfaceDestroy(caerFilterDVSTimeSurface surface);
+
+/**
+ * Reset all pixels to empty, for example after a TIMESTAMP_RESET
+ * special event, or when switching to a different input source.
+ *
+ * @param surface a valid DVS time surface instance.
+ */
+void caerFilterDVSTimeSurfaceReset(caerFilterDVSTimeSurface surface);
+
+/**
+ * Update the time surface with all valid events from the given polarity
+ * events packet. Events outside of the resolution given at initialization
+ * are ignored.
+ *
+ * @param surface a valid DVS time surface instance.
+ * @param polarity a valid polarity event packet. If NULL, no operation
+ *                 is performed.
+ */
+void caerFilterDVSTimeSurfaceUpdate(caerFilterDVSTimeSurface surface, caerPolarityEventPacketConst polarity);
+
+/**
+ * Get the timestamp of the most recent event seen by caerFilterDVSTimeSurfaceUpdate().
+ *
+ * @param surface a valid DVS time surface instance.
+ *
+ * @return 64 bit timestamp, or CAER_FILTER_DVS_TIME_SURFACE_EMPTY if no event was seen yet.
+ */
+int64_t caerFilterDVSTimeSurfaceGetLastTimestamp(caerFilterDVSTimeSurface surface);
+
+/**
+ * Get the timestamp of the last event at a pixel.
+ *
+ * @param surface a valid DVS time surface instance.
+ * @param x X address of the pixel.
+ * @param y Y address of the pixel.
+ * @param polarity which polarity to consider.
+ *
+ * @return 64 bit timestamp, or CAER_FILTER_DVS_TIME_SURFACE_EMPTY if there
+ *         was no event or the address is out of range.
+ */
+int64_t caerFilterDVSTimeSurfaceGetTimestamp(caerFilterDVSTimeSurface surface, uint16_t x, uint16_t y,
+	enum caer_filter_dvs_time_surface_polarity polarity);
+
+/**
+ * Get the timestamps of the last events in the square neighborhood of
+ * a pixel, of size (2 * radius + 1) x (2 * radius + 1), centered on it.
+ * The neighborhood is written row by row (increasing X axis), from top
+ * to bottom (increasing Y axis). Positions outside of the surface are
+ * set to CAER_FILTER_DVS_TIME_SURFACE_EMPTY.
+ *
+ * @param surface a valid DVS time surface instance.
+ * @param x X address of the center pixel.
+ * @param y Y address of the center pixel.
+ * @param radius neighborhood radius, 0 means only the center pixel.
+ * @param polarity which polarity to consider.
+ * @param timestamps array of at least (2 * radius + 1)^2 elements,
+ *                   in which to store the timestamps.
+ */
+void caerFilterDVSTimeSurfaceGetNeighborhood(caerFilterDVSTimeSurface surface, uint16_t x, uint16_t y, uint8_t radius,
+	enum caer_filter_dvs_time_surface_polarity polarity, int64_t *timestamps);
+
+/**
+ * Export an exponentially decaying time surface: each pixel is set to
+ * exp(-(timestamp - lastTimestamp) / decayTime), so 1 for an event right
+ * at 'timestamp', going towards 0 for older events. Pixels without events,
+ * or whose last event is later than 'timestamp', are set to 0. So are pixels
+ * whose last event is more than about 86 * decayTime older than 'timestamp'
+ * (where the value would drop below the smallest normal float, ~1.2e-38),
+ * or more than INT32_MAX microseconds older, whichever limit is lower.
+ * The output is laid out row by row (increasing X axis), going from top
+ * to bottom (increasing Y axis).
+ *
+ * @param surface a valid DVS time surface instance.
+ * @param timestamp reference 64 bit timestamp, usually the one returned by
+ *                  caerFilterDVSTimeSurfaceGetLastTimestamp().
+ * @param decayTime decay time constant in microseconds, must be positive.
+ * @param polarity which polarity to export.
+ * @param surfaceOut array of at least sizeX * sizeY elements, in which
+ *                   to store the time surface.
+ *
+ * @return true if operation successful, false otherwise.
+ */
+bool caerFilterDVSTimeSurfaceExport(caerFilterDVSTimeSurface surface, int64_t timestamp, float decayTime,
+	enum caer_filter_dvs_time_surface_polarity polarity, float *surfaceOut);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBCAER_FILTERS_DVS_TIME_SURFACE_H_ */
@@ -26,6 +26,30 @@ bool caerRingBufferPut(caerRingBuffer rBuf, void *elem);
 bool caerRingBufferFull(caerRingBuffer rBuf);
 void *caerRingBufferGet(caerRingBuffer rBuf);
 void *caerRingBufferLook(caerRingBuffer rBuf);
+// Batched versions of Put/Get, with one memory fence per call instead of one
+// per element. PutBatch() puts as many of the 'elemsNumber' elements as fit,
+// in order, GetBatch() gets up to 'elemsMax' elements; both return how many
+// elements were moved.
+size_t caerRingBufferPutBatch(caerRingBuffer rBuf, void *const *elems, size_t elemsNumber);
+size_t caerRingBufferGetBatch(caerRingBuffer rBuf, void **elems, size_t elemsMax);
+
+// Single-producer/single-consumer ring for streaming raw data (bytes, words,
+// events), moved in contiguous spans instead of one pointer at a time.
+// 'size' is in elements of 'elementSize' bytes and must be a power of two.
+// The producer asks for free space with Reserve(), fills up to 'length'
+// elements and makes them visible with Commit(); the consumer gets them with
+// Peek() and gives the space back with Release(). Spans end at the end of the
+// underlying array, so a call may return less than what is free/available:
+// just call again after committing/releasing. 'length' is zero if the ring is
+// full/empty. Each side only touches the other side's position once per span.
+typedef struct caer_stream_ring_buffer *caerStreamRingBuffer;
+
+caerStreamRingBuffer caerStreamRingBufferInit(size_t size, size_t elementSize);
+void caerStreamRingBufferFree(caerStreamRingBuffer rBuf);
+void *caerStreamRingBufferReserve(caerStreamRingBuffer rBuf, size_t *length);
+void caerStreamRingBufferCommit(caerStreamRingBuffer rBuf, size_t length);
+const void *caerStreamRingBufferPeek(caerStreamRingBuffer rBuf, size_t *length);
+void caerStreamRingBufferRelease(caerStreamRingBuffer rBuf, size_t length);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,133 @@
+/**
+ * @file stream_merger.h
+ *
+ * Merge the event packet container streams of multiple devices (or other
+ * sources) with synchronized timestamps, like a stereo or multi-camera
+ * setup with one timestamp master and several slaves, into one stream of
+ * packet containers ordered by timestamp.
+ * Every container returned by the merger holds the events of only one
+ * input, and all its events are at or after the events of the container
+ * returned before it. Containers that already fit in that order are passed
+ * through unchanged, the others are split at the timestamp where events
+ * from another input need to go in between. Packets that fall entirely on
+ * one side of the split are moved, not copied.
+ * To know that no older events can still arrive, the merger waits until
+ * every input has delivered events up to a certain time. Inputs that fall
+ * behind the most recent one by more than the reorder window are not
+ * waited upon anymore, so that a silent or disconnected input cannot stall
+ * the others. Events arriving later than that cannot be put in order, and
+ * are passed through as soon as possible instead, see
+ * caerStreamMergerGetLateContainers().
+ * A merger instance is not thread-safe, and should only be used by one
+ * thread at a time.
+ */
+
+#ifndef LIBCAER_STREAM_MERGER_H_
+#define LIBCAER_STREAM_MERGER_H_
+
+#include "events/packetContainer.h"
+#include "devices/device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Pointer to a stream merger instance.
+ */
+typedef struct caer_stream_merger *caerStreamMerger;
+
+/**
+ * Allocate memory and initialize a stream merger.
+ *
+ * @param inputsNumber number of input streams to merge, at least 1.
+ * @param reorderWindow maximum time in microseconds by which an input
+ *                      may lag behind the most recent one, before the
+ *                      merger stops waiting for it. Must be positive.
+ *
+ * @return stream merger instance, NULL on error.
+ */
+caerStreamMerger caerStreamMergerInitialize(size_t inputsNumber, int64_t reorderWindow);
+
+/**
+ * Destroy a stream merger instance, freeing all the containers still
+ * queued inside it. Attached devices are not touched.
+ *
+ * @param merger a valid stream merger instance.
+ */
+void caerStreamMergerDestroy(caerStreamMerger merger);
+
+/**
+ * Add a packet container to an input stream. Containers of the same
+ * input must be pushed in timestamp order, as devices return them.
+ *
+ * @param merger a valid stream merger instance.
+ * @param input index of the input stream, from 0 to inputsNumber - 1.
+ * @param container a packet container. The merger takes ownership of it,
+ *                  also on failure. Empty containers are freed right away.
+ *
+ * @return true if operation successful, false otherwise.
+ */
+bool caerStreamMergerPush(caerStreamMerger merger, size_t input, caerEventPacketContainer container);
+
+/**
+ * Signal that an input stream has ended (device shut down, end of file),
+ * so that the merger stops waiting for it. Once all inputs have ended,
+ * all remaining queued events can be retrieved.
+ *
+ * @param merger a valid stream merger instance.
+ * @param input index of the input stream, from 0 to inputsNumber - 1.
+ */
+void caerStreamMergerInputEnd(caerStreamMerger merger, size_t input);
+
+/**
+ * Get the next packet container in timestamp order, if it is ready.
+ *
+ * @param merger a valid stream merger instance.
+ *
+ * @return a packet container, which the caller must free, or NULL if
+ *         no container is ready yet.
+ */
+caerEventPacketContainer caerStreamMergerPop(caerStreamMerger merger);
+
+/**
+ * Attach a device to an input stream, so that caerStreamMergerDataGet()
+ * gets data from it directly. The device should be in non-blocking mode
+ * (CAER_HOST_CONFIG_DATAEXCHANGE_BLOCKING set to false), and have its
+ * data acquisition already started.
+ *
+ * @param merger a valid stream merger instance.
+ * @param input index of the input stream, from 0 to inputsNumber - 1.
+ * @param handle a valid device handle, or NULL to detach.
+ *
+ * @return true if operation successful, false otherwise.
+ */
+bool caerStreamMergerAttachDevice(caerStreamMerger merger, size_t input, caerDeviceHandle handle);
+
+/**
+ * Get the next packet container in timestamp order from the attached
+ * devices. If none is ready, get at most one container from each attached
+ * device with caerDeviceDataGet(), and try again.
+ *
+ * @param merger a valid stream merger instance.
+ *
+ * @return a packet container, which the caller must free, or NULL if
+ *         no container is ready yet.
+ */
+caerEventPacketContainer caerStreamMergerDataGet(caerStreamMerger merger);
+
+/**
+ * Get the number of containers that arrived too late to be put in
+ * order, because their input was behind by more than the reorder window.
+ *
+ * @param merger a valid stream merger instance.
+ *
+ * @return number of late containers since initialization.
+ */
+uint64_t caerStreamMergerGetLateContainers(caerStreamMerger merger);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBCAER_STREAM_MERGER_H_ */
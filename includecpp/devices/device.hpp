@@ -3,6 +3,7 @@
 
 #include <libcaer/devices/device.h>
 #include <string>
+#include <vector>
 #include "../libcaer.hpp"
 #include "../events/packetContainer.hpp"
 #include "../events/utils.hpp"
@@ -21,6 +22,10 @@ public:
 
 	virtual std::string toString() const noexcept = 0;
 
+	caerDeviceHandle getHandle() const noexcept {
+		return (handle.get());
+	}
+
 	void sendDefaultConfig() const {
 		bool success = caerDeviceSendDefaultConfig(handle.get());
 		if (!success) {
@@ -38,6 +43,15 @@ public:
 		}
 	}
 
+	void configSetBatch(const std::vector<struct caer_device_config> &configs) const {
+		bool success = caerDeviceConfigSetBatch(handle.get(), configs.data(), configs.size());
+		if (!success) {
+			std::string exc = toString() + ": failed to set batch of " + std::to_string(configs.size())
+				+ " configuration parameters.";
+			throw std::runtime_error(exc);
+		}
+	}
+
 	void configGet(int8_t modAddr, uint8_t paramAddr, uint32_t *param) const {
 		bool success = caerDeviceConfigGet(handle.get(), modAddr, paramAddr, param);
 		if (!success) {
@@ -78,6 +92,28 @@ public:
 			return (nullptr);
 		}
 
+		return (containerFromC(cContainer));
+	}
+
+	std::vector<std::unique_ptr<libcaer::events::EventPacketContainer>> dataGetBatch(size_t containersMax,
+		uint32_t timeout) const {
+		std::vector<caerEventPacketContainer> cContainers(containersMax);
+
+		size_t containersNumber = caerDeviceDataGetBatch(handle.get(), cContainers.data(), containersMax, timeout);
+
+		// Empty vector means no data, forward that.
+		std::vector<std::unique_ptr<libcaer::events::EventPacketContainer>> cppContainers;
+		cppContainers.reserve(containersNumber);
+
+		for (size_t i = 0; i < containersNumber; i++) {
+			cppContainers.push_back(containerFromC(cContainers[i]));
+		}
+
+		return (cppContainers);
+	}
+
+private:
+	static std::unique_ptr<libcaer::events::EventPacketContainer> containerFromC(caerEventPacketContainer cContainer) {
 		std::unique_ptr<libcaer::events::EventPacketContainer> cppContainer = std::unique_ptr<
 			libcaer::events::EventPacketContainer>(new libcaer::events::EventPacketContainer());
 
@@ -5,6 +5,7 @@
 #include "usb.hpp"
 #include "../events/spike.hpp"
 #include "../events/special.hpp"
+#include <vector>
 
 namespace libcaer {
 namespace devices {
@@ -37,6 +38,28 @@ public:
 		}
 	}
 
+	void writeNetwork(const struct caer_dynapse_cam_entry *camEntries, size_t camEntriesNumber,
+		const struct caer_dynapse_sram_entry *sramEntries, size_t sramEntriesNumber) const {
+		bool success = caerDynapseWriteNetwork(handle.get(), camEntries, camEntriesNumber, sramEntries,
+			sramEntriesNumber);
+		if (!success) {
+			std::string exc = toString() + ": failed to write network to device, camEntriesNumber="
+				+ std::to_string(camEntriesNumber) + ", sramEntriesNumber=" + std::to_string(sramEntriesNumber) + ".";
+			throw std::runtime_error(exc);
+		}
+	}
+
+	void applyNetwork(const struct caer_dynapse_cam_entry *camEntries, size_t camEntriesNumber,
+		const struct caer_dynapse_sram_entry *sramEntries, size_t sramEntriesNumber) const {
+		bool success = caerDynapseApplyNetwork(handle.get(), camEntries, camEntriesNumber, sramEntries,
+			sramEntriesNumber);
+		if (!success) {
+			std::string exc = toString() + ": failed to apply network to device, camEntriesNumber="
+				+ std::to_string(camEntriesNumber) + ", sramEntriesNumber=" + std::to_string(sramEntriesNumber) + ".";
+			throw std::runtime_error(exc);
+		}
+	}
+
 	void writeSramWords(const uint16_t *data, uint32_t baseAddr, size_t numWords) const {
 		bool success = caerDynapseWriteSramWords(handle.get(), data, baseAddr, numWords);
 		if (!success) {
@@ -110,6 +133,18 @@ public:
 		return (caerDynapseGenerateSramBits(neuronAddr, sramId, virtualCoreId, sx, dx, sy, dy, destinationCore));
 	}
 
+	static void generateCamBitsArray(const uint16_t *inputNeuronAddr, const uint16_t *neuronAddr, const uint8_t *camId,
+		const uint8_t *synapseType, uint32_t *camBits, size_t number) noexcept {
+		caerDynapseGenerateCamBitsArray(inputNeuronAddr, neuronAddr, camId, synapseType, camBits, number);
+	}
+
+	static void generateSramBitsArray(const uint16_t *neuronAddr, const uint8_t *sramId, const uint8_t *virtualCoreId,
+		const bool *sx, const uint8_t *dx, const bool *sy, const uint8_t *dy, const uint8_t *destinationCore,
+		uint32_t *sramBits, size_t number) noexcept {
+		caerDynapseGenerateSramBitsArray(neuronAddr, sramId, virtualCoreId, sx, dx, sy, dy, destinationCore, sramBits,
+			number);
+	}
+
 	static uint16_t coreXYToNeuronId(uint8_t coreId, uint8_t columnX, uint8_t rowY) noexcept {
 		return (caerDynapseCoreXYToNeuronId(coreId, columnX, rowY));
 	}
@@ -140,6 +175,22 @@ public:
 		libcaer::events::SpikeEvent *spCpp = reinterpret_cast<libcaer::events::SpikeEvent *>(&sp);
 		return (*spCpp);
 	}
+
+	// Replaces the content of both vectors with the valid spikes in the packet.
+	static void spikeEventPacketToArrays(const libcaer::events::SpikeEventPacket &packet,
+		std::vector<uint32_t> &neuronIds, std::vector<int64_t> &timestamps) {
+		size_t maxSpikes = static_cast<size_t>(packet.getEventValid());
+
+		neuronIds.resize(maxSpikes);
+		timestamps.resize(maxSpikes);
+
+		size_t spikes = caerDynapseSpikeEventPacketToArrays(
+			reinterpret_cast<caerSpikeEventPacketConst>(packet.getHeaderPointer()), neuronIds.data(),
+			timestamps.data(), maxSpikes);
+
+		neuronIds.resize(spikes);
+		timestamps.resize(spikes);
+	}
 };
 
 }
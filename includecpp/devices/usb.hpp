@@ -35,6 +35,18 @@ protected:
 
 		handle = std::shared_ptr<struct caer_device_handle>(h, deleteDeviceHandle);
 	}
+
+public:
+	static void setSharedContext(uint32_t eventThreads) {
+		bool success = caerDeviceUSBSharedContextSet(eventThreads);
+		if (!success) {
+			throw std::runtime_error("Failed to change USB shared context, too many event threads or devices still open.");
+		}
+	}
+
+	static uint32_t getSharedContext() noexcept {
+		return (caerDeviceUSBSharedContextGet());
+	}
 };
 
 }
@@ -0,0 +1,83 @@
+#ifndef LIBCAER_FILTERS_DVS_ACCUMULATOR_HPP_
+#define LIBCAER_FILTERS_DVS_ACCUMULATOR_HPP_
+
+#include <libcaer/filters/dvs_accumulator.h>
+#include "../events/polarity.hpp"
+#include "../events/frame.hpp"
+#include <memory>
+#include <string>
+
+namespace libcaer {
+namespace filters {
+
+class DVSAccumulator {
+private:
+	std::shared_ptr<struct caer_filter_dvs_accumulator> handle;
+
+public:
+	DVSAccumulator(uint16_t sizeX, uint16_t sizeY) {
+		caerFilterDVSAccumulator accumulator = caerFilterDVSAccumulatorInitialize(sizeX, sizeY);
+
+		// Handle constructor failure.
+		if (accumulator == nullptr) {
+			throw std::runtime_error("Failed to initialize DVS accumulator.");
+		}
+
+		// Use stateless lambda for shared_ptr custom deleter.
+		auto deleteAccumulator = [](caerFilterDVSAccumulator acc) {
+			// Run destructor, free all memory.
+			// Never fails in current implementation.
+			caerFilterDVSAccumulatorDestroy(acc);
+		};
+
+		handle = std::shared_ptr<struct caer_filter_dvs_accumulator>(accumulator, deleteAccumulator);
+	}
+
+	void apply(const libcaer::events::PolarityEventPacket &polarity) {
+		caerFilterDVSAccumulatorApply(handle.get(),
+			reinterpret_cast<caerPolarityEventPacketConst>(polarity.getHeaderPointer()));
+	}
+
+	bool getFrame(struct caer_filter_dvs_accumulator_frame &frame) {
+		return (caerFilterDVSAccumulatorGetFrame(handle.get(), &frame));
+	}
+
+	std::unique_ptr<libcaer::events::FrameEventPacket> getFramePacket() {
+		caerFrameEventPacket framePacket = caerFilterDVSAccumulatorGetFramePacket(handle.get());
+		if (framePacket == nullptr) {
+			// NULL return means no new image, forward that.
+			return (nullptr);
+		}
+
+		return (std::unique_ptr<libcaer::events::FrameEventPacket>(new libcaer::events::FrameEventPacket(framePacket)));
+	}
+
+	void configSet(uint8_t paramAddr, uint64_t param) {
+		bool success = caerFilterDVSAccumulatorConfigSet(handle.get(), paramAddr, param);
+		if (!success) {
+			std::string exc = "DVS accumulator: failed to set configuration parameter, paramAddr="
+				+ std::to_string(paramAddr) + ", param=" + std::to_string(param) + ".";
+			throw std::runtime_error(exc);
+		}
+	}
+
+	void configGet(uint8_t paramAddr, uint64_t *param) const {
+		bool success = caerFilterDVSAccumulatorConfigGet(handle.get(), paramAddr, param);
+		if (!success) {
+			std::string exc = "DVS accumulator: failed to get configuration parameter, paramAddr="
+				+ std::to_string(paramAddr) + ".";
+			throw std::runtime_error(exc);
+		}
+	}
+
+	uint64_t configGet(uint8_t paramAddr) const {
+		uint64_t param = 0;
+		configGet(paramAddr, &param);
+		return (param);
+	}
+};
+
+}
+}
+
+#endif /* LIBCAER_FILTERS_DVS_ACCUMULATOR_HPP_ */
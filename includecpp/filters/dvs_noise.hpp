@@ -0,0 +1,93 @@
+#ifndef LIBCAER_FILTERS_DVS_NOISE_HPP_
+#define LIBCAER_FILTERS_DVS_NOISE_HPP_
+
+#include <libcaer/filters/dvs_noise.h>
+#include "../events/polarity.hpp"
+#include "../devices/device.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace libcaer {
+namespace filters {
+
+class DVSNoise {
+private:
+	std::shared_ptr<struct caer_filter_dvs_noise> handle;
+
+public:
+	DVSNoise(uint16_t sizeX, uint16_t sizeY) {
+		caerFilterDVSNoise noiseFilter = caerFilterDVSNoiseInitialize(sizeX, sizeY);
+
+		// Handle constructor failure.
+		if (noiseFilter == nullptr) {
+			throw std::runtime_error("Failed to initialize DVS noise filter.");
+		}
+
+		// Use stateless lambda for shared_ptr custom deleter.
+		auto deleteNoiseFilter = [](caerFilterDVSNoise nf) {
+			// Run destructor, free all memory.
+			// Never fails in current implementation.
+			caerFilterDVSNoiseDestroy(nf);
+		};
+
+		handle = std::shared_ptr<struct caer_filter_dvs_noise>(noiseFilter, deleteNoiseFilter);
+	}
+
+	void apply(libcaer::events::PolarityEventPacket &polarity) {
+		caerFilterDVSNoiseApply(handle.get(),
+			reinterpret_cast<caerPolarityEventPacket>(polarity.getHeaderPointer()));
+	}
+
+	std::vector<struct caer_filter_dvs_pixel> getHotPixels() const {
+		const struct caer_filter_dvs_pixel *hotPixels = nullptr;
+		size_t hotPixelsNumber = caerFilterDVSNoiseGetHotPixels(handle.get(), &hotPixels);
+
+		return (std::vector<struct caer_filter_dvs_pixel>(hotPixels, hotPixels + hotPixelsNumber));
+	}
+
+	void hotPixelsProgramDevice(libcaer::devices::device &davis) const {
+		bool success = caerFilterDVSNoiseHotPixelsProgramDevice(handle.get(), davis.getHandle());
+		if (!success) {
+			throw std::runtime_error("DVS noise filter: failed to program hot pixels into device.");
+		}
+	}
+
+	// The device must outlive the filter, or be detached first.
+	void hotPixelsAttachDevice(libcaer::devices::device &davis) {
+		caerFilterDVSNoiseHotPixelsAttachDevice(handle.get(), davis.getHandle());
+	}
+
+	void hotPixelsDetachDevice() {
+		caerFilterDVSNoiseHotPixelsAttachDevice(handle.get(), nullptr);
+	}
+
+	void configSet(uint8_t paramAddr, uint64_t param) {
+		bool success = caerFilterDVSNoiseConfigSet(handle.get(), paramAddr, param);
+		if (!success) {
+			std::string exc = "DVS noise filter: failed to set configuration parameter, paramAddr="
+				+ std::to_string(paramAddr) + ", param=" + std::to_string(param) + ".";
+			throw std::runtime_error(exc);
+		}
+	}
+
+	void configGet(uint8_t paramAddr, uint64_t *param) const {
+		bool success = caerFilterDVSNoiseConfigGet(handle.get(), paramAddr, param);
+		if (!success) {
+			std::string exc = "DVS noise filter: failed to get configuration parameter, paramAddr="
+				+ std::to_string(paramAddr) + ".";
+			throw std::runtime_error(exc);
+		}
+	}
+
+	uint64_t configGet(uint8_t paramAddr) const {
+		uint64_t param = 0;
+		configGet(paramAddr, &param);
+		return (param);
+	}
+};
+
+}
+}
+
+#endif /* LIBCAER_FILTERS_DVS_NOISE_HPP_ */
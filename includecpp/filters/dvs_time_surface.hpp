@@ -0,0 +1,80 @@
+#ifndef LIBCAER_FILTERS_DVS_TIME_SURFACE_HPP_
+#define LIBCAER_FILTERS_DVS_TIME_SURFACE_HPP_
+
+#include <libcaer/filters/dvs_time_surface.h>
+#include "../events/polarity.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace libcaer {
+namespace filters {
+
+class DVSTimeSurface {
+private:
+	std::shared_ptr<struct caer_filter_dvs_time_surface> handle;
+	size_t surfaceSize;
+
+public:
+	DVSTimeSurface(uint16_t sizeX, uint16_t sizeY) : surfaceSize(static_cast<size_t>(sizeX) * sizeY) {
+		caerFilterDVSTimeSurface surface = caerFilterDVSTimeSurfaceInitialize(sizeX, sizeY);
+
+		// Handle constructor failure.
+		if (surface == nullptr) {
+			throw std::runtime_error("Failed to initialize DVS time surface.");
+		}
+
+		// Use stateless lambda for shared_ptr custom deleter.
+		auto deleteSurface = [](caerFilterDVSTimeSurface ts) {
+			// Run destructor, free all memory.
+			// Never fails in current implementation.
+			caerFilterDVSTimeSurfaceDestroy(ts);
+		};
+
+		handle = std::shared_ptr<struct caer_filter_dvs_time_surface>(surface, deleteSurface);
+	}
+
+	void reset() {
+		caerFilterDVSTimeSurfaceReset(handle.get());
+	}
+
+	void update(const libcaer::events::PolarityEventPacket &polarity) {
+		caerFilterDVSTimeSurfaceUpdate(handle.get(),
+			reinterpret_cast<caerPolarityEventPacketConst>(polarity.getHeaderPointer()));
+	}
+
+	int64_t getLastTimestamp() const noexcept {
+		return (caerFilterDVSTimeSurfaceGetLastTimestamp(handle.get()));
+	}
+
+	int64_t getTimestamp(uint16_t x, uint16_t y, enum caer_filter_dvs_time_surface_polarity polarity) const noexcept {
+		return (caerFilterDVSTimeSurfaceGetTimestamp(handle.get(), x, y, polarity));
+	}
+
+	std::vector<int64_t> getNeighborhood(
+		uint16_t x, uint16_t y, uint8_t radius, enum caer_filter_dvs_time_surface_polarity polarity) const {
+		size_t side = (2 * static_cast<size_t>(radius)) + 1;
+		std::vector<int64_t> timestamps(side * side);
+
+		caerFilterDVSTimeSurfaceGetNeighborhood(handle.get(), x, y, radius, polarity, timestamps.data());
+
+		return (timestamps);
+	}
+
+	void exportSurface(int64_t timestamp, float decayTime, enum caer_filter_dvs_time_surface_polarity polarity,
+		std::vector<float> &surfaceOut) const {
+		surfaceOut.resize(surfaceSize);
+
+		bool success
+			= caerFilterDVSTimeSurfaceExport(handle.get(), timestamp, decayTime, polarity, surfaceOut.data());
+		if (!success) {
+			std::string exc = "DVS time surface: failed to export, decayTime=" + std::to_string(decayTime) + ".";
+			throw std::runtime_error(exc);
+		}
+	}
+};
+
+}
+}
+
+#endif /* LIBCAER_FILTERS_DVS_TIME_SURFACE_HPP_ */
@@ -48,6 +48,54 @@ public:
 	void *look() const noexcept {
 		return (caerRingBufferLook(ringBuffer.get()));
 	}
+
+	size_t putBatch(void *const *elems, size_t elemsNumber) const noexcept {
+		return (caerRingBufferPutBatch(ringBuffer.get(), elems, elemsNumber));
+	}
+
+	size_t getBatch(void **elems, size_t elemsMax) const noexcept {
+		return (caerRingBufferGetBatch(ringBuffer.get(), elems, elemsMax));
+	}
+};
+
+class StreamRingBuffer {
+private:
+	std::shared_ptr<struct caer_stream_ring_buffer> ringBuffer;
+
+public:
+	StreamRingBuffer(size_t size, size_t elementSize) {
+		caerStreamRingBuffer rBuf = caerStreamRingBufferInit(size, elementSize);
+
+		// Handle constructor failure.
+		if (rBuf == nullptr) {
+			throw std::runtime_error("Failed to initialize stream ring-buffer.");
+		}
+
+		// Use stateless lambda for shared_ptr custom deleter.
+		auto deleteRingBuffer = [](caerStreamRingBuffer rbf) {
+			// Run destructor, free all memory.
+			// Never fails in current implementation.
+			caerStreamRingBufferFree(rbf);
+		};
+
+		ringBuffer = std::shared_ptr<struct caer_stream_ring_buffer>(rBuf, deleteRingBuffer);
+	}
+
+	void *reserve(size_t &length) const noexcept {
+		return (caerStreamRingBufferReserve(ringBuffer.get(), &length));
+	}
+
+	void commit(size_t length) const noexcept {
+		caerStreamRingBufferCommit(ringBuffer.get(), length);
+	}
+
+	const void *peek(size_t &length) const noexcept {
+		return (caerStreamRingBufferPeek(ringBuffer.get(), &length));
+	}
+
+	void release(size_t length) const noexcept {
+		caerStreamRingBufferRelease(ringBuffer.get(), length);
+	}
 };
 
 }
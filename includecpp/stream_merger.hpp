@@ -0,0 +1,129 @@
+#ifndef LIBCAER_STREAM_MERGER_HPP_
+#define LIBCAER_STREAM_MERGER_HPP_
+
+#include <libcaer/stream_merger.h>
+#include "events/packetContainer.hpp"
+#include "events/utils.hpp"
+#include "devices/device.hpp"
+#include <memory>
+
+namespace libcaer {
+namespace streammerger {
+
+class StreamMerger {
+private:
+	std::shared_ptr<struct caer_stream_merger> merger;
+
+public:
+	StreamMerger(size_t inputsNumber, int64_t reorderWindow) {
+		caerStreamMerger sMerger = caerStreamMergerInitialize(inputsNumber, reorderWindow);
+
+		// Handle constructor failure.
+		if (sMerger == nullptr) {
+			throw std::runtime_error("Failed to initialize stream merger.");
+		}
+
+		// Use stateless lambda for shared_ptr custom deleter.
+		auto deleteStreamMerger = [](caerStreamMerger sm) {
+			// Run destructor, free all memory.
+			// Never fails in current implementation.
+			caerStreamMergerDestroy(sm);
+		};
+
+		merger = std::shared_ptr<struct caer_stream_merger>(sMerger, deleteStreamMerger);
+	}
+
+	// The merger works on C containers and takes ownership of them, so the
+	// packets are copied; the C++ container can still be used afterwards.
+	void push(size_t input, const libcaer::events::EventPacketContainer &container) const {
+		caerEventPacketContainer cContainer = caerEventPacketContainerAllocate(container.size());
+		if (cContainer == nullptr) {
+			throw std::runtime_error("Failed to allocate packet container for stream merger.");
+		}
+
+		for (int32_t i = 0; i < container.size(); i++) {
+			std::shared_ptr<const libcaer::events::EventPacket> packet = container.getEventPacket(i);
+
+			if (packet != nullptr) {
+				caerEventPacketHeader packetCopy = caerEventPacketCopy(packet->getHeaderPointer());
+				if (packetCopy == nullptr) {
+					caerEventPacketContainerFree(cContainer);
+					throw std::runtime_error("Failed to copy event packet for stream merger.");
+				}
+
+				caerEventPacketContainerSetEventPacket(cContainer, i, packetCopy);
+			}
+		}
+
+		bool success = caerStreamMergerPush(merger.get(), input, cContainer);
+		if (!success) {
+			throw std::runtime_error("Failed to push packet container to stream merger.");
+		}
+	}
+
+	void inputEnd(size_t input) const noexcept {
+		caerStreamMergerInputEnd(merger.get(), input);
+	}
+
+	std::unique_ptr<libcaer::events::EventPacketContainer> pop() const {
+		return (toCppContainer(caerStreamMergerPop(merger.get())));
+	}
+
+	// The device must stay alive as long as it is attached.
+	void attachDevice(size_t input, const libcaer::devices::device &dev) const {
+		bool success = caerStreamMergerAttachDevice(merger.get(), input, dev.getHandle());
+		if (!success) {
+			throw std::runtime_error("Failed to attach device to stream merger.");
+		}
+	}
+
+	void detachDevice(size_t input) const {
+		bool success = caerStreamMergerAttachDevice(merger.get(), input, nullptr);
+		if (!success) {
+			throw std::runtime_error("Failed to detach device from stream merger.");
+		}
+	}
+
+	std::unique_ptr<libcaer::events::EventPacketContainer> dataGet() const {
+		return (toCppContainer(caerStreamMergerDataGet(merger.get())));
+	}
+
+	uint64_t getLateContainers() const noexcept {
+		return (caerStreamMergerGetLateContainers(merger.get()));
+	}
+
+private:
+	static std::unique_ptr<libcaer::events::EventPacketContainer> toCppContainer(caerEventPacketContainer cContainer) {
+		if (cContainer == nullptr) {
+			// NULL return means no data, forward that.
+			return (nullptr);
+		}
+
+		std::unique_ptr<libcaer::events::EventPacketContainer> cppContainer = std::unique_ptr<
+			libcaer::events::EventPacketContainer>(new libcaer::events::EventPacketContainer());
+
+		for (int32_t i = 0; i < caerEventPacketContainerGetEventPacketsNumber(cContainer); i++) {
+			caerEventPacketHeader packet = caerEventPacketContainerGetEventPacket(cContainer, i);
+
+			// NULL packets just get added directly.
+			if (packet == nullptr) {
+				cppContainer->addEventPacket(nullptr);
+			}
+			else {
+				// Make sure the proper constructors are called when building the shared_ptr.
+				cppContainer->addEventPacket(libcaer::events::utils::makeSharedFromCStruct(packet));
+			}
+		}
+
+		// Free original C container. The event packet memory is now managed by
+		// the EventPacket classes inside the new C++ EventPacketContainer.
+		free(cContainer);
+
+		return (cppContainer);
+	}
+};
+
+}
+}
+
+#endif /* LIBCAER_STREAM_MERGER_HPP_ */
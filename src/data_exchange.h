@@ -4,6 +4,7 @@
 #include "libcaer.h"
 #include "devices/device.h"
 #include "ringbuffer.h"
+#include "portable_time.h"
 #include <stdatomic.h>
 
 #if defined(HAVE_PTHREADS)
@@ -83,6 +84,79 @@ static inline caerEventPacketContainer dataExchangeGet(dataExchange state, atomi
 	return (NULL);
 }
 
+// Get up to 'containersMax' containers in one go. If none is available, wait
+// up to 'timeout' µs for some, as long as the data transfers are running.
+// The blocking setting does not apply here. Returns the number of containers.
+static inline size_t dataExchangeGetBatch(dataExchange state, atomic_uint_fast32_t *transfersRunning,
+	caerEventPacketContainer *containers, size_t containersMax, uint32_t timeout) {
+	// Nothing can be returned, don't wait for data.
+	if (containersMax == 0) {
+		return (0);
+	}
+
+	struct timespec waitStart;
+	bool waitStarted = false;
+
+	while (true) {
+		size_t containersNumber = 0;
+
+		while (containersNumber < containersMax) {
+			void *elems[64];
+			size_t elemsMax = containersMax - containersNumber;
+			if (elemsMax > 64) {
+				elemsMax = 64;
+			}
+
+			size_t elemsNumber = caerRingBufferGetBatch(state->buffer, elems, elemsMax);
+
+			for (size_t i = 0; i < elemsNumber; i++) {
+				containers[containersNumber++] = elems[i];
+			}
+
+			if (elemsNumber < elemsMax) {
+				// Ring-buffer is empty.
+				break;
+			}
+		}
+
+		if (containersNumber > 0) {
+			// Signal these pieces of data are no longer available for later acquisition.
+			if (state->notifyDataDecrease != NULL) {
+				for (size_t i = 0; i < containersNumber; i++) {
+					state->notifyDataDecrease(state->notifyDataUserPtr);
+				}
+			}
+
+			return (containersNumber);
+		}
+
+		if ((timeout == 0) || (atomic_load(transfersRunning) != THR_RUNNING)) {
+			return (0);
+		}
+
+		struct timespec now;
+		portable_clock_gettime_monotonic(&now);
+
+		if (!waitStarted) {
+			waitStart = now;
+			waitStarted = true;
+		}
+
+		uint64_t waitTime = (uint64_t) (((int64_t) (now.tv_sec - waitStart.tv_sec) * 1000000LL)
+										+ ((int64_t) (now.tv_nsec - waitStart.tv_nsec) / 1000));
+
+		if (waitTime >= timeout) {
+			return (0);
+		}
+
+		// Sleep for 100µs, or what's left of the timeout, to avoid busy loop.
+		uint64_t sleepTime = ((timeout - waitTime) < 100) ? (timeout - waitTime) : (100);
+
+		struct timespec noDataSleep = { .tv_sec = 0, .tv_nsec = (long) (sleepTime * 1000) };
+		thrd_sleep(&noDataSleep, NULL);
+	}
+}
+
 static inline bool dataExchangePut(dataExchange state, caerEventPacketContainer container) {
 	if (!caerRingBufferPut(state->buffer, container)) {
 		return (false);
@@ -114,16 +188,20 @@ static inline void dataExchangePutForce(dataExchange state, atomic_uint_fast32_t
 }
 
 static inline void dataExchangeBufferEmpty(dataExchange state) {
-	// Empty ringbuffer.
-	caerEventPacketContainer container;
-	while ((container = caerRingBufferGet(state->buffer)) != NULL) {
-		// Notify data-not-available call-back.
-		if (state->notifyDataDecrease != NULL) {
-			state->notifyDataDecrease(state->notifyDataUserPtr);
+	// Empty ringbuffer, many containers at a time.
+	void *containers[64];
+	size_t containersNumber;
+
+	while ((containersNumber = caerRingBufferGetBatch(state->buffer, containers, 64)) > 0) {
+		for (size_t i = 0; i < containersNumber; i++) {
+			// Notify data-not-available call-back.
+			if (state->notifyDataDecrease != NULL) {
+				state->notifyDataDecrease(state->notifyDataUserPtr);
+			}
+
+			// Free container, which will free its subordinate packets too.
+			caerEventPacketContainerFree(containers[i]);
 		}
-
-		// Free container, which will free its subordinate packets too.
-		caerEventPacketContainerFree(container);
 	}
 }
 
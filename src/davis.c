@@ -693,17 +693,25 @@ struct caer_davis_info caerDavisInfoGet(caerDeviceHandle cdh) {
 }
 
 bool davisSendDefaultConfig(caerDeviceHandle cdh) {
+	davisHandle handle = (davisHandle) cdh;
+
+	// Queue up all the parameters and send them together, this is a lot
+	// faster than waiting for each one to complete.
+	spiConfigBatchBegin(&handle->state.usbState);
+
 	// First send default chip/bias config.
-	if (!davisSendDefaultChipConfig(cdh)) {
-		return (false);
-	}
+	bool success = davisSendDefaultChipConfig(cdh);
 
 	// Send default FPGA config.
-	if (!davisSendDefaultFPGAConfig(cdh)) {
-		return (false);
+	if (success) {
+		success = davisSendDefaultFPGAConfig(cdh);
 	}
 
-	return (true);
+	if (!spiConfigBatchEnd(&handle->state.usbState)) {
+		success = false;
+	}
+
+	return (success);
 }
 
 static bool davisSendDefaultFPGAConfig(caerDeviceHandle cdh) {
@@ -1175,6 +1183,10 @@ bool davisConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 			return (containerGenerationConfigSet(&state->container, paramAddr, param));
 			break;
 
+		case CAER_HOST_CONFIG_THREAD:
+			return (threadSchedulingConfigSet(&state->usbState.threadScheduling, paramAddr, param));
+			break;
+
 		case CAER_HOST_CONFIG_LOG:
 			switch (paramAddr) {
 				case CAER_HOST_CONFIG_LOG_LEVEL:
@@ -1785,6 +1797,29 @@ bool davisConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 	return (true);
 }
 
+bool davisConfigSetBatch(caerDeviceHandle cdh, const struct caer_device_config *configs, size_t configsNumber) {
+	davisHandle handle = (davisHandle) cdh;
+	davisState state = &handle->state;
+
+	// Device-side parameters are queued and sent together in multi-config
+	// requests, see spiConfigBatchBegin().
+	spiConfigBatchBegin(&state->usbState);
+
+	bool success = true;
+
+	for (size_t i = 0; (i < configsNumber) && success; i++) {
+		success = davisConfigSet(cdh, configs[i].modAddr, configs[i].paramAddr, configs[i].param);
+	}
+
+	// Always end the batch, to send out and wait on what was already queued.
+	if (!spiConfigBatchEnd(&state->usbState)) {
+		davisLog(CAER_LOG_ERROR, handle, "Failed to send batch of configuration parameters.");
+		success = false;
+	}
+
+	return (success);
+}
+
 bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uint32_t *param) {
 	davisHandle handle = (davisHandle) cdh;
 	davisState state = &handle->state;
@@ -1802,6 +1837,10 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 			return (containerGenerationConfigGet(&state->container, paramAddr, param));
 			break;
 
+		case CAER_HOST_CONFIG_THREAD:
+			return (threadSchedulingConfigGet(&state->usbState.threadScheduling, paramAddr, param));
+			break;
+
 		case CAER_HOST_CONFIG_LOG:
 			switch (paramAddr) {
 				case CAER_HOST_CONFIG_LOG_LEVEL:
@@ -1824,7 +1863,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 				case DAVIS_CONFIG_MUX_DROP_IMU_ON_TRANSFER_STALL:
 				case DAVIS_CONFIG_MUX_DROP_EXTINPUT_ON_TRANSFER_STALL:
 				case DAVIS_CONFIG_MUX_DROP_MIC_ON_TRANSFER_STALL:
-					return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_MUX, paramAddr, param));
+					return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_MUX, paramAddr, param));
 					break;
 
 				case DAVIS_CONFIG_MUX_TIMESTAMP_RESET:
@@ -1872,7 +1911,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 				case DAVIS_CONFIG_DVS_HAS_PIXEL_FILTER:
 				case DAVIS_CONFIG_DVS_HAS_BACKGROUND_ACTIVITY_FILTER:
 				case DAVIS_CONFIG_DVS_HAS_TEST_EVENT_GENERATOR:
-					return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_DVS, paramAddr, param));
+					return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_DVS, paramAddr, param));
 					break;
 
 				case DAVIS_CONFIG_DVS_FILTER_PIXEL_0_ROW:
@@ -1892,7 +1931,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 				case DAVIS_CONFIG_DVS_FILTER_PIXEL_6_COLUMN:
 				case DAVIS_CONFIG_DVS_FILTER_PIXEL_7_COLUMN:
 					if (handle->info.dvsHasPixelFilter) {
-						return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_DVS, paramAddr, param));
+						return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_DVS, paramAddr, param));
 					}
 					else {
 						return (false);
@@ -1904,7 +1943,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 				case DAVIS_CONFIG_DVS_FILTER_REFRACTORY_PERIOD:
 				case DAVIS_CONFIG_DVS_FILTER_REFRACTORY_PERIOD_TIME:
 					if (handle->info.dvsHasBackgroundActivityFilter) {
-						return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_DVS, paramAddr, param));
+						return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_DVS, paramAddr, param));
 					}
 					else {
 						return (false);
@@ -1913,7 +1952,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 
 				case DAVIS_CONFIG_DVS_TEST_EVENT_GENERATOR_ENABLE:
 					if (handle->info.dvsHasTestEventGenerator) {
-						return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_DVS, paramAddr, param));
+						return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_DVS, paramAddr, param));
 					}
 					else {
 						return (false);
@@ -1925,7 +1964,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 				case DAVIS_CONFIG_DVS_FILTER_ROI_END_COLUMN:
 				case DAVIS_CONFIG_DVS_FILTER_ROI_END_ROW:
 					if (handle->info.dvsHasROIFilter) {
-						return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_DVS, paramAddr, param));
+						return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_DVS, paramAddr, param));
 					}
 					else {
 						return (false);
@@ -1992,14 +2031,14 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 				case DAVIS_CONFIG_APS_START_ROW_0:
 				case DAVIS_CONFIG_APS_END_ROW_0:
 				case DAVIS_CONFIG_APS_ROI0_ENABLED:
-					return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_APS, paramAddr, param));
+					return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_APS, paramAddr, param));
 					break;
 
 				case DAVIS_CONFIG_APS_RESET_SETTLE:
 				case DAVIS_CONFIG_APS_NULL_SETTLE:
 					// Not supported on DAVIS RGB APS state machine.
 					if (!IS_DAVISRGB(handle->info.chipID)) {
-						return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_APS, paramAddr, param));
+						return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_APS, paramAddr, param));
 					}
 					else {
 						return (false);
@@ -2009,7 +2048,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 				case DAVIS_CONFIG_APS_COLUMN_SETTLE:
 					// Only available on DAVIS240 due to external ADC use, which has both a row and column timing.
 					if (IS_DAVIS240(handle->info.chipID)) {
-						return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_APS, paramAddr, param));
+						return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_APS, paramAddr, param));
 					}
 					else {
 						return (false);
@@ -2025,7 +2064,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 					// Exposure and Frame Delay are in µs, must be converted from native FPGA cycles
 					// by dividing with ADC clock value.
 					uint32_t cyclesValue = 0;
-					if (!spiConfigReceive(&state->usbState, DAVIS_CONFIG_APS, paramAddr, &cyclesValue)) {
+					if (!spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_APS, paramAddr, &cyclesValue)) {
 						return (false);
 					}
 
@@ -2038,7 +2077,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 
 				case DAVIS_CONFIG_APS_GLOBAL_SHUTTER:
 					if (handle->info.apsHasGlobalShutter) {
-						return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_APS, paramAddr, param));
+						return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_APS, paramAddr, param));
 					}
 					else {
 						return (false);
@@ -2061,7 +2100,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 				case DAVIS_CONFIG_APS_ROI2_ENABLED:
 				case DAVIS_CONFIG_APS_ROI3_ENABLED:
 					if (handle->info.apsHasQuadROI) {
-						return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_APS, paramAddr, param));
+						return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_APS, paramAddr, param));
 					}
 					else {
 						return (false);
@@ -2074,7 +2113,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 				case DAVIS_CONFIG_APS_RAMP_SHORT_RESET:
 				case DAVIS_CONFIG_APS_ADC_TEST_MODE:
 					if (handle->info.apsHasInternalADC) {
-						return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_APS, paramAddr, param));
+						return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_APS, paramAddr, param));
 					}
 					else {
 						return (false);
@@ -2089,7 +2128,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 				case DAVISRGB_CONFIG_APS_GSFDRESET:
 					// Support for DAVISRGB extra timing parameters.
 					if (IS_DAVISRGB(handle->info.chipID)) {
-						return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_APS, paramAddr, param));
+						return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_APS, paramAddr, param));
 					}
 					else {
 						return (false);
@@ -2123,7 +2162,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 				case DAVIS_CONFIG_IMU_DIGITAL_LOW_PASS_FILTER:
 				case DAVIS_CONFIG_IMU_ACCEL_FULL_SCALE:
 				case DAVIS_CONFIG_IMU_GYRO_FULL_SCALE:
-					return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_IMU, paramAddr, param));
+					return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_IMU, paramAddr, param));
 					break;
 
 				default:
@@ -2142,7 +2181,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 				case DAVIS_CONFIG_EXTINPUT_DETECT_PULSE_LENGTH:
 				case DAVIS_CONFIG_EXTINPUT_HAS_GENERATOR:
 				case DAVIS_CONFIG_EXTINPUT_HAS_EXTRA_DETECTORS:
-					return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_EXTINPUT, paramAddr, param));
+					return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_EXTINPUT, paramAddr, param));
 					break;
 
 				case DAVIS_CONFIG_EXTINPUT_RUN_GENERATOR:
@@ -2153,7 +2192,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 				case DAVIS_CONFIG_EXTINPUT_GENERATE_INJECT_ON_RISING_EDGE:
 				case DAVIS_CONFIG_EXTINPUT_GENERATE_INJECT_ON_FALLING_EDGE:
 					if (handle->info.extInputHasGenerator) {
-						return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_EXTINPUT, paramAddr, param));
+						return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_EXTINPUT, paramAddr, param));
 					}
 					else {
 						return (false);
@@ -2173,7 +2212,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 				case DAVIS_CONFIG_EXTINPUT_DETECT_PULSE_POLARITY2:
 				case DAVIS_CONFIG_EXTINPUT_DETECT_PULSE_LENGTH2:
 					if (handle->info.extInputHasExtraDetectors) {
-						return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_EXTINPUT, paramAddr, param));
+						return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_EXTINPUT, paramAddr, param));
 					}
 					else {
 						return (false);
@@ -2190,7 +2229,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 			switch (paramAddr) {
 				case DAVIS_CONFIG_MICROPHONE_RUN:
 				case DAVIS_CONFIG_MICROPHONE_SAMPLE_FREQUENCY:
-					return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_MICROPHONE, paramAddr, param));
+					return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_MICROPHONE, paramAddr, param));
 					break;
 
 				default:
@@ -2205,7 +2244,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 				if (IS_DAVIS240(handle->info.chipID)) {
 					// DAVIS240 uses the old bias generator with 22 branches, and uses all of them.
 					if (paramAddr < 22) {
-						return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_BIAS, paramAddr, param));
+						return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_BIAS, paramAddr, param));
 					}
 				}
 				else if (IS_DAVIS128(handle->info.chipID) || IS_DAVIS208(handle->info.chipID)
@@ -2240,13 +2279,13 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 						case DAVIS128_CONFIG_BIAS_BIASBUFFER:
 						case DAVIS128_CONFIG_BIAS_SSP:
 						case DAVIS128_CONFIG_BIAS_SSN:
-							return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_BIAS, paramAddr, param));
+							return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_BIAS, paramAddr, param));
 							break;
 
 						case DAVIS346_CONFIG_BIAS_ADCTESTVOLTAGE:
 							// Only supported by DAVIS346 and DAVIS640 chips.
 							if (IS_DAVIS346(handle->info.chipID) || IS_DAVIS640(handle->info.chipID)) {
-								return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_BIAS, paramAddr, param));
+								return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_BIAS, paramAddr, param));
 							}
 							break;
 
@@ -2256,7 +2295,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 						case DAVIS208_CONFIG_BIAS_REFSSBN:
 							// Only supported by DAVIS208 chips.
 							if (IS_DAVIS208(handle->info.chipID)) {
-								return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_BIAS, paramAddr, param));
+								return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_BIAS, paramAddr, param));
 							}
 							break;
 
@@ -2302,7 +2341,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 						case DAVISRGB_CONFIG_BIAS_BIASBUFFER:
 						case DAVISRGB_CONFIG_BIAS_SSP:
 						case DAVISRGB_CONFIG_BIAS_SSN:
-							return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_BIAS, paramAddr, param));
+							return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_BIAS, paramAddr, param));
 							break;
 
 						default:
@@ -2328,20 +2367,20 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 					case DAVIS128_CONFIG_CHIP_RESETTESTPIXEL:
 					case DAVIS128_CONFIG_CHIP_AERNAROW:
 					case DAVIS128_CONFIG_CHIP_USEAOUT:
-						return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_CHIP, paramAddr, param));
+						return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_CHIP, paramAddr, param));
 						break;
 
 					case DAVIS240_CONFIG_CHIP_SPECIALPIXELCONTROL:
 						// Only supported by DAVIS240 A/B chips.
 						if (IS_DAVIS240A(handle->info.chipID) || IS_DAVIS240B(handle->info.chipID)) {
-							return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_CHIP, paramAddr, param));
+							return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_CHIP, paramAddr, param));
 						}
 						break;
 
 					case DAVIS128_CONFIG_CHIP_GLOBAL_SHUTTER:
 						// Only supported by some chips.
 						if (handle->info.apsHasGlobalShutter) {
-							return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_CHIP, paramAddr, param));
+							return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_CHIP, paramAddr, param));
 						}
 						break;
 
@@ -2350,7 +2389,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 						if (IS_DAVIS128(
 							handle->info.chipID) || IS_DAVIS208(handle->info.chipID) || IS_DAVIS346(handle->info.chipID)
 							|| IS_DAVIS640(handle->info.chipID) || IS_DAVISRGB(handle->info.chipID)) {
-							return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_CHIP, paramAddr, param));
+							return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_CHIP, paramAddr, param));
 						}
 						break;
 
@@ -2358,7 +2397,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 						// Only supported by some of the new DAVIS chips.
 						if (IS_DAVIS346(
 							handle->info.chipID) || IS_DAVIS640(handle->info.chipID) || IS_DAVISRGB(handle->info.chipID)) {
-							return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_CHIP, paramAddr, param));
+							return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_CHIP, paramAddr, param));
 						}
 						break;
 
@@ -2367,7 +2406,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 					case DAVISRGB_CONFIG_CHIP_ADJUSTTX2OVG2HI: // Also DAVIS208_CONFIG_CHIP_SELECTSENSE.
 						// Only supported by DAVIS208 and DAVISRGB.
 						if (IS_DAVIS208(handle->info.chipID) || IS_DAVISRGB(handle->info.chipID)) {
-							return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_CHIP, paramAddr, param));
+							return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_CHIP, paramAddr, param));
 						}
 						break;
 
@@ -2375,7 +2414,7 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 					case DAVIS208_CONFIG_CHIP_SELECTHIGHPASS:
 						// Only supported by DAVIS208.
 						if (IS_DAVIS208(handle->info.chipID)) {
-							return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_CHIP, paramAddr, param));
+							return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_CHIP, paramAddr, param));
 						}
 						break;
 
@@ -2407,14 +2446,14 @@ bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uin
 		case DAVIS_CONFIG_USB:
 			switch (paramAddr) {
 				case DAVIS_CONFIG_USB_RUN:
-					return (spiConfigReceive(&state->usbState, DAVIS_CONFIG_USB, paramAddr, param));
+					return (spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_USB, paramAddr, param));
 					break;
 
 				case DAVIS_CONFIG_USB_EARLY_PACKET_DELAY: {
 					// Early packet delay is 125µs slices on host, but in cycles
 					// @ USB_CLOCK_FREQ on FPGA, so we must divide here.
 					uint32_t cyclesValue = 0;
-					if (!spiConfigReceive(&state->usbState, DAVIS_CONFIG_USB, paramAddr, &cyclesValue)) {
+					if (!spiConfigReceiveCached(&state->usbState, DAVIS_CONFIG_USB, paramAddr, &cyclesValue)) {
 						return (false);
 					}
 
@@ -2647,6 +2686,15 @@ caerEventPacketContainer davisDataGet(caerDeviceHandle cdh) {
 	return (dataExchangeGet(&state->dataExchange, &state->usbState.dataTransfersRun));
 }
 
+size_t davisDataGetBatch(caerDeviceHandle cdh, caerEventPacketContainer *containers, size_t containersMax,
+	uint32_t timeout) {
+	davisHandle handle = (davisHandle) cdh;
+	davisState state = &handle->state;
+
+	return (dataExchangeGetBatch(&state->dataExchange, &state->usbState.dataTransfersRun, containers, containersMax,
+		timeout));
+}
+
 #define TS_WRAP_ADD 0x8000
 
 static void davisEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSent) {
@@ -4021,7 +4069,8 @@ static void allocateDebugTransfers(davisHandle handle) {
 		handle->state.fx3Support.debugTransfers[i]->timeout = 0;
 		handle->state.fx3Support.debugTransfers[i]->flags = LIBUSB_TRANSFER_FREE_BUFFER;
 
-		if ((errno = libusb_submit_transfer(handle->state.fx3Support.debugTransfers[i])) == LIBUSB_SUCCESS) {
+		if ((errno = usbTransferSubmit(&handle->state.usbState, handle->state.fx3Support.debugTransfers[i]))
+			== LIBUSB_SUCCESS) {
 			atomic_fetch_add(&handle->state.fx3Support.activeDebugTransfers, 1);
 		}
 		else {
@@ -4051,7 +4100,7 @@ static void cancelAndDeallocateDebugTransfers(davisHandle handle) {
 		// It seems like one cancel pass is not enough and some hang around.
 		for (size_t i = 0; i < DEBUG_TRANSFER_NUM; i++) {
 			if (handle->state.fx3Support.debugTransfers[i] != NULL) {
-				errno = libusb_cancel_transfer(handle->state.fx3Support.debugTransfers[i]);
+				errno = usbTransferCancel(&handle->state.usbState, handle->state.fx3Support.debugTransfers[i]);
 				if ((errno != LIBUSB_SUCCESS) && (errno != LIBUSB_ERROR_NOT_FOUND)) {
 					davisLog(CAER_LOG_CRITICAL, handle,
 						"Unable to cancel libusb transfer %zu (debug channel). Error: %s (%d).", i,
@@ -4087,7 +4136,7 @@ static void LIBUSB_CALL libUsbDebugCallback(struct libusb_transfer *transfer) {
 
 	if (transfer->status == LIBUSB_TRANSFER_COMPLETED) {
 		// Submit transfer again.
-		if (libusb_submit_transfer(transfer) == LIBUSB_SUCCESS) {
+		if (usbTransferSubmit(&handle->state.usbState, transfer) == LIBUSB_SUCCESS) {
 			return;
 		}
 	}
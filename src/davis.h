@@ -29,8 +29,6 @@
 
 #define IMU6_COUNT 15
 
-#define SPI_CONFIG_MSG_SIZE 6
-
 #define DAVIS_EVENT_TYPES 5
 #define DAVIS_SAMPLE_POSITION 4
 
@@ -195,6 +193,7 @@ bool davisSendDefaultConfig(caerDeviceHandle cdh);
 // Negative addresses are used for host-side configuration.
 // Positive addresses (including zero) are used for device-side configuration.
 bool davisConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uint32_t param);
+bool davisConfigSetBatch(caerDeviceHandle cdh, const struct caer_device_config *configs, size_t configsNumber);
 bool davisConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uint32_t *param);
 
 bool davisDataStart(caerDeviceHandle handle, void (*dataNotifyIncrease)(void *ptr),
@@ -202,5 +201,7 @@ bool davisDataStart(caerDeviceHandle handle, void (*dataNotifyIncrease)(void *pt
 	void *dataShutdownUserPtr);
 bool davisDataStop(caerDeviceHandle handle);
 caerEventPacketContainer davisDataGet(caerDeviceHandle handle);
+size_t davisDataGetBatch(caerDeviceHandle handle, caerEventPacketContainer *containers, size_t containersMax,
+	uint32_t timeout);
 
 #endif /* LIBCAER_SRC_DAVIS_H_ */
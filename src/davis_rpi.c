@@ -39,6 +39,8 @@ static void gpioThreadStop(davisRPiHandle handle);
 static bool initRPi(davisRPiHandle handle);
 static void closeRPi(davisRPiHandle handle);
 static int gpioThreadRun(void *handlePtr);
+static int gpioTranslatorThreadRun(void *handlePtr);
+static size_t gpioReadTransactions(davisRPiState state, uint16_t *data, size_t transactions);
 static bool spiInit(davisRPiState state);
 static void spiClose(davisRPiState state);
 static bool spiConfigSend(davisRPiState state, uint8_t moduleAddr, uint8_t paramAddr, uint32_t param);
@@ -52,6 +54,7 @@ bool davisRPiROIConfigure(caerDeviceHandle cdh, uint8_t roiRegion, bool enable,
 #if DAVIS_RPI_BENCHMARK == 1
 static void setupGPIOTest(davisRPiHandle handle, enum benchmarkMode mode);
 static void shutdownGPIOTest(davisRPiHandle handle);
+static bool gpioBenchmarkUpdate(davisRPiHandle handle);
 #endif
 
 static bool initRPi(davisRPiHandle handle) {
@@ -120,6 +123,47 @@ static void closeRPi(davisRPiHandle handle) {
 	munmap((void *) state->gpio.gpioReg, GPIO_REG_LEN);
 }
 
+// Do up to 'transactions' transactions via DDR-AER, each latches two data
+// points into 'data'. Returns early if no request comes for a while.
+// Returns the number of data points read.
+static size_t gpioReadTransactions(davisRPiState state, uint16_t *data, size_t transactions) {
+	size_t dataSize = 0;
+
+	while (transactions-- > 0) {
+		// Do transaction via DDR-AER. Is there a request?
+		size_t noReqCount = 0;
+		while (GPIO_GET(state->gpio.gpioReg, GPIO_AER_REQ) != 0) {
+			// Track failed wait on requests, and simply break early once
+			// the maximum is reached, to avoid dead-locking in here.
+			noReqCount++;
+			if (noReqCount == DAVIS_RPI_MAX_WAIT_REQ_COUNT) {
+				return (dataSize);
+			}
+		}
+
+		// Request is present, latch data.
+		data[dataSize] = GPIO_AER_DATA(state->gpio.gpioReg);
+		dataSize++;
+
+		// ACK ACK! (active-low, so clear).
+		GPIO_CLR(state->gpio.gpioReg, GPIO_AER_ACK);
+
+		// Wait for REQ to go back off (high).
+		while (GPIO_GET(state->gpio.gpioReg, GPIO_AER_REQ) == 0) {
+			;
+		}
+
+		// Latch data again.
+		data[dataSize] = GPIO_AER_DATA(state->gpio.gpioReg);
+		dataSize++;
+
+		// ACK ACK off! (active-low, so set).
+		GPIO_SET(state->gpio.gpioReg, GPIO_AER_ACK);
+	}
+
+	return (dataSize);
+}
+
 static int gpioThreadRun(void *handlePtr) {
 	davisRPiHandle handle = handlePtr;
 	davisRPiState state = &handle->state;
@@ -134,12 +178,17 @@ static int gpioThreadRun(void *handlePtr) {
 	thrd_set_name(threadName);
 
 	// Allocate data memory. Up to two data points per transaction.
-	uint16_t *data = malloc(DAVIS_RPI_MAX_TRANSACTION_NUM * 2 * sizeof(uint16_t));
-	if (data == NULL) {
-		davisRPiLog(CAER_LOG_DEBUG, handle, "Failed to allocate memory for GPIO communication.");
+	// Not needed if data goes to the translator thread's ring.
+	uint16_t *data = NULL;
 
-		atomic_store(&state->gpio.threadState, THR_EXITED);
-		return (EXIT_FAILURE);
+	if (state->gpio.ring == NULL) {
+		data = malloc(DAVIS_RPI_MAX_TRANSACTION_NUM * 2 * sizeof(uint16_t));
+		if (data == NULL) {
+			davisRPiLog(CAER_LOG_DEBUG, handle, "Failed to allocate memory for GPIO communication.");
+
+			atomic_store(&state->gpio.threadState, THR_EXITED);
+			return (EXIT_FAILURE);
+		}
 	}
 
 	// Signal data thread ready back to start function.
@@ -148,70 +197,77 @@ static int gpioThreadRun(void *handlePtr) {
 	davisRPiLog(CAER_LOG_DEBUG, handle, "GPIO communication thread running.");
 
 #if DAVIS_RPI_BENCHMARK == 1
-	// Start GPIO testing.
-	spiConfigSend(state, DAVIS_CONFIG_DDRAER, DAVIS_CONFIG_DDRAER_RUN, true);
-	setupGPIOTest(handle, ZEROS);
+	if (state->gpio.ring == NULL) {
+		// Start GPIO testing.
+		spiConfigSend(state, DAVIS_CONFIG_DDRAER, DAVIS_CONFIG_DDRAER_RUN, true);
+		setupGPIOTest(handle, ZEROS);
+	}
 #endif
 
+	struct timespec ringFullSleep = { .tv_sec = 0, .tv_nsec = 100000 };
+
+	struct thread_scheduling_thread scheduling;
+	threadSchedulingThreadInit(&state->threadScheduling, &scheduling, 0);
+
 	// Handle GPIO port reading.
 	while (atomic_load_explicit(&state->gpio.threadState, memory_order_relaxed) == THR_RUNNING) {
-		size_t readTransactions = DAVIS_RPI_MAX_TRANSACTION_NUM;
-		size_t dataSize = 0;
-
-		while (readTransactions-- > 0) {
-			// Do transaction via DDR-AER. Is there a request?
-			size_t noReqCount = 0;
-			while (GPIO_GET(state->gpio.gpioReg, GPIO_AER_REQ) != 0) {
-				// Track failed wait on requests, and simply break early once
-				// the maximum is reached, to avoid dead-locking in here.
-				noReqCount++;
-				if (noReqCount == DAVIS_RPI_MAX_WAIT_REQ_COUNT) {
-					goto processData;
+		threadSchedulingUpdate(&state->threadScheduling, &scheduling, handle->info.deviceString,
+			atomic_load_explicit(&state->deviceLogLevel, memory_order_relaxed));
+
+		if (state->gpio.ring != NULL) {
+#if DAVIS_RPI_BENCHMARK == 1
+			// Translator thread is switching tests and needs the ring to
+			// itself: stop committing until it is done.
+			uint_fast8_t pause = atomic_load(&state->benchmark.gpioPause);
+
+			if (pause != GPIO_PAUSE_OFF) {
+				if (pause == GPIO_PAUSE_REQUESTED) {
+					atomic_store(&state->benchmark.gpioPause, GPIO_PAUSE_ACTIVE);
 				}
+
+				thrd_sleep(&ringFullSleep, NULL);
+				continue;
 			}
+#endif
 
-			// Request is present, latch data.
-			data[dataSize] = GPIO_AER_DATA(state->gpio.gpioReg);
-			dataSize++;
+			// Read straight into the ring, the translator thread does the rest.
+			size_t spanSize = 0;
+			uint16_t *span = caerStreamRingBufferReserve(state->gpio.ring, &spanSize);
 
-			// ACK ACK! (active-low, so clear).
-			GPIO_CLR(state->gpio.gpioReg, GPIO_AER_ACK);
+			if (spanSize < 2) {
+				// Translator thread is behind: stop reading, the device
+				// buffers data in the meantime. Sleep for 100µs, instead of
+				// spinning, for it may need this CPU to catch up.
+				atomic_fetch_add_explicit(&state->gpio.ringFullCount, 1, memory_order_relaxed);
+
+				thrd_sleep(&ringFullSleep, NULL);
+				continue;
+			}
 
-			// Wait for REQ to go back off (high).
-			while (GPIO_GET(state->gpio.gpioReg, GPIO_AER_REQ) == 0) {
-				;
+			size_t readTransactions = spanSize / 2;
+			if (readTransactions > DAVIS_RPI_MAX_TRANSACTION_NUM) {
+				readTransactions = DAVIS_RPI_MAX_TRANSACTION_NUM;
 			}
 
-			// Latch data again.
-			data[dataSize] = GPIO_AER_DATA(state->gpio.gpioReg);
-			dataSize++;
+			size_t dataSize = gpioReadTransactions(state, span, readTransactions);
 
-			// ACK ACK off! (active-low, so set).
-			GPIO_SET(state->gpio.gpioReg, GPIO_AER_ACK);
+			if (dataSize > 0) {
+				caerStreamRingBufferCommit(state->gpio.ring, dataSize);
+			}
+
+			continue;
 		}
 
+		size_t dataSize = gpioReadTransactions(state, data, DAVIS_RPI_MAX_TRANSACTION_NUM);
+
 		// Translate data. Support testing/benchmarking.
-processData:
 		if (dataSize > 0) {
 			davisRPiDataTranslator(handle, data, dataSize);
 		}
 
 #if DAVIS_RPI_BENCHMARK == 1
-		if (state->benchmark.dataCount >= DAVIS_RPI_BENCHMARK_LIMIT_EVENTS) {
-			shutdownGPIOTest(handle);
-
-			if (state->benchmark.testMode == ALTERNATING) {
-				// Last test just done.
-				spiConfigSend(state, DAVIS_CONFIG_DDRAER, DAVIS_CONFIG_DDRAER_RUN, false);
-
-				// SPECIAL OUT: call exceptional shut-down callback and exit.
-				if (state->gpio.shutdownCallback != NULL) {
-					state->gpio.shutdownCallback(state->gpio.shutdownCallbackPtr);
-				}
-				break;
-			}
-
-			setupGPIOTest(handle, state->benchmark.testMode + 1);
+		if (!gpioBenchmarkUpdate(handle)) {
+			break;
 		}
 #endif
 	}
@@ -226,6 +282,67 @@ processData:
 	return (EXIT_SUCCESS);
 }
 
+static int gpioTranslatorThreadRun(void *handlePtr) {
+	davisRPiHandle handle = handlePtr;
+	davisRPiState state = &handle->state;
+
+	davisRPiLog(CAER_LOG_DEBUG, handle, "GPIO translator thread running.");
+
+	// Same name as the GPIO thread, like the USB decode thread.
+	char threadName[MAX_THREAD_NAME_LENGTH + 1]; // +1 for terminating NUL character.
+	strncpy(threadName, handle->info.deviceString, MAX_THREAD_NAME_LENGTH);
+	threadName[MAX_THREAD_NAME_LENGTH] = '\0';
+
+	thrd_set_name(threadName);
+
+#if DAVIS_RPI_BENCHMARK == 1
+	// Start GPIO testing.
+	spiConfigSend(state, DAVIS_CONFIG_DDRAER, DAVIS_CONFIG_DDRAER_RUN, true);
+	setupGPIOTest(handle, ZEROS);
+#endif
+
+	struct timespec noDataSleep = { .tv_sec = 0, .tv_nsec = 100000 };
+
+	// CAER_HOST_CONFIG_THREAD settings are only applied by the GPIO thread:
+	// it is the one that has to keep up with the device, and pinning both
+	// threads to the same CPUs would defeat running them in parallel.
+	while (true) {
+		// Stopped only after the GPIO thread has exited: checked before
+		// looking at the ring, so everything it read is translated.
+		bool running = (atomic_load(&state->gpio.translatorThreadState) == THR_RUNNING);
+
+		size_t spanSize = 0;
+		const uint16_t *span = caerStreamRingBufferPeek(state->gpio.ring, &spanSize);
+
+		if (spanSize == 0) {
+			if (!running) {
+				break;
+			}
+
+			// Sleep for 100µs to avoid busy loop.
+			thrd_sleep(&noDataSleep, NULL);
+			continue;
+		}
+
+		davisRPiDataTranslator(handle, span, spanSize);
+
+		caerStreamRingBufferRelease(state->gpio.ring, spanSize);
+
+#if DAVIS_RPI_BENCHMARK == 1
+		if (!gpioBenchmarkUpdate(handle)) {
+			// Last test done, stop the GPIO thread too.
+			atomic_store(&state->gpio.threadState, THR_EXITED);
+			atomic_store(&state->gpio.translatorThreadState, THR_EXITED);
+			break;
+		}
+#endif
+	}
+
+	davisRPiLog(CAER_LOG_DEBUG, handle, "GPIO translator thread shut down.");
+
+	return (EXIT_SUCCESS);
+}
+
 static bool spiInit(davisRPiState state) {
 	state->gpio.spiFd = open(SPI_DEVICE0_CS0, O_RDWR | O_SYNC);
 	if (state->gpio.spiFd < 0) {
@@ -1042,6 +1159,9 @@ caerDeviceHandle davisRPiOpen(uint16_t deviceID, uint8_t busNumberRestrict, uint
 	// Initialize state variables to default values (if not zero, taken care of by calloc above).
 	dataExchangeSettingsInit(&state->dataExchange);
 
+	// Thread scheduling settings, default to no changes.
+	threadSchedulingSettingsInit(&state->threadScheduling);
+
 	// Packet settings (size (in events) and time interval (in µs)).
 	containerGenerationSettingsInit(&state->container);
 
@@ -1485,6 +1605,10 @@ bool davisRPiConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr,
 			return (containerGenerationConfigSet(&state->container, paramAddr, param));
 			break;
 
+		case CAER_HOST_CONFIG_THREAD:
+			return (threadSchedulingConfigSet(&state->threadScheduling, paramAddr, param));
+			break;
+
 		case CAER_HOST_CONFIG_LOG:
 			switch (paramAddr) {
 				case CAER_HOST_CONFIG_LOG_LEVEL:
@@ -1908,6 +2032,10 @@ bool davisRPiConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr,
 			return (containerGenerationConfigGet(&state->container, paramAddr, param));
 			break;
 
+		case CAER_HOST_CONFIG_THREAD:
+			return (threadSchedulingConfigGet(&state->threadScheduling, paramAddr, param));
+			break;
+
 		case CAER_HOST_CONFIG_LOG:
 			switch (paramAddr) {
 				case CAER_HOST_CONFIG_LOG_LEVEL:
@@ -2373,28 +2501,90 @@ bool davisRPiConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr,
 }
 
 static bool gpioThreadStart(davisRPiHandle handle) {
-	// Start GPIO communication thread.
-	if ((errno = thrd_create(&handle->state.gpio.thread, &gpioThreadRun, handle)) != thrd_success) {
+	davisRPiState state = &handle->state;
+
+	// Translate in a separate thread only if it can run in parallel to the
+	// busy-polling GPIO thread, else it would just take time away from it.
+	state->gpio.ring = NULL;
+	atomic_store(&state->gpio.ringFullCount, 0);
+#if DAVIS_RPI_BENCHMARK == 1
+	atomic_store(&state->benchmark.gpioPause, GPIO_PAUSE_OFF);
+#endif
+
+	if (sysconf(_SC_NPROCESSORS_ONLN) > 1) {
+		state->gpio.ring = caerStreamRingBufferInit(DAVIS_RPI_GPIO_RING_SIZE, sizeof(uint16_t));
+		if (state->gpio.ring == NULL) {
+			davisRPiLog(CAER_LOG_CRITICAL, handle, "Failed to allocate memory for GPIO data ring.");
+			return (false);
+		}
+	}
+
+	// Start GPIO communication thread. Reset its state first, so that we
+	// wait for it also when restarting.
+	atomic_store(&state->gpio.threadState, THR_IDLE);
+
+	if ((errno = thrd_create(&state->gpio.thread, &gpioThreadRun, handle)) != thrd_success) {
 		davisRPiLog(CAER_LOG_CRITICAL, handle, "Failed to create GPIO thread. Error: %d.", errno);
+
+		caerStreamRingBufferFree(state->gpio.ring);
+		state->gpio.ring = NULL;
 		return (false);
 	}
 
-	while (atomic_load(&handle->state.gpio.threadState) == THR_IDLE) {
+	while (atomic_load(&state->gpio.threadState) == THR_IDLE) {
 		thrd_yield();
 	}
 
+	if (state->gpio.ring != NULL) {
+		// Start translator thread, runs until the GPIO thread has stopped
+		// and the ring is empty.
+		atomic_store(&state->gpio.translatorThreadState, THR_RUNNING);
+
+		if ((errno = thrd_create(&state->gpio.translatorThread, &gpioTranslatorThreadRun, handle))
+			!= thrd_success) {
+			davisRPiLog(CAER_LOG_CRITICAL, handle, "Failed to create GPIO translator thread. Error: %d.", errno);
+
+			atomic_store(&state->gpio.threadState, THR_EXITED);
+			atomic_store(&state->gpio.translatorThreadState, THR_EXITED);
+			thrd_join(state->gpio.thread, NULL);
+
+			caerStreamRingBufferFree(state->gpio.ring);
+			state->gpio.ring = NULL;
+			return (false);
+		}
+	}
+
 	return (true);
 }
 
 static void gpioThreadStop(davisRPiHandle handle) {
+	davisRPiState state = &handle->state;
+
 	// Shut down GPIO communication thread.
-	atomic_store(&handle->state.gpio.threadState, THR_EXITED);
+	atomic_store(&state->gpio.threadState, THR_EXITED);
 
 	// Wait for GPIO communication thread to terminate.
-	if ((errno = thrd_join(handle->state.gpio.thread, NULL)) != thrd_success) {
+	if ((errno = thrd_join(state->gpio.thread, NULL)) != thrd_success) {
 		// This should never happen!
 		davisRPiLog(CAER_LOG_CRITICAL, handle, "Failed to join GPIO thread. Error: %d.", errno);
 	}
+
+	if (state->gpio.ring != NULL) {
+		// Nothing is written to the ring anymore: let the translator thread
+		// finish what is left in it, then stop.
+		atomic_store(&state->gpio.translatorThreadState, THR_EXITED);
+
+		if ((errno = thrd_join(state->gpio.translatorThread, NULL)) != thrd_success) {
+			// This should never happen!
+			davisRPiLog(CAER_LOG_CRITICAL, handle, "Failed to join GPIO translator thread. Error: %d.", errno);
+		}
+
+		davisRPiLog(CAER_LOG_DEBUG, handle, "GPIO data ring was full %" PRIu64 " times.",
+			U64T(atomic_load(&state->gpio.ringFullCount)));
+
+		caerStreamRingBufferFree(state->gpio.ring);
+		state->gpio.ring = NULL;
+	}
 }
 
 bool davisRPiDataStart(caerDeviceHandle cdh, void (*dataNotifyIncrease)(void *ptr),
@@ -2601,14 +2791,23 @@ caerEventPacketContainer davisRPiDataGet(caerDeviceHandle cdh) {
 	return (dataExchangeGet(&state->dataExchange, &state->gpio.threadState));
 }
 
+size_t davisRPiDataGetBatch(caerDeviceHandle cdh, caerEventPacketContainer *containers, size_t containersMax,
+	uint32_t timeout) {
+	davisRPiHandle handle = (davisRPiHandle) cdh;
+	davisRPiState state = &handle->state;
+
+	return (dataExchangeGetBatch(&state->dataExchange, &state->gpio.threadState, containers, containersMax, timeout));
+}
+
 #if DAVIS_RPI_BENCHMARK == 1
 
 static void davisRPiDataTranslator(davisRPiHandle handle, const uint16_t *buffer, size_t bufferSize) {
 	davisRPiState state = &handle->state;
 
 	// Return right away if not running anymore. This prevents useless work if many
-	// buffers are still waiting when shut down.
-	if (atomic_load(&state->gpio.threadState) != THR_RUNNING) {
+	// buffers are still waiting when shut down. A translator thread instead
+	// empties the ring on shut-down, it stops by itself once done.
+	if ((state->gpio.ring == NULL) && (atomic_load(&state->gpio.threadState) != THR_RUNNING)) {
 		return;
 	}
 
@@ -2672,6 +2871,7 @@ static void setupGPIOTest(davisRPiHandle handle, enum benchmarkMode mode) {
 	// Reset global variables.
 	state->benchmark.dataCount = 0;
 	state->benchmark.errorCount = 0;
+	state->benchmark.ringFullCount = U64T(atomic_load(&state->gpio.ringFullCount));
 
 	if (mode == ONES) {
 		state->benchmark.expectedValue = 0xFFFF;
@@ -2730,8 +2930,65 @@ static void shutdownGPIOTest(davisRPiHandle handle) {
 
 	double eventsPerSecond = ((double) state->benchmark.dataCount) / diffSecondTime;
 
-	davisRPiLog(CAER_LOG_ERROR, handle, "Test %d: bandwidth of %g events/second (%zu events in %g seconds).",
+	davisRPiLog(CAER_LOG_ERROR, handle, "Test %d: bandwidth of %g words/second (%zu words in %g seconds).",
 		state->benchmark.testMode, eventsPerSecond, state->benchmark.dataCount, diffSecondTime);
+
+	if (state->gpio.ring != NULL) {
+		davisRPiLog(CAER_LOG_ERROR, handle, "Test %d: GPIO data ring was full %" PRIu64 " times.",
+			state->benchmark.testMode, U64T(atomic_load(&state->gpio.ringFullCount)) - state->benchmark.ringFullCount);
+	}
+}
+
+// Go to the next test once enough data was checked. Returns false after the
+// last one, the exceptional shut-down callback has then been called.
+static bool gpioBenchmarkUpdate(davisRPiHandle handle) {
+	davisRPiState state = &handle->state;
+
+	if (state->benchmark.dataCount < DAVIS_RPI_BENCHMARK_LIMIT_EVENTS) {
+		return (true);
+	}
+
+	if (state->gpio.ring != NULL) {
+		// Only the translator thread gets here. Pause the GPIO thread, so
+		// the ring can be emptied below without racing it, and the next
+		// test starts from a clean ring.
+		atomic_store(&state->benchmark.gpioPause, GPIO_PAUSE_REQUESTED);
+
+		while ((atomic_load(&state->benchmark.gpioPause) != GPIO_PAUSE_ACTIVE)
+			   && (atomic_load(&state->gpio.threadState) == THR_RUNNING)) {
+			thrd_yield();
+		}
+	}
+
+	shutdownGPIOTest(handle);
+
+	if (state->benchmark.testMode == ALTERNATING) {
+		// Last test just done.
+		spiConfigSend(state, DAVIS_CONFIG_DDRAER, DAVIS_CONFIG_DDRAER_RUN, false);
+
+		// SPECIAL OUT: call exceptional shut-down callback and exit.
+		if (state->gpio.shutdownCallback != NULL) {
+			state->gpio.shutdownCallback(state->gpio.shutdownCallbackPtr);
+		}
+
+		return (false);
+	}
+
+	if (state->gpio.ring != NULL) {
+		// Drop what the GPIO thread read before pausing, it belongs to the
+		// test just done.
+		size_t spanSize = 0;
+
+		while (caerStreamRingBufferPeek(state->gpio.ring, &spanSize), spanSize > 0) {
+			caerStreamRingBufferRelease(state->gpio.ring, spanSize);
+		}
+	}
+
+	setupGPIOTest(handle, state->benchmark.testMode + 1);
+
+	atomic_store(&state->benchmark.gpioPause, GPIO_PAUSE_OFF);
+
+	return (true);
 }
 
 #else
@@ -2745,7 +3002,9 @@ static void davisRPiDataTranslator(davisRPiHandle handle, const uint16_t *buffer
 	// buffers are still waiting when shut down, as well as incorrect event sequences
 	// if a TS_RESET is stuck on ring-buffer commit further down, and detects shut-down;
 	// then any subsequent buffers should also detect shut-down and not be handled.
-	if (atomic_load(&state->gpio.threadState) != THR_RUNNING) {
+	// A translator thread instead empties the ring on shut-down, it stops by
+	// itself once done; a TS_RESET commit then doesn't wait for the consumer.
+	if ((state->gpio.ring == NULL) && (atomic_load(&state->gpio.threadState) != THR_RUNNING)) {
 		return;
 	}
 
@@ -4,6 +4,7 @@
 #include "devices/davis.h"
 #include "data_exchange.h"
 #include "container_generation.h"
+#include "thread_scheduling.h"
 #include "autoexposure.h"
 
 #define APS_READOUT_TYPES_NUM 2
@@ -44,6 +45,14 @@
 #define DAVIS_RPI_MAX_TRANSACTION_NUM 4096
 #define DAVIS_RPI_MAX_WAIT_REQ_COUNT   100
 
+/**
+ * Size in 16bit words of the ring between the GPIO thread and the
+ * translator thread, must be a power of two. The translator thread
+ * is only used if more than one CPU is online, else the GPIO thread
+ * translates the data itself between reads.
+ */
+#define DAVIS_RPI_GPIO_RING_SIZE (64 * 1024)
+
 /**
  * Support benchmarking the GPIO data exchange performance on RPi,
  * using the appropriate StreamTester logic (MachXO3_IoT).
@@ -53,6 +62,7 @@
 #define DAVIS_RPI_BENCHMARK_LIMIT_EVENTS (4 * 1000 * 1000)
 
 enum benchmarkMode { ZEROS = 0, ONES = 1, COUNTER = 2, SWITCHING = 3, ALTERNATING = 4 };
+enum benchmarkGPIOPause { GPIO_PAUSE_OFF = 0, GPIO_PAUSE_REQUESTED = 1, GPIO_PAUSE_ACTIVE = 2 };
 
 // Alternative, simplified biasing support.
 #define DAVIS_BIAS_ADDRESS_MAX 36
@@ -63,6 +73,8 @@ struct davis_rpi_state {
 	atomic_uint_fast8_t deviceLogLevel;
 	// Data Acquisition Thread -> Mainloop Exchange
 	struct data_exchange dataExchange;
+	// Scheduling of the GPIO thread
+	struct thread_scheduling threadScheduling;
 	// Data transfer via GPIO.
 	struct {
 		volatile uint32_t *gpioReg;
@@ -70,6 +82,11 @@ struct davis_rpi_state {
 		mtx_t spiLock;
 		atomic_uint_fast32_t threadState;
 		thrd_t thread;
+		// Translator thread and its data ring, NULL if not used.
+		caerStreamRingBuffer ring;
+		atomic_uint_fast32_t translatorThreadState;
+		thrd_t translatorThread;
+		atomic_uint_fast64_t ringFullCount;
 		void (*shutdownCallback)(void *shutdownCallbackPtr);
 		void *shutdownCallbackPtr;
 	} gpio;
@@ -79,7 +96,10 @@ struct davis_rpi_state {
 		uint16_t expectedValue;
 		size_t dataCount;
 		size_t errorCount;
+		uint64_t ringFullCount;
 		struct timespec startTime;
+		// Translator thread asks the GPIO thread to pause while switching tests.
+		atomic_uint_fast8_t gpioPause;
 	} benchmark;
 #endif
 	struct {
@@ -203,5 +223,7 @@ bool davisRPiDataStart(caerDeviceHandle handle, void (*dataNotifyIncrease)(void
 	void *dataShutdownUserPtr);
 bool davisRPiDataStop(caerDeviceHandle handle);
 caerEventPacketContainer davisRPiDataGet(caerDeviceHandle handle);
+size_t davisRPiDataGetBatch(caerDeviceHandle handle, caerEventPacketContainer *containers, size_t containersMax,
+	uint32_t timeout);
 
 #endif /* LIBCAER_SRC_DAVIS_RPI_H_ */
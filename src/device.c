@@ -109,6 +109,18 @@ static bool (*configSetters[SUPPORTED_DEVICES_NUMBER])(caerDeviceHandle handle,
 #endif
 };
 
+// Devices without an optimized batch set use the configSetters above.
+static bool (*configBatchSetters[SUPPORTED_DEVICES_NUMBER])(caerDeviceHandle handle,
+	const struct caer_device_config *configs, size_t configsNumber) = {
+		[CAER_DEVICE_DVS128] = NULL,
+		[CAER_DEVICE_DAVIS_FX2] = &davisConfigSetBatch,
+		[CAER_DEVICE_DAVIS_FX3] = &davisConfigSetBatch,
+		[CAER_DEVICE_DYNAPSE] = &dynapseConfigSetBatch,
+		[CAER_DEVICE_DAVIS] = &davisConfigSetBatch,
+		[CAER_DEVICE_EDVS] = NULL,
+		[CAER_DEVICE_DAVIS_RPI] = NULL,
+};
+
 static bool (*configGetters[SUPPORTED_DEVICES_NUMBER])(caerDeviceHandle handle, int8_t modAddr, uint8_t paramAddr,
 	uint32_t *param) = {
 		[CAER_DEVICE_DVS128] = &dvs128ConfigGet,
@@ -184,6 +196,25 @@ static caerEventPacketContainer (*dataGetters[SUPPORTED_DEVICES_NUMBER])(caerDev
 #endif
 };
 
+static size_t (*dataBatchGetters[SUPPORTED_DEVICES_NUMBER])(caerDeviceHandle handle,
+	caerEventPacketContainer *containers, size_t containersMax, uint32_t timeout) = {
+		[CAER_DEVICE_DVS128] = &dvs128DataGetBatch,
+		[CAER_DEVICE_DAVIS_FX2] = &davisDataGetBatch,
+		[CAER_DEVICE_DAVIS_FX3] = &davisDataGetBatch,
+		[CAER_DEVICE_DYNAPSE] = &dynapseDataGetBatch,
+		[CAER_DEVICE_DAVIS] = &davisDataGetBatch,
+#if defined(LIBCAER_HAVE_SERIALDEV) && LIBCAER_HAVE_SERIALDEV == 1
+		[CAER_DEVICE_EDVS] = &edvsDataGetBatch,
+#else
+		[CAER_DEVICE_EDVS] = NULL,
+#endif
+#if defined(OS_LINUX)
+		[CAER_DEVICE_DAVIS_RPI] = &davisRPiDataGetBatch,
+#else
+		[CAER_DEVICE_DAVIS_RPI] = NULL,
+#endif
+};
+
 // Add empty InfoGet for optional devices, such as serial ones.
 #if defined(LIBCAER_HAVE_SERIALDEV) && LIBCAER_HAVE_SERIALDEV == 0
 struct caer_edvs_info caerEDVSInfoGet(caerDeviceHandle handle) {
@@ -299,6 +330,35 @@ bool caerDeviceConfigSet(caerDeviceHandle handle, int8_t modAddr, uint8_t paramA
 	return (configSetters[handle->deviceType](handle, modAddr, paramAddr, param));
 }
 
+bool caerDeviceConfigSetBatch(caerDeviceHandle handle, const struct caer_device_config *configs, size_t configsNumber) {
+	// Check if the pointer is valid.
+	if (handle == NULL || (configs == NULL && configsNumber != 0)) {
+		return (false);
+	}
+
+	// Check if device type is supported.
+	if (handle->deviceType >= SUPPORTED_DEVICES_NUMBER) {
+		return (false);
+	}
+
+	// Call appropriate function.
+	if (configSetters[handle->deviceType] == NULL) {
+		return (false);
+	}
+
+	if (configBatchSetters[handle->deviceType] != NULL) {
+		return (configBatchSetters[handle->deviceType](handle, configs, configsNumber));
+	}
+
+	for (size_t i = 0; i < configsNumber; i++) {
+		if (!configSetters[handle->deviceType](handle, configs[i].modAddr, configs[i].paramAddr, configs[i].param)) {
+			return (false);
+		}
+	}
+
+	return (true);
+}
+
 bool caerDeviceConfigGet(caerDeviceHandle handle, int8_t modAddr, uint8_t paramAddr, uint32_t *param) {
 	// Check if the pointer is valid.
 	if (handle == NULL) {
@@ -381,6 +441,26 @@ caerEventPacketContainer caerDeviceDataGet(caerDeviceHandle handle) {
 	return (dataGetters[handle->deviceType](handle));
 }
 
+size_t caerDeviceDataGetBatch(caerDeviceHandle handle, caerEventPacketContainer *containers, size_t containersMax,
+	uint32_t timeout) {
+	// Check if the pointers are valid.
+	if ((handle == NULL) || (containers == NULL)) {
+		return (0);
+	}
+
+	// Check if device type is supported.
+	if (handle->deviceType >= SUPPORTED_DEVICES_NUMBER) {
+		return (0);
+	}
+
+	// Call appropriate function.
+	if (dataBatchGetters[handle->deviceType] == NULL) {
+		return (0);
+	}
+
+	return (dataBatchGetters[handle->deviceType](handle, containers, containersMax, timeout));
+}
+
 bool caerDeviceConfigGet64(caerDeviceHandle handle, int8_t modAddr, uint8_t paramAddr, uint64_t *param) {
 	// Ensure param is zeroed out.
 	*param = 0;
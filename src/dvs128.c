@@ -2,6 +2,8 @@
 
 static void dvs128Log(enum caer_log_level logLevel, dvs128Handle handle, const char *format, ...) ATTRIBUTE_FORMAT(3);
 static void dvs128EventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSent);
+static size_t dvs128PolarityRunLength(dvs128State state, const uint8_t *buffer, size_t wordsNumber);
+static void dvs128PolarityRunTranslate(dvs128Handle handle, const uint8_t *buffer, size_t eventsNumber);
 static bool dvs128SendBiases(dvs128State state);
 
 static void dvs128Log(enum caer_log_level logLevel, dvs128Handle handle, const char *format, ...) {
@@ -203,6 +205,10 @@ bool dvs128ConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, ui
 			return (containerGenerationConfigSet(&state->container, paramAddr, param));
 			break;
 
+		case CAER_HOST_CONFIG_THREAD:
+			return (threadSchedulingConfigSet(&state->usbState.threadScheduling, paramAddr, param));
+			break;
+
 		case CAER_HOST_CONFIG_LOG:
 			switch (paramAddr) {
 				case CAER_HOST_CONFIG_LOG_LEVEL:
@@ -321,6 +327,10 @@ bool dvs128ConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, ui
 			return (containerGenerationConfigGet(&state->container, paramAddr, param));
 			break;
 
+		case CAER_HOST_CONFIG_THREAD:
+			return (threadSchedulingConfigGet(&state->usbState.threadScheduling, paramAddr, param));
+			break;
+
 		case CAER_HOST_CONFIG_LOG:
 			switch (paramAddr) {
 				case CAER_HOST_CONFIG_LOG_LEVEL:
@@ -475,6 +485,15 @@ caerEventPacketContainer dvs128DataGet(caerDeviceHandle cdh) {
 	return (dataExchangeGet(&state->dataExchange, &state->usbState.dataTransfersRun));
 }
 
+size_t dvs128DataGetBatch(caerDeviceHandle cdh, caerEventPacketContainer *containers, size_t containersMax,
+	uint32_t timeout) {
+	dvs128Handle handle = (dvs128Handle) cdh;
+	dvs128State state = &handle->state;
+
+	return (dataExchangeGetBatch(&state->dataExchange, &state->usbState.dataTransfersRun, containers, containersMax,
+		timeout));
+}
+
 #define DVS128_TIMESTAMP_WRAP_MASK 0x80
 #define DVS128_TIMESTAMP_RESET_MASK 0x40
 #define DVS128_POLARITY_SHIFT 0
@@ -486,6 +505,18 @@ caerEventPacketContainer dvs128DataGet(caerDeviceHandle cdh) {
 #define DVS128_SYNC_EVENT_MASK 0x8000
 #define TS_WRAP_ADD 0x4000
 
+// Bits that make a 4-byte word anything else than a plain polarity event:
+// timestamp wrap and reset (bits 15 and 14 of the timestamp), and external
+// sync (bit 15 of the address). As a 32 bit little-endian word.
+#define DVS128_NON_POLARITY_MASK 0xC0008000U
+
+static inline uint32_t dvs128GetWord(const uint8_t *buffer, size_t index) {
+	uint32_t word;
+	memcpy(&word, buffer + (index * 4), sizeof(uint32_t));
+
+	return (le32toh(word));
+}
+
 static void dvs128EventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSent) {
 	dvs128Handle handle = vhd;
 	dvs128State state = &handle->state;
@@ -504,7 +535,7 @@ static void dvs128EventTranslator(void *vhd, const uint8_t *buffer, size_t bytes
 		bytesSent &= ~((size_t) 0x03);
 	}
 
-	for (size_t i = 0; i < bytesSent; i += 4) {
+	for (size_t i = 0; i < bytesSent;) {
 		// Allocate new packets for next iteration as needed.
 		if (!containerGenerationAllocate(&state->container, DVS_EVENT_TYPES)) {
 			dvs128Log(CAER_LOG_CRITICAL, handle, "Failed to allocate event packet container.");
@@ -558,7 +589,36 @@ static void dvs128EventTranslator(void *vhd, const uint8_t *buffer, size_t bytes
 		bool tsReset = false;
 		bool tsBigWrap = false;
 
-		if ((buffer[i + 3] & DVS128_TIMESTAMP_WRAP_MASK) == DVS128_TIMESTAMP_WRAP_MASK) {
+		// Wrap, reset and sync are single words, polarity events come in runs.
+		size_t wordsUsed = 1;
+
+		if ((dvs128GetWord(buffer, i / 4) & DVS128_NON_POLARITY_MASK) == 0) {
+			// Most words are plain polarity events: translate all of them up to
+			// the next special word, or up to the next commit point, in one go.
+			size_t eventsNumber = dvs128PolarityRunLength(state, buffer + i, (bytesSent - i) / 4);
+
+			int32_t polarityNeeded = state->currentPackets.polarityPosition + I32T(eventsNumber);
+
+			if (polarityNeeded
+				> caerEventPacketHeaderGetEventCapacity((caerEventPacketHeader) state->currentPackets.polarity)) {
+				int32_t polarityGrow = state->currentPackets.polarityPosition * 2;
+
+				caerPolarityEventPacket grownPacket = (caerPolarityEventPacket) caerEventPacketGrow(
+					(caerEventPacketHeader) state->currentPackets.polarity,
+					(polarityNeeded > polarityGrow) ? (polarityNeeded) : (polarityGrow));
+				if (grownPacket == NULL) {
+					dvs128Log(CAER_LOG_CRITICAL, handle, "Failed to grow polarity event packet.");
+					return;
+				}
+
+				state->currentPackets.polarity = grownPacket;
+			}
+
+			dvs128PolarityRunTranslate(handle, buffer + i, eventsNumber);
+
+			wordsUsed = eventsNumber;
+		}
+		else if ((buffer[i + 3] & DVS128_TIMESTAMP_WRAP_MASK) == DVS128_TIMESTAMP_WRAP_MASK) {
 			// Detect big timestamp wrap-around.
 			if (state->timestamps.wrapAdd == (INT32_MAX - (TS_WRAP_ADD - 1))) {
 				// Reset wrapAdd to zero at this point, so we can again
@@ -612,11 +672,8 @@ static void dvs128EventTranslator(void *vhd, const uint8_t *buffer, size_t bytes
 			tsReset = true;
 		}
 		else {
-			// address is LSB MSB (USB is LE)
-			uint16_t addressUSB = le16toh(*((const uint16_t *) (&buffer[i])));
-
-			// same for timestamp, LSB MSB (USB is LE)
-			// 15 bit value of timestamp in 1 us tick
+			// Special Trigger Event (MSB of address is set), polarity events are handled above.
+			// Timestamp is LSB MSB (USB is LE), 15 bit value of timestamp in 1 us tick.
 			uint16_t timestampUSB = le16toh(*((const uint16_t *) (&buffer[i + 2])));
 
 			// Expand to 32 bits. (Tick is 1µs already.)
@@ -628,48 +685,13 @@ static void dvs128EventTranslator(void *vhd, const uint8_t *buffer, size_t bytes
 			checkMonotonicTimestamp(state->timestamps.current, state->timestamps.last,
 				handle->info.deviceString, &handle->state.deviceLogLevel);
 
-			if ((addressUSB & DVS128_SYNC_EVENT_MASK) != 0) {
-				// Special Trigger Event (MSB is set)
-				caerSpecialEvent currentEvent = caerSpecialEventPacketGetEvent(state->currentPackets.special,
-					state->currentPackets.specialPosition);
-				state->currentPackets.specialPosition++;
+			caerSpecialEvent currentEvent = caerSpecialEventPacketGetEvent(state->currentPackets.special,
+				state->currentPackets.specialPosition);
+			state->currentPackets.specialPosition++;
 
-				caerSpecialEventSetTimestamp(currentEvent, state->timestamps.current);
-				caerSpecialEventSetType(currentEvent, EXTERNAL_INPUT_RISING_EDGE);
-				caerSpecialEventValidate(currentEvent, state->currentPackets.special);
-			}
-			else {
-				// Invert X values (flip along X axis). To correct for flipped camera.
-				uint16_t x = U16T(
-					(DVS_ARRAY_SIZE_X - 1) - U16T((addressUSB >> DVS128_X_ADDR_SHIFT) & DVS128_X_ADDR_MASK));
-				// Invert Y values (flip along Y axis). To convert to CG format.
-				uint16_t y = U16T(
-					(DVS_ARRAY_SIZE_Y - 1) - U16T((addressUSB >> DVS128_Y_ADDR_SHIFT) & DVS128_Y_ADDR_MASK));
-				// Invert polarity bit. Hardware is like this.
-				bool polarity = ((U16T(addressUSB >> DVS128_POLARITY_SHIFT) & DVS128_POLARITY_MASK) == 0) ? (1) : (0);
-
-				// Check range conformity.
-				if (x >= DVS_ARRAY_SIZE_X) {
-					dvs128Log(CAER_LOG_ALERT, handle, "X address out of range (0-%d): %" PRIu16 ".",
-					DVS_ARRAY_SIZE_X - 1, x);
-					continue; // Skip invalid event.
-				}
-				if (y >= DVS_ARRAY_SIZE_Y) {
-					dvs128Log(CAER_LOG_ALERT, handle, "Y address out of range (0-%d): %" PRIu16 ".",
-					DVS_ARRAY_SIZE_Y - 1, y);
-					continue; // Skip invalid event.
-				}
-
-				caerPolarityEvent currentEvent = caerPolarityEventPacketGetEvent(state->currentPackets.polarity,
-					state->currentPackets.polarityPosition);
-				state->currentPackets.polarityPosition++;
-
-				caerPolarityEventSetTimestamp(currentEvent, state->timestamps.current);
-				caerPolarityEventSetPolarity(currentEvent, polarity);
-				caerPolarityEventSetY(currentEvent, y);
-				caerPolarityEventSetX(currentEvent, x);
-				caerPolarityEventValidate(currentEvent, state->currentPackets.polarity);
-			}
+			caerSpecialEventSetTimestamp(currentEvent, state->timestamps.current);
+			caerSpecialEventSetType(currentEvent, EXTERNAL_INPUT_RISING_EDGE);
+			caerSpecialEventValidate(currentEvent, state->currentPackets.special);
 		}
 
 		// Thresholds on which to trigger packet container commit.
@@ -716,7 +738,140 @@ static void dvs128EventTranslator(void *vhd, const uint8_t *buffer, size_t bytes
 				state->timestamps.current, &state->dataExchange, &state->usbState.dataTransfersRun,
 				handle->info.deviceID, handle->info.deviceString, &handle->state.deviceLogLevel);
 		}
+
+		i += wordsUsed * 4;
+	}
+}
+
+// Number of plain polarity events at the start of the buffer, stopping at the
+// first special word, or at the event that will trigger a container commit
+// (included), since commits must happen right after it.
+static size_t dvs128PolarityRunLength(dvs128State state, const uint8_t *buffer, size_t wordsNumber) {
+	// Size commit: stop once the polarity packet reaches the commit size. If
+	// it already did, the very next event triggers the commit.
+	int32_t commitSize = containerGenerationGetMaxPacketSize(&state->container);
+
+	if (commitSize > 0) {
+		size_t commitRemaining = (commitSize > state->currentPackets.polarityPosition)
+									 ? ((size_t) (commitSize - state->currentPackets.polarityPosition))
+									 : (1);
+
+		if (commitRemaining < wordsNumber) {
+			wordsNumber = commitRemaining;
+		}
 	}
+
+	// Find the next special word, two words at a time.
+	size_t length = 0;
+
+	while ((length + 2) <= wordsNumber) {
+		uint64_t words;
+		memcpy(&words, buffer + (length * 4), sizeof(uint64_t));
+
+		if ((le64toh(words) & ((U64T(DVS128_NON_POLARITY_MASK) << 32) | DVS128_NON_POLARITY_MASK)) != 0) {
+			break;
+		}
+
+		length += 2;
+	}
+
+	while ((length < wordsNumber) && ((dvs128GetWord(buffer, length) & DVS128_NON_POLARITY_MASK) == 0)) {
+		length++;
+	}
+
+	// Time commit: stop at the first event past the commit timestamp. Timestamps
+	// in a run only differ in their lower 14 bits, and are monotonic, so a binary
+	// search can be used. Events were already checked not to be special above.
+	int32_t wrapAdd = state->timestamps.wrapAdd;
+
+	containerGenerationCommitTimestampInit(&state->container, wrapAdd + I32T(dvs128GetWord(buffer, 0) >> 16));
+
+	int64_t commitTimestamp = state->container.currentPacketContainerCommitTimestamp;
+	int32_t wrapOverflow = state->timestamps.wrapOverflow;
+
+	if (generateFullTimestamp(wrapOverflow, wrapAdd + I32T(dvs128GetWord(buffer, length - 1) >> 16))
+		> commitTimestamp) {
+		size_t low = 0;
+		size_t high = length - 1;
+
+		while (low < high) {
+			size_t mid = low + ((high - low) / 2);
+
+			if (generateFullTimestamp(wrapOverflow, wrapAdd + I32T(dvs128GetWord(buffer, mid) >> 16))
+				> commitTimestamp) {
+				high = mid;
+			}
+			else {
+				low = mid + 1;
+			}
+		}
+
+		length = low + 1;
+	}
+
+	return (length);
+}
+
+// Translate a run of plain polarity events. There must be enough space in
+// the current polarity packet for all of them.
+static void dvs128PolarityRunTranslate(dvs128Handle handle, const uint8_t *buffer, size_t eventsNumber) {
+	dvs128State state = &handle->state;
+
+	caerPolarityEventPacket packet = state->currentPackets.polarity;
+	caerPolarityEvent events = caerPolarityEventPacketGetEvent(packet, state->currentPackets.polarityPosition);
+
+	int32_t wrapAdd = state->timestamps.wrapAdd;
+
+	// No branches here, so this can be vectorized.
+	for (size_t i = 0; i < eventsNumber; i++) {
+		uint32_t word = dvs128GetWord(buffer, i);
+
+		// Invert X values (flip along X axis). To correct for flipped camera.
+		uint32_t x = (DVS_ARRAY_SIZE_X - 1) - ((word >> DVS128_X_ADDR_SHIFT) & DVS128_X_ADDR_MASK);
+		// Invert Y values (flip along Y axis). To convert to CG format.
+		uint32_t y = (DVS_ARRAY_SIZE_Y - 1) - ((word >> DVS128_Y_ADDR_SHIFT) & DVS128_Y_ADDR_MASK);
+		// Invert polarity bit. Hardware is like this.
+		uint32_t polarity = (~word >> DVS128_POLARITY_SHIFT) & DVS128_POLARITY_MASK;
+
+		// Addresses are 7 bit, so always in range. Timestamp is the upper 16 bits,
+		// expand to 32 bits. (Tick is 1µs already.)
+		events[i].data = htole32((U32T(1) << VALID_MARK_SHIFT) | (polarity << POLARITY_SHIFT)
+			| (y << POLARITY_Y_ADDR_SHIFT) | (x << POLARITY_X_ADDR_SHIFT));
+		events[i].timestamp = htole32(wrapAdd + I32T(word >> 16));
+	}
+
+	// Check monotonicity of timestamps, and log the offending ones if needed.
+	int32_t runLast = state->timestamps.current;
+	bool monotonic = true;
+
+	for (size_t i = 0; i < eventsNumber; i++) {
+		int32_t runCurrent = wrapAdd + I32T(dvs128GetWord(buffer, i) >> 16);
+
+		monotonic &= (runCurrent >= runLast);
+		runLast = runCurrent;
+	}
+
+	if (!monotonic) {
+		runLast = state->timestamps.current;
+
+		for (size_t i = 0; i < eventsNumber; i++) {
+			int32_t runCurrent = wrapAdd + I32T(dvs128GetWord(buffer, i) >> 16);
+
+			checkMonotonicTimestamp(runCurrent, runLast, handle->info.deviceString, &handle->state.deviceLogLevel);
+			runLast = runCurrent;
+		}
+	}
+
+	state->timestamps.last = (eventsNumber > 1) ? (wrapAdd + I32T(dvs128GetWord(buffer, eventsNumber - 2) >> 16))
+												: (state->timestamps.current);
+	state->timestamps.current = wrapAdd + I32T(dvs128GetWord(buffer, eventsNumber - 1) >> 16);
+
+	state->currentPackets.polarityPosition += I32T(eventsNumber);
+
+	caerEventPacketHeaderSetEventNumber(&packet->packetHeader,
+		caerEventPacketHeaderGetEventNumber(&packet->packetHeader) + I32T(eventsNumber));
+	caerEventPacketHeaderSetEventValid(&packet->packetHeader,
+		caerEventPacketHeaderGetEventValid(&packet->packetHeader) + I32T(eventsNumber));
 }
 
 static bool dvs128SendBiases(dvs128State state) {
@@ -92,5 +92,7 @@ bool dvs128DataStart(caerDeviceHandle handle, void (*dataNotifyIncrease)(void *p
 	void *dataShutdownUserPtr);
 bool dvs128DataStop(caerDeviceHandle handle);
 caerEventPacketContainer dvs128DataGet(caerDeviceHandle handle);
+size_t dvs128DataGetBatch(caerDeviceHandle handle, caerEventPacketContainer *containers, size_t containersMax,
+	uint32_t timeout);
 
 #endif /* LIBCAER_SRC_DVS128_H_ */
@@ -3,7 +3,11 @@
 
 static void dynapseLog(enum caer_log_level logLevel, dynapseHandle handle, const char *format, ...) ATTRIBUTE_FORMAT(3);
 static bool sendUSBCommandVerifyMultiple(dynapseHandle handle, uint8_t *config, size_t configNum);
+static bool sendUSBCommandPipelinedMultiple(dynapseHandle handle, const uint32_t *config, size_t configNum);
+static void networkShadowUpdate(dynapseState state, const uint32_t *config, size_t configNum, bool success);
 static void dynapseEventTranslator(void *vdh, const uint8_t *buffer, size_t bytesSent);
+static size_t dynapseSpikeRunLength(dynapseState state, const uint8_t *buffer, size_t wordsNumber);
+static void dynapseSpikeRunTranslate(dynapseState state, const uint8_t *buffer, size_t spikesNumber);
 static void setSilentBiases(caerDeviceHandle cdh, uint8_t chipId);
 static void setLowPowerBiases(caerDeviceHandle cdh, uint8_t chipId);
 
@@ -85,6 +89,37 @@ bool sy, uint8_t dy, uint8_t destinationCore) {
 	return (sramBits);
 }
 
+// The array versions compute the same bits as the functions above, but
+// with simple enough loops that the compiler can vectorize them.
+void caerDynapseGenerateCamBitsArray(const uint16_t *inputNeuronAddr, const uint16_t *neuronAddr, const uint8_t *camId,
+	const uint8_t *synapseType, uint32_t *camBits, size_t number) {
+	for (size_t i = 0; i < number; i++) {
+		uint32_t input = inputNeuronAddr[i];
+		uint32_t neuron = neuronAddr[i];
+
+		camBits[i] = (U32T(synapseType[i] & 0x03) << 28) | ((input & 0xFF) << 20) | (((input >> 8) & 0x03) << 18)
+			| U32T(0x01 << 17) | (((neuron >> 8) & 0x03) << 15) | (((neuron >> 4) & 0x0F) << 11)
+			| (U32T(camId[i] & 0x3F) << 5) | (neuron & 0x0F);
+	}
+}
+
+void caerDynapseGenerateSramBitsArray(const uint16_t *neuronAddr, const uint8_t *sramId, const uint8_t *virtualCoreId,
+	const bool *sx, const uint8_t *dx, const bool *sy, const uint8_t *dy, const uint8_t *destinationCore,
+	uint32_t *sramBits, size_t number) {
+	// Loading bool values prevents vectorization, read them as bytes instead.
+	const uint8_t *sxBytes = (const uint8_t *) sx;
+	const uint8_t *syBytes = (const uint8_t *) sy;
+
+	for (size_t i = 0; i < number; i++) {
+		uint32_t neuron = neuronAddr[i];
+
+		sramBits[i] = (U32T(virtualCoreId[i] & 0x03) << 28) | (U32T(syBytes[i] & 0x01) << 27)
+			| (U32T(dy[i] & 0x03) << 25) | (U32T(sxBytes[i] & 0x01) << 24) | (U32T(dx[i] & 0x03) << 22)
+			| (U32T(destinationCore[i] & 0x0F) << 18) | U32T(0x01 << 17) | (((neuron >> 8) & 0x03) << 15) | ((neuron & 0xFF) << 7)
+			| (U32T(sramId[i] & 0x03) << 5) | U32T(0x01 << 4);
+	}
+}
+
 uint16_t caerDynapseCoreXYToNeuronId(uint8_t coreId, uint8_t columnX, uint8_t rowY) {
 	return (U16T(U16T((coreId & 0x03) << 8) | U16T((rowY & 0x0F) << 4) | U16T((columnX & 0x0F) << 0)));
 }
@@ -168,6 +203,36 @@ struct caer_spike_event caerDynapseSpikeEventFromXY(uint16_t x, uint16_t y) {
 	return (out);
 }
 
+size_t caerDynapseSpikeEventPacketToArrays(caerSpikeEventPacketConst packet, uint32_t *neuronIds,
+	int64_t *timestamps, size_t maxSpikes) {
+	if ((packet == NULL) || (neuronIds == NULL) || (timestamps == NULL)) {
+		return (0);
+	}
+
+	const struct caer_spike_event *events = packet->events;
+	size_t eventsNumber = (size_t) caerEventPacketHeaderGetEventNumber(&packet->packetHeader);
+	int64_t tsOverflow = I64T(U64T(caerEventPacketHeaderGetEventTSOverflow(&packet->packetHeader)) << TS_OVERFLOW_SHIFT);
+
+	size_t spikes = 0;
+
+	// Always write the current event, but only advance the output position
+	// for valid ones, so there is no branch on validity.
+	for (size_t i = 0; (i < eventsNumber) && (spikes < maxSpikes); i++) {
+		uint32_t data = le32toh(events[i].data);
+
+		uint32_t chipId = (data >> SPIKE_CHIP_ID_SHIFT) & SPIKE_CHIP_ID_MASK;
+		uint32_t coreId = (data >> SPIKE_SOURCE_CORE_ID_SHIFT) & SPIKE_SOURCE_CORE_ID_MASK;
+		uint32_t neuronId = (data >> SPIKE_NEURON_ID_SHIFT) & SPIKE_NEURON_ID_MASK;
+
+		neuronIds[spikes] = (chipId * DYNAPSE_CONFIG_NUMNEURONS) + (coreId * DYNAPSE_CONFIG_NUMNEURONS_CORE) + neuronId;
+		timestamps[spikes] = tsOverflow | le32toh(events[i].timestamp);
+
+		spikes += (data >> VALID_MARK_SHIFT) & VALID_MARK_MASK;
+	}
+
+	return (spikes);
+}
+
 static void dynapseLog(enum caer_log_level logLevel, dynapseHandle handle, const char *format, ...) {
 	va_list argumentList;
 	va_start(argumentList, format);
@@ -197,6 +262,141 @@ static bool sendUSBCommandVerifyMultiple(dynapseHandle handle, uint8_t *config,
 	return (true);
 }
 
+struct pipelined_transfers {
+	atomic_uint_fast32_t inFlight;
+	atomic_bool failed;
+};
+
+static void pipelinedTransferCallback(void *transfersPtr, int status) {
+	struct pipelined_transfers *transfers = transfersPtr;
+
+	if (status != LIBUSB_TRANSFER_COMPLETED) {
+		atomic_store(&transfers->failed, true);
+	}
+
+	atomic_fetch_sub(&transfers->inFlight, 1);
+}
+
+// Send chip configuration words with up to SPI_CONFIG_MAX_TRANSFERS USB
+// transfers in flight, instead of waiting for each one to complete and be
+// verified before sending the next. The USB control endpoint processes
+// them in order, and the device is asked for its status only at the end.
+static bool sendUSBCommandPipelinedMultiple(dynapseHandle handle, const uint32_t *config, size_t configNum) {
+	dynapseState state = &handle->state;
+
+	if (configNum == 0) {
+		return (true);
+	}
+
+	struct pipelined_transfers transfers = { ATOMIC_VAR_INIT(0), ATOMIC_VAR_INIT(false) };
+
+	const uint32_t *configStart = config;
+	size_t configStartNum = configNum;
+
+	// The data is copied by the USB layer on submit, so one buffer is enough.
+	uint8_t spiMultiConfig[SPI_CONFIG_MAX * SPI_CONFIG_MSG_SIZE];
+
+	struct timespec waitForCompletionSleep = { .tv_sec = 0, .tv_nsec = 100000 };
+
+	while ((configNum > 0) && !atomic_load(&transfers.failed)) {
+		size_t chunkNum = (configNum > SPI_CONFIG_MAX) ? (SPI_CONFIG_MAX) : (configNum);
+
+		for (size_t i = 0; i < chunkNum; i++) {
+			spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 0] = DYNAPSE_CONFIG_CHIP;
+			spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 1] = DYNAPSE_CONFIG_CHIP_CONTENT;
+			spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 2] = U8T((config[i] >> 24) & 0x0FF);
+			spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 3] = U8T((config[i] >> 16) & 0x0FF);
+			spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 4] = U8T((config[i] >> 8) & 0x0FF);
+			spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 5] = U8T((config[i] >> 0) & 0x0FF);
+		}
+
+		// Wait for a free slot.
+		while (atomic_load(&transfers.inFlight) >= SPI_CONFIG_MAX_TRANSFERS) {
+			// Sleep for 100µs to avoid busy loop.
+			thrd_sleep(&waitForCompletionSleep, NULL);
+		}
+
+		atomic_fetch_add(&transfers.inFlight, 1);
+
+		if (!usbControlTransferOutAsync(&state->usbState, VENDOR_REQUEST_FPGA_CONFIG_AER_MULTIPLE, U16T(chunkNum), 0,
+			spiMultiConfig, chunkNum * SPI_CONFIG_MSG_SIZE, &pipelinedTransferCallback, &transfers)) {
+			atomic_fetch_sub(&transfers.inFlight, 1);
+			atomic_store(&transfers.failed, true);
+			break;
+		}
+
+		config += chunkNum;
+		configNum -= chunkNum;
+	}
+
+	// Always wait for all transfers to complete, they reference local memory.
+	while (atomic_load(&transfers.inFlight) > 0) {
+		// Sleep for 100µs to avoid busy loop.
+		thrd_sleep(&waitForCompletionSleep, NULL);
+	}
+
+	if (atomic_load(&transfers.failed)) {
+		dynapseLog(CAER_LOG_CRITICAL, handle, "Failed to send chip config, USB transfer failed.");
+		networkShadowUpdate(state, configStart, configStartNum, false);
+		return (false);
+	}
+
+	uint8_t check[2] = { 0 };
+	bool result = usbControlTransferIn(&state->usbState, VENDOR_REQUEST_FPGA_CONFIG_AER_MULTIPLE, 0, 0, check,
+		sizeof(check));
+	if ((!result) || (check[0] != VENDOR_REQUEST_FPGA_CONFIG_AER_MULTIPLE) || (check[1] != 0)) {
+		dynapseLog(CAER_LOG_CRITICAL, handle, "Failed to send chip config, USB transfer failed on verification.");
+		networkShadowUpdate(state, configStart, configStartNum, false);
+		return (false);
+	}
+
+	networkShadowUpdate(state, configStart, configStartNum, true);
+
+	return (true);
+}
+
+// CAM and SRAM words both have bit 17 set (biases and monitor commands don't),
+// and are told apart by bit 4, which is always set for SRAM and clear for CAM.
+#define CHIP_CONTENT_MEMORY_BIT U32T(0x01 << 17)
+#define CHIP_CONTENT_SRAM_BIT U32T(0x01 << 4)
+
+static inline size_t networkShadowCamIndex(uint32_t camBits) {
+	size_t neuronAddr = (((camBits >> 15) & 0x03) << 8) | (((camBits >> 11) & 0x0F) << 4) | (camBits & 0x0F);
+	size_t camId = (camBits >> 5) & 0x3F;
+
+	return ((neuronAddr * DYNAPSE_CONFIG_NUMCAM_NEU) + camId);
+}
+
+static inline size_t networkShadowSramIndex(uint32_t sramBits) {
+	size_t neuronAddr = (((sramBits >> 15) & 0x03) << 8) | ((sramBits >> 7) & 0xFF);
+	size_t sramId = (sramBits >> 5) & 0x03;
+
+	return ((neuronAddr * DYNAPSE_CONFIG_NUMSRAM_NEU) + sramId);
+}
+
+// Record chip content words sent to the selected chip. If sending failed,
+// the affected entries are in an unknown state afterwards.
+static void networkShadowUpdate(dynapseState state, const uint32_t *config, size_t configNum, bool success) {
+	uint8_t chipId = state->networkShadow.chipId;
+
+	if (chipId >= DYNAPSE_X4BOARD_NUMCHIPS) {
+		return;
+	}
+
+	for (size_t i = 0; i < configNum; i++) {
+		if ((config[i] & CHIP_CONTENT_MEMORY_BIT) == 0) {
+			continue;
+		}
+
+		if ((config[i] & CHIP_CONTENT_SRAM_BIT) != 0) {
+			state->networkShadow.sram[chipId][networkShadowSramIndex(config[i])] = (success) ? (config[i]) : (0);
+		}
+		else {
+			state->networkShadow.cam[chipId][networkShadowCamIndex(config[i])] = (success) ? (config[i]) : (0);
+		}
+	}
+}
+
 static inline void freeAllDataMemory(dynapseState state) {
 	dataExchangeDestroy(&state->dataExchange);
 
@@ -239,6 +439,9 @@ caerDeviceHandle dynapseOpen(uint16_t deviceID, uint8_t busNumberRestrict, uint8
 	// Initialize state variables to default values (if not zero, taken care of by calloc above).
 	dataExchangeSettingsInit(&state->dataExchange);
 
+	// No chip selected for CAM/SRAM writes yet.
+	state->networkShadow.chipId = DYNAPSE_X4BOARD_NUMCHIPS;
+
 	// Packet settings (size (in events) and time interval (in µs)).
 	containerGenerationSettingsInit(&state->container);
 
@@ -704,6 +907,10 @@ bool dynapseConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, u
 			return (containerGenerationConfigSet(&state->container, paramAddr, param));
 			break;
 
+		case CAER_HOST_CONFIG_THREAD:
+			return (threadSchedulingConfigSet(&state->usbState.threadScheduling, paramAddr, param));
+			break;
+
 		case CAER_HOST_CONFIG_LOG:
 			switch (paramAddr) {
 				case CAER_HOST_CONFIG_LOG_LEVEL:
@@ -784,10 +991,17 @@ bool dynapseConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, u
 					return (spiConfigSend(&state->usbState, DYNAPSE_CONFIG_CHIP, paramAddr, param));
 					break;
 
-				case DYNAPSE_CONFIG_CHIP_ID:
-					return (spiConfigSend(&state->usbState, DYNAPSE_CONFIG_CHIP, paramAddr,
-						translateChipIdHostToDevice(U8T(param))));
+				case DYNAPSE_CONFIG_CHIP_ID: {
+					bool success = spiConfigSend(&state->usbState, DYNAPSE_CONFIG_CHIP, paramAddr,
+						translateChipIdHostToDevice(U8T(param)));
+
+					// Remember target chip of CAM/SRAM writes for the shadow copy.
+					state->networkShadow.chipId = (success && (param < DYNAPSE_X4BOARD_NUMCHIPS)) ? (U8T(param)) :
+						(DYNAPSE_X4BOARD_NUMCHIPS);
+
+					return (success);
 					break;
+				}
 
 				case DYNAPSE_CONFIG_CHIP_CONTENT: {
 					uint8_t chipConfig[SPI_CONFIG_MSG_SIZE] = { 0 };
@@ -801,7 +1015,11 @@ bool dynapseConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, u
 
 					// We use this function here instead of spiConfigSend() because
 					// we also need to verify that the AER transaction succeeded!
-					return (sendUSBCommandVerifyMultiple(handle, chipConfig, 1));
+					bool success = sendUSBCommandVerifyMultiple(handle, chipConfig, 1);
+
+					networkShadowUpdate(state, &param, 1, success);
+
+					return (success);
 					break;
 				}
 
@@ -1032,6 +1250,29 @@ bool dynapseConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, u
 	return (true);
 }
 
+bool dynapseConfigSetBatch(caerDeviceHandle cdh, const struct caer_device_config *configs, size_t configsNumber) {
+	dynapseHandle handle = (dynapseHandle) cdh;
+	dynapseState state = &handle->state;
+
+	// Device-side parameters are queued and sent together in multi-config
+	// requests, see spiConfigBatchBegin().
+	spiConfigBatchBegin(&state->usbState);
+
+	bool success = true;
+
+	for (size_t i = 0; (i < configsNumber) && success; i++) {
+		success = dynapseConfigSet(cdh, configs[i].modAddr, configs[i].paramAddr, configs[i].param);
+	}
+
+	// Always end the batch, to send out and wait on what was already queued.
+	if (!spiConfigBatchEnd(&state->usbState)) {
+		dynapseLog(CAER_LOG_ERROR, handle, "Failed to send batch of configuration parameters.");
+		success = false;
+	}
+
+	return (success);
+}
+
 bool dynapseConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uint32_t *param) {
 	dynapseHandle handle = (dynapseHandle) cdh;
 	dynapseState state = &handle->state;
@@ -1049,6 +1290,10 @@ bool dynapseConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, u
 			return (containerGenerationConfigGet(&state->container, paramAddr, param));
 			break;
 
+		case CAER_HOST_CONFIG_THREAD:
+			return (threadSchedulingConfigGet(&state->usbState.threadScheduling, paramAddr, param));
+			break;
+
 		case CAER_HOST_CONFIG_LOG:
 			switch (paramAddr) {
 				case CAER_HOST_CONFIG_LOG_LEVEL:
@@ -1067,7 +1312,7 @@ bool dynapseConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, u
 				case DYNAPSE_CONFIG_MUX_TIMESTAMP_RUN:
 				case DYNAPSE_CONFIG_MUX_FORCE_CHIP_BIAS_ENABLE:
 				case DYNAPSE_CONFIG_MUX_DROP_AER_ON_TRANSFER_STALL:
-					return (spiConfigReceive(&state->usbState, DYNAPSE_CONFIG_MUX, paramAddr, param));
+					return (spiConfigReceiveCached(&state->usbState, DYNAPSE_CONFIG_MUX, paramAddr, param));
 					break;
 
 				case DYNAPSE_CONFIG_MUX_TIMESTAMP_RESET:
@@ -1098,7 +1343,7 @@ bool dynapseConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, u
 				case DYNAPSE_CONFIG_AER_ACK_EXTENSION:
 				case DYNAPSE_CONFIG_AER_WAIT_ON_TRANSFER_STALL:
 				case DYNAPSE_CONFIG_AER_EXTERNAL_AER_CONTROL:
-					return (spiConfigReceive(&state->usbState, DYNAPSE_CONFIG_AER, paramAddr, param));
+					return (spiConfigReceiveCached(&state->usbState, DYNAPSE_CONFIG_AER, paramAddr, param));
 					break;
 
 				case DYNAPSE_CONFIG_AER_STATISTICS_EVENTS:
@@ -1130,7 +1375,7 @@ bool dynapseConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, u
 
 				case DYNAPSE_CONFIG_CHIP_ID: {
 					uint32_t chipIdValue;
-					if (!spiConfigReceive(&state->usbState, DYNAPSE_CONFIG_CHIP, paramAddr, &chipIdValue)) {
+					if (!spiConfigReceiveCached(&state->usbState, DYNAPSE_CONFIG_CHIP, paramAddr, &chipIdValue)) {
 						return (false);
 					}
 
@@ -1164,14 +1409,14 @@ bool dynapseConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, u
 		case DYNAPSE_CONFIG_USB:
 			switch (paramAddr) {
 				case DYNAPSE_CONFIG_USB_RUN:
-					return (spiConfigReceive(&state->usbState, DYNAPSE_CONFIG_USB, paramAddr, param));
+					return (spiConfigReceiveCached(&state->usbState, DYNAPSE_CONFIG_USB, paramAddr, param));
 					break;
 
 				case DYNAPSE_CONFIG_USB_EARLY_PACKET_DELAY: {
 					// Early packet delay is 125µs slices on host, but in cycles
 					// @ USB_CLOCK_FREQ on FPGA, so we must divide here.
 					uint32_t cyclesValue = 0;
-					if (!spiConfigReceive(&state->usbState, DYNAPSE_CONFIG_USB, paramAddr, &cyclesValue)) {
+					if (!spiConfigReceiveCached(&state->usbState, DYNAPSE_CONFIG_USB, paramAddr, &cyclesValue)) {
 						return (false);
 					}
 
@@ -1333,8 +1578,32 @@ caerEventPacketContainer dynapseDataGet(caerDeviceHandle cdh) {
 	return (dataExchangeGet(&state->dataExchange, &state->usbState.dataTransfersRun));
 }
 
+size_t dynapseDataGetBatch(caerDeviceHandle cdh, caerEventPacketContainer *containers, size_t containersMax,
+	uint32_t timeout) {
+	dynapseHandle handle = (dynapseHandle) cdh;
+	dynapseState state = &handle->state;
+
+	return (dataExchangeGetBatch(&state->dataExchange, &state->usbState.dataTransfersRun, containers, containersMax,
+		timeout));
+}
+
 #define TS_WRAP_ADD 0x8000
 
+// Spike words have the timestamp bit (15) clear, and one of the codes 1, 2, 5
+// or 6 (bits 12-14), which encode the source core ID. Bit N set means code N.
+#define DYNAPSE_SPIKE_CODES 0x66
+
+static inline uint16_t dynapseGetWord(const uint8_t *buffer, size_t index) {
+	uint16_t word;
+	memcpy(&word, buffer + (index * 2), sizeof(uint16_t));
+
+	return (le16toh(word));
+}
+
+static inline bool dynapseIsSpikeWord(uint16_t word) {
+	return (((word & 0x8000) == 0) && (((DYNAPSE_SPIKE_CODES >> ((word >> 12) & 0x07)) & 0x01) != 0));
+}
+
 static void dynapseEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSent) {
 	dynapseHandle handle = vhd;
 	dynapseState state = &handle->state;
@@ -1353,7 +1622,7 @@ static void dynapseEventTranslator(void *vhd, const uint8_t *buffer, size_t byte
 		bytesSent &= ~((size_t) 0x01);
 	}
 
-	for (size_t i = 0; i < bytesSent; i += 2) {
+	for (size_t i = 0; i < bytesSent;) {
 		// Allocate new packets for next iteration as needed.
 		if (!containerGenerationAllocate(&state->container, DYNAPSE_EVENT_TYPES)) {
 			dynapseLog(CAER_LOG_CRITICAL, handle, "Failed to allocate event packet container.");
@@ -1368,19 +1637,6 @@ static void dynapseEventTranslator(void *vhd, const uint8_t *buffer, size_t byte
 				return;
 			}
 		}
-		else if (state->currentPackets.spikePosition
-			>= caerEventPacketHeaderGetEventCapacity((caerEventPacketHeader) state->currentPackets.spike)) {
-			// If not committed, let's check if any of the packets has reached its maximum
-			// capacity limit. If yes, we grow them to accomodate new events.
-			caerSpikeEventPacket grownPacket = (caerSpikeEventPacket) caerEventPacketGrow(
-				(caerEventPacketHeader) state->currentPackets.spike, state->currentPackets.spikePosition * 2);
-			if (grownPacket == NULL) {
-				dynapseLog(CAER_LOG_CRITICAL, handle, "Failed to grow spike event packet.");
-				return;
-			}
-
-			state->currentPackets.spike = grownPacket;
-		}
 
 		if (state->currentPackets.special == NULL) {
 			state->currentPackets.special = caerSpecialEventPacketAllocate(
@@ -1407,10 +1663,43 @@ static void dynapseEventTranslator(void *vhd, const uint8_t *buffer, size_t byte
 		bool tsReset = false;
 		bool tsBigWrap = false;
 
-		uint16_t event = le16toh(*((const uint16_t *) (&buffer[i])));
+		// Timestamps and special events are single words, spikes come in runs.
+		size_t wordsUsed = 1;
+
+		uint16_t event = dynapseGetWord(buffer, i / 2);
+
+		if (dynapseIsSpikeWord(event)) {
+			// AER addresses of Spikes. All spikes up to the next timestamp share
+			// the same timestamp, so translate all of them in one go.
+			size_t spikesNumber = dynapseSpikeRunLength(state, buffer + i, (bytesSent - i) / 2);
+
+			// Unsigned, so the compiler need not assume anything about signed overflow.
+			size_t spikeNeeded = (size_t) state->currentPackets.spikePosition + spikesNumber;
+
+			if (spikeNeeded > (size_t) caerEventPacketHeaderGetEventCapacity(
+								  (caerEventPacketHeader) state->currentPackets.spike)) {
+				// Reserve space for all the words left in this buffer at once, so
+				// that the packet is grown at most once per buffer.
+				int32_t spikeReserve = state->currentPackets.spikePosition + I32T((bytesSent - i) / 2);
+				int32_t spikeGrow = state->currentPackets.spikePosition * 2;
+
+				caerSpikeEventPacket grownPacket = (caerSpikeEventPacket) caerEventPacketGrow(
+					(caerEventPacketHeader) state->currentPackets.spike,
+					(spikeReserve > spikeGrow) ? (spikeReserve) : (spikeGrow));
+				if (grownPacket == NULL) {
+					dynapseLog(CAER_LOG_CRITICAL, handle, "Failed to grow spike event packet.");
+					return;
+				}
+
+				state->currentPackets.spike = grownPacket;
+			}
+
+			dynapseSpikeRunTranslate(state, buffer + i, spikesNumber);
 
-		// Check if timestamp.
-		if ((event & 0x8000) != 0) {
+			wordsUsed = spikesNumber;
+		}
+		else if ((event & 0x8000) != 0) {
+			// Timestamp.
 			handleTimestampUpdateNewLogic(&state->timestamps, event, handle->info.deviceString, &state->deviceLogLevel);
 
 			containerGenerationCommitTimestampInit(&state->container, state->timestamps.current);
@@ -1447,46 +1736,6 @@ static void dynapseEventTranslator(void *vhd, const uint8_t *buffer, size_t byte
 					}
 					break;
 
-				case 1: // AER addresses of Spikes.
-				case 2: // Special encoding over 4 cases.
-				case 5:
-				case 6: {
-					uint8_t sourceCoreID = 0; // code == 1
-
-					if (code == 2) {
-						sourceCoreID = 1;
-					}
-					else if (code == 5) {
-						sourceCoreID = 2;
-					}
-					else if (code == 6) {
-						sourceCoreID = 3;
-					}
-
-					uint8_t chipID = data & 0x0F;
-
-					// On output via SRAM routing->FPGA->USB, the chip ID for
-					// chip 0 is set to 1, and thus the others are shifted by
-					// one up too. So we reverse that here.
-					// See DYNAPSE_CONFIG_DEFAULT_SRAM for more details.
-					chipID = U8T(chipID - DYNAPSE_CHIPID_SHIFT);
-
-					uint32_t neuronID = U16T(data >> 4) & 0x00FF;
-
-					caerSpikeEvent currentSpikeEvent = caerSpikeEventPacketGetEvent(state->currentPackets.spike,
-						state->currentPackets.spikePosition);
-
-					// Timestamp at event-stream insertion point.
-					caerSpikeEventSetTimestamp(currentSpikeEvent, state->timestamps.current);
-					caerSpikeEventSetSourceCoreID(currentSpikeEvent, sourceCoreID);
-					caerSpikeEventSetChipID(currentSpikeEvent, chipID);
-					caerSpikeEventSetNeuronID(currentSpikeEvent, neuronID);
-					caerSpikeEventValidate(currentSpikeEvent, state->currentPackets.spike);
-					state->currentPackets.spikePosition++;
-
-					break;
-				}
-
 				case 7: { // Timestamp wrap
 					tsBigWrap = handleTimestampWrapNewLogic(&state->timestamps, data, TS_WRAP_ADD,
 						handle->info.deviceString, &state->deviceLogLevel);
@@ -1552,9 +1801,76 @@ static void dynapseEventTranslator(void *vhd, const uint8_t *buffer, size_t byte
 				state->timestamps.current, &state->dataExchange, &state->usbState.dataTransfersRun,
 				handle->info.deviceID, handle->info.deviceString, &state->deviceLogLevel);
 		}
+
+		i += wordsUsed * 2;
 	}
 }
 
+// Number of spike words at the start of the buffer, stopping at the first
+// other word, or at the spike that reaches the container size limit. The
+// time limit can't be reached, since the timestamp doesn't change.
+static size_t dynapseSpikeRunLength(dynapseState state, const uint8_t *buffer, size_t wordsNumber) {
+	// If the packet already reached the commit size, the very next spike
+	// triggers the commit.
+	int32_t commitSize = containerGenerationGetMaxPacketSize(&state->container);
+
+	if (commitSize > 0) {
+		size_t commitRemaining = (commitSize > state->currentPackets.spikePosition)
+									 ? ((size_t) (commitSize - state->currentPackets.spikePosition))
+									 : (1);
+
+		if (commitRemaining < wordsNumber) {
+			wordsNumber = commitRemaining;
+		}
+	}
+
+	size_t length = 1;
+
+	while ((length < wordsNumber) && dynapseIsSpikeWord(dynapseGetWord(buffer, length))) {
+		length++;
+	}
+
+	return (length);
+}
+
+// Translate a run of spike words. There must be enough space in the current
+// spike packet for all of them.
+static void dynapseSpikeRunTranslate(dynapseState state, const uint8_t *buffer, size_t spikesNumber) {
+	caerSpikeEventPacket packet = state->currentPackets.spike;
+	caerSpikeEvent events = caerSpikeEventPacketGetEvent(packet, state->currentPackets.spikePosition);
+
+	// Timestamp at event-stream insertion point.
+	int32_t timestamp = htole32(state->timestamps.current);
+
+	// No branches here, so this can be vectorized.
+	for (size_t i = 0; i < spikesNumber; i++) {
+		uint32_t word = dynapseGetWord(buffer, i);
+
+		// Codes 1, 2, 5 and 6 encode source core IDs 0, 1, 2 and 3.
+		uint32_t code = (word >> 12) & 0x07;
+		uint32_t sourceCoreID = (code & 0x03) - 1 + ((code & 0x04) >> 1);
+
+		// On output via SRAM routing->FPGA->USB, the chip ID for
+		// chip 0 is set to 1, and thus the others are shifted by
+		// one up too. So we reverse that here.
+		// See DYNAPSE_CONFIG_DEFAULT_SRAM for more details.
+		uint32_t chipID = ((word & 0x0F) - DYNAPSE_CHIPID_SHIFT) & SPIKE_CHIP_ID_MASK;
+
+		uint32_t neuronID = (word >> 4) & 0x00FF;
+
+		events[i].data = htole32((U32T(1) << VALID_MARK_SHIFT) | (sourceCoreID << SPIKE_SOURCE_CORE_ID_SHIFT)
+			| (chipID << SPIKE_CHIP_ID_SHIFT) | (neuronID << SPIKE_NEURON_ID_SHIFT));
+		events[i].timestamp = timestamp;
+	}
+
+	state->currentPackets.spikePosition += I32T(spikesNumber);
+
+	caerEventPacketHeaderSetEventNumber(&packet->packetHeader,
+		caerEventPacketHeaderGetEventNumber(&packet->packetHeader) + I32T(spikesNumber));
+	caerEventPacketHeaderSetEventValid(&packet->packetHeader,
+		caerEventPacketHeaderGetEventValid(&packet->packetHeader) + I32T(spikesNumber));
+}
+
 bool caerDynapseSendDataToUSB(caerDeviceHandle cdh, const uint32_t *pointer, size_t numConfig) {
 	dynapseHandle handle = (dynapseHandle) cdh;
 
@@ -1568,38 +1884,144 @@ bool caerDynapseSendDataToUSB(caerDeviceHandle cdh, const uint32_t *pointer, siz
 		return (false);
 	}
 
-	// Allocate memory for configuration parameters.
-	uint8_t *spiMultiConfig = calloc(numConfig, SPI_CONFIG_MSG_SIZE);
-	if (spiMultiConfig == NULL) {
+	return (sendUSBCommandPipelinedMultiple(handle, pointer, numConfig));
+}
+
+bool caerDynapseWriteNetwork(caerDeviceHandle cdh, const struct caer_dynapse_cam_entry *camEntries,
+	size_t camEntriesNumber, const struct caer_dynapse_sram_entry *sramEntries, size_t sramEntriesNumber) {
+	dynapseHandle handle = (dynapseHandle) cdh;
+
+	// Check if the pointer is valid.
+	if (handle == NULL) {
 		return (false);
 	}
 
-	for (size_t i = 0; i < numConfig; i++) {
-		spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 0] = DYNAPSE_CONFIG_CHIP;
-		spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 1] = DYNAPSE_CONFIG_CHIP_CONTENT;
-		spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 2] = U8T((pointer[i] >> 24) & 0x0FF);
-		spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 3] = U8T((pointer[i] >> 16) & 0x0FF);
-		spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 4] = U8T((pointer[i] >> 8) & 0x0FF);
-		spiMultiConfig[(i * SPI_CONFIG_MSG_SIZE) + 5] = U8T((pointer[i] >> 0) & 0x0FF);
+	// Check if device type is supported.
+	if (handle->deviceType != CAER_DEVICE_DYNAPSE) {
+		return (false);
 	}
 
-	size_t idxConfig = 0;
+	if (((camEntries == NULL) && (camEntriesNumber > 0)) || ((sramEntries == NULL) && (sramEntriesNumber > 0))) {
+		return (false);
+	}
 
-	while (numConfig > 0) {
-		size_t configNum = (numConfig > SPI_CONFIG_MAX) ? (SPI_CONFIG_MAX) : (numConfig);
-		size_t configSize = configNum * SPI_CONFIG_MSG_SIZE;
+	size_t configNum = camEntriesNumber + sramEntriesNumber;
 
-		if (!sendUSBCommandVerifyMultiple(handle, spiMultiConfig + idxConfig, configNum)) {
-			free(spiMultiConfig);
-			return (false);
+	if (configNum == 0) {
+		return (true);
+	}
+
+	uint32_t *networkConfig = malloc(configNum * sizeof(uint32_t));
+	if (networkConfig == NULL) {
+		dynapseLog(CAER_LOG_CRITICAL, handle, "Failed to allocate memory for network configuration.");
+		return (false);
+	}
+
+	for (size_t i = 0; i < camEntriesNumber; i++) {
+		networkConfig[i] = caerDynapseGenerateCamBits(camEntries[i].inputNeuronAddr, camEntries[i].neuronAddr,
+			camEntries[i].camId, camEntries[i].synapseType);
+	}
+
+	for (size_t i = 0; i < sramEntriesNumber; i++) {
+		networkConfig[camEntriesNumber + i] = caerDynapseGenerateSramBits(sramEntries[i].neuronAddr,
+			sramEntries[i].sramId, sramEntries[i].virtualCoreId, sramEntries[i].sx, sramEntries[i].dx,
+			sramEntries[i].sy, sramEntries[i].dy, sramEntries[i].destinationCore);
+	}
+
+	bool success = sendUSBCommandPipelinedMultiple(handle, networkConfig, configNum);
+
+	free(networkConfig);
+	return (success);
+}
+
+bool caerDynapseApplyNetwork(caerDeviceHandle cdh, const struct caer_dynapse_cam_entry *camEntries,
+	size_t camEntriesNumber, const struct caer_dynapse_sram_entry *sramEntries, size_t sramEntriesNumber) {
+	dynapseHandle handle = (dynapseHandle) cdh;
+
+	// Check if the pointer is valid.
+	if (handle == NULL) {
+		return (false);
+	}
+
+	// Check if device type is supported.
+	if (handle->deviceType != CAER_DEVICE_DYNAPSE) {
+		return (false);
+	}
+
+	if (((camEntries == NULL) && (camEntriesNumber > 0)) || ((sramEntries == NULL) && (sramEntriesNumber > 0))) {
+		return (false);
+	}
+
+	dynapseState state = &handle->state;
+
+	uint8_t chipId = state->networkShadow.chipId;
+
+	if (chipId >= DYNAPSE_X4BOARD_NUMCHIPS) {
+		dynapseLog(CAER_LOG_ERROR, handle, "Failed to apply network, no chip selected.");
+		return (false);
+	}
+
+	size_t camNumber = DYNAPSE_CONFIG_NUMNEURONS * DYNAPSE_CONFIG_NUMCAM_NEU;
+	size_t sramNumber = DYNAPSE_CONFIG_NUMNEURONS * DYNAPSE_CONFIG_NUMSRAM_NEU;
+
+	uint32_t *networkConfig = malloc((camNumber + sramNumber) * sizeof(uint32_t));
+	if (networkConfig == NULL) {
+		dynapseLog(CAER_LOG_CRITICAL, handle, "Failed to allocate memory for network configuration.");
+		return (false);
+	}
+
+	uint32_t *camConfig = networkConfig;
+	uint32_t *sramConfig = networkConfig + camNumber;
+
+	// Everything not in the tables is cleared, like DYNAPSE_CONFIG_CLEAR_CAM
+	// and DYNAPSE_CONFIG_DEFAULT_SRAM_EMPTY do.
+	for (uint16_t neuronId = 0; neuronId < DYNAPSE_CONFIG_NUMNEURONS; neuronId++) {
+		for (uint8_t camId = 0; camId < DYNAPSE_CONFIG_NUMCAM_NEU; camId++) {
+			camConfig[(neuronId * DYNAPSE_CONFIG_NUMCAM_NEU) + camId] = caerDynapseGenerateCamBits(0, neuronId, camId,
+				0);
 		}
 
-		numConfig -= configNum;
-		idxConfig += configSize;
+		for (uint8_t sramId = 0; sramId < DYNAPSE_CONFIG_NUMSRAM_NEU; sramId++) {
+			sramConfig[(neuronId * DYNAPSE_CONFIG_NUMSRAM_NEU) + sramId] = caerDynapseGenerateSramBits(neuronId, sramId,
+				0, 0, 0, 0, 0, 0);
+		}
 	}
 
-	free(spiMultiConfig);
-	return (true);
+	for (size_t i = 0; i < camEntriesNumber; i++) {
+		uint32_t camBits = caerDynapseGenerateCamBits(camEntries[i].inputNeuronAddr, camEntries[i].neuronAddr,
+			camEntries[i].camId, camEntries[i].synapseType);
+
+		camConfig[networkShadowCamIndex(camBits)] = camBits;
+	}
+
+	for (size_t i = 0; i < sramEntriesNumber; i++) {
+		uint32_t sramBits = caerDynapseGenerateSramBits(sramEntries[i].neuronAddr, sramEntries[i].sramId,
+			sramEntries[i].virtualCoreId, sramEntries[i].sx, sramEntries[i].dx, sramEntries[i].sy, sramEntries[i].dy,
+			sramEntries[i].destinationCore);
+
+		sramConfig[networkShadowSramIndex(sramBits)] = sramBits;
+	}
+
+	// Keep only what differs from the shadow copy, compacting in place.
+	size_t configNum = 0;
+
+	for (size_t i = 0; i < camNumber; i++) {
+		networkConfig[configNum] = camConfig[i];
+		configNum += (camConfig[i] != state->networkShadow.cam[chipId][i]);
+	}
+
+	for (size_t i = 0; i < sramNumber; i++) {
+		networkConfig[configNum] = sramConfig[i];
+		configNum += (sramConfig[i] != state->networkShadow.sram[chipId][i]);
+	}
+
+	dynapseLog(CAER_LOG_DEBUG, handle, "Applying network to chip %" PRIu8 ": %zu of %zu entries changed.", chipId,
+		configNum, camNumber + sramNumber);
+
+	bool success = sendUSBCommandPipelinedMultiple(handle, networkConfig, configNum);
+
+	free(networkConfig);
+	return (success);
 }
 
 bool caerDynapseWriteSramWords(caerDeviceHandle cdh, const uint16_t *data, uint32_t baseAddr, size_t numWords) {
@@ -22,9 +22,6 @@
 #define DYNAPSE_SPIKE_DEFAULT_SIZE 4096
 #define DYNAPSE_SPECIAL_DEFAULT_SIZE 128
 
-#define SPI_CONFIG_MSG_SIZE 6
-#define SPI_CONFIG_MAX      85
-
 #define DYNAPSE_FX2_USB_CLOCK_FREQ 30
 
 // Chip ID 0 cannot be used for USB output, so we have to shift it by
@@ -50,6 +47,14 @@ struct dynapse_state {
 		caerSpecialEventPacket special;
 		int32_t specialPosition;
 	} currentPackets;
+	// Host-side copy of the on-chip CAM and SRAM contents, as last written.
+	// Zero means unknown, valid CAM and SRAM words are never zero.
+	struct {
+		// Chip currently selected for writing, DYNAPSE_X4BOARD_NUMCHIPS if unknown.
+		uint8_t chipId;
+		uint32_t cam[DYNAPSE_X4BOARD_NUMCHIPS][DYNAPSE_CONFIG_NUMNEURONS * DYNAPSE_CONFIG_NUMCAM_NEU];
+		uint32_t sram[DYNAPSE_X4BOARD_NUMCHIPS][DYNAPSE_CONFIG_NUMNEURONS * DYNAPSE_CONFIG_NUMSRAM_NEU];
+	} networkShadow;
 };
 
 typedef struct dynapse_state *dynapseState;
@@ -72,6 +77,7 @@ bool dynapseSendDefaultConfig(caerDeviceHandle handle);
 // Negative addresses are used for host-side configuration.
 // Positive addresses (including zero) are used for device-side configuration.
 bool dynapseConfigSet(caerDeviceHandle handle, int8_t modAddr, uint8_t paramAddr, uint32_t param);
+bool dynapseConfigSetBatch(caerDeviceHandle handle, const struct caer_device_config *configs, size_t configsNumber);
 bool dynapseConfigGet(caerDeviceHandle handle, int8_t modAddr, uint8_t paramAddr, uint32_t *param);
 
 bool dynapseDataStart(caerDeviceHandle handle, void (*dataNotifyIncrease)(void *ptr),
@@ -79,5 +85,7 @@ bool dynapseDataStart(caerDeviceHandle handle, void (*dataNotifyIncrease)(void *
 	void *dataShutdownUserPtr);
 bool dynapseDataStop(caerDeviceHandle handle);
 caerEventPacketContainer dynapseDataGet(caerDeviceHandle handle);
+size_t dynapseDataGetBatch(caerDeviceHandle handle, caerEventPacketContainer *containers, size_t containersMax,
+	uint32_t timeout);
 
 #endif /* LIBCAER_SRC_DYNAPSE_H_ */
@@ -4,7 +4,8 @@ static void edvsLog(enum caer_log_level logLevel, edvsHandle handle, const char
 static bool serialThreadStart(edvsHandle handle);
 static void serialThreadStop(edvsHandle handle);
 static int serialThreadRun(void *handlePtr);
-static void edvsEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSent);
+static size_t edvsEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSent);
+static size_t edvsFindEventStart(const uint8_t *buffer, size_t start, size_t bytesSent);
 static bool edvsSendBiases(edvsState state, int biasID);
 
 static void edvsLog(enum caer_log_level logLevel, edvsHandle handle, const char *format, ...) {
@@ -70,6 +71,9 @@ caerDeviceHandle edvsOpen(uint16_t deviceID, const char *serialPortName, uint32_
 	// Initialize state variables to default values (if not zero, taken care of by calloc above).
 	dataExchangeSettingsInit(&state->dataExchange);
 
+	// Thread scheduling settings, default to no changes.
+	threadSchedulingSettingsInit(&state->threadScheduling);
+
 	// Packet settings (size (in events) and time interval (in µs)).
 	containerGenerationSettingsInit(&state->container);
 
@@ -298,6 +302,10 @@ bool edvsConfigSet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uint
 			return (containerGenerationConfigSet(&state->container, paramAddr, param));
 			break;
 
+		case CAER_HOST_CONFIG_THREAD:
+			return (threadSchedulingConfigSet(&state->threadScheduling, paramAddr, param));
+			break;
+
 		case CAER_HOST_CONFIG_LOG:
 			switch (paramAddr) {
 				case CAER_HOST_CONFIG_LOG_LEVEL:
@@ -400,6 +408,10 @@ bool edvsConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uint
 			return (containerGenerationConfigGet(&state->container, paramAddr, param));
 			break;
 
+		case CAER_HOST_CONFIG_THREAD:
+			return (threadSchedulingConfigGet(&state->threadScheduling, paramAddr, param));
+			break;
+
 		case CAER_HOST_CONFIG_LOG:
 			switch (paramAddr) {
 				case CAER_HOST_CONFIG_LOG_LEVEL:
@@ -423,6 +435,14 @@ bool edvsConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uint
 					*param = false;
 					break;
 
+				case EDVS_CONFIG_DVS_STATISTICS_RESYNCS:
+					*param = U32T(atomic_load(&state->dvs.statisticsResyncs));
+					break;
+
+				case EDVS_CONFIG_DVS_STATISTICS_SKIPPED_BYTES:
+					*param = U32T(atomic_load(&state->dvs.statisticsSkippedBytes));
+					break;
+
 				default:
 					return (false);
 					break;
@@ -461,13 +481,37 @@ bool edvsConfigGet(caerDeviceHandle cdh, int8_t modAddr, uint8_t paramAddr, uint
 }
 
 static bool serialThreadStart(edvsHandle handle) {
+	edvsState state = &handle->state;
+
+	// Wait on the serial port for incoming data, instead of polling it.
+	if (sp_new_event_set(&state->serialState.serialEventSet) != SP_OK) {
+		edvsLog(CAER_LOG_CRITICAL, handle, "Failed to allocate serial event set.");
+		return (false);
+	}
+
+	if (sp_add_port_events(state->serialState.serialEventSet, state->serialState.serialPort, SP_EVENT_RX_READY)
+		!= SP_OK) {
+		sp_free_event_set(state->serialState.serialEventSet);
+		state->serialState.serialEventSet = NULL;
+
+		edvsLog(CAER_LOG_CRITICAL, handle, "Failed to add serial port to event set.");
+		return (false);
+	}
+
+	state->serialState.serialReadBuffer = NULL;
+	state->serialState.serialReadBufferSize = 0;
+	state->serialState.serialReadBufferLength = 0;
+
 	// Start serial communication thread.
-	if ((errno = thrd_create(&handle->state.serialState.serialThread, &serialThreadRun, handle)) != thrd_success) {
+	if ((errno = thrd_create(&state->serialState.serialThread, &serialThreadRun, handle)) != thrd_success) {
+		sp_free_event_set(state->serialState.serialEventSet);
+		state->serialState.serialEventSet = NULL;
+
 		edvsLog(CAER_LOG_CRITICAL, handle, "Failed to create serial thread. Error: %d.", errno);
 		return (false);
 	}
 
-	while (atomic_load(&handle->state.serialState.serialThreadState) == THR_IDLE) {
+	while (atomic_load(&state->serialState.serialThreadState) == THR_IDLE) {
 		thrd_yield();
 	}
 
@@ -475,14 +519,24 @@ static bool serialThreadStart(edvsHandle handle) {
 }
 
 static void serialThreadStop(edvsHandle handle) {
+	edvsState state = &handle->state;
+
 	// Shut down serial communication thread.
-	atomic_store(&handle->state.serialState.serialThreadState, THR_EXITED);
+	atomic_store(&state->serialState.serialThreadState, THR_EXITED);
 
 	// Wait for serial communication thread to terminate.
-	if ((errno = thrd_join(handle->state.serialState.serialThread, NULL)) != thrd_success) {
+	if ((errno = thrd_join(state->serialState.serialThread, NULL)) != thrd_success) {
 		// This should never happen!
 		edvsLog(CAER_LOG_CRITICAL, handle, "Failed to join serial thread. Error: %d.", errno);
 	}
+
+	sp_free_event_set(state->serialState.serialEventSet);
+	state->serialState.serialEventSet = NULL;
+
+	free(state->serialState.serialReadBuffer);
+	state->serialState.serialReadBuffer = NULL;
+	state->serialState.serialReadBufferSize = 0;
+	state->serialState.serialReadBufferLength = 0;
 }
 
 static int serialThreadRun(void *handlePtr) {
@@ -503,27 +557,57 @@ static int serialThreadRun(void *handlePtr) {
 
 	edvsLog(CAER_LOG_DEBUG, handle, "Serial communication thread running.");
 
+	struct thread_scheduling_thread scheduling;
+	threadSchedulingThreadInit(&state->threadScheduling, &scheduling, 0);
+
 	// Handle serial port reading (wait on data, 10 ms timeout).
 	while (atomic_load_explicit(&state->serialState.serialThreadState, memory_order_relaxed) == THR_RUNNING) {
+		threadSchedulingUpdate(&state->threadScheduling, &scheduling, handle->info.deviceString,
+			atomic_load_explicit(&state->deviceLogLevel, memory_order_relaxed));
+
 		size_t readSize = atomic_load_explicit(&state->serialState.serialReadSize, memory_order_relaxed);
 
-		// Wait for at least 16 full events to be present in the buffer.
-		int bytesAvailable = 0;
+		// Read at least one full event at a time.
+		if (readSize < EDVS_EVENT_SIZE) {
+			readSize = EDVS_EVENT_SIZE;
+		}
+
+		// Grow the receive buffer only if the read size was increased. It also has
+		// to hold the bytes of a partial event left over from the previous read.
+		size_t bufferSize = readSize + (EDVS_EVENT_SIZE - 1);
+
+		if (bufferSize > state->serialState.serialReadBufferSize) {
+			uint8_t *newBuffer = realloc(state->serialState.serialReadBuffer, bufferSize);
+			if (newBuffer == NULL) {
+				edvsLog(CAER_LOG_CRITICAL, handle, "Failed to allocate serial receive buffer.");
+
+				// ERROR: call exceptional shut-down callback and exit.
+				if (state->serialState.serialShutdownCallback != NULL) {
+					state->serialState.serialShutdownCallback(state->serialState.serialShutdownCallbackPtr);
+				}
+				break;
+			}
 
-		while ((bytesAvailable < (16 * EDVS_EVENT_SIZE))
-			&& atomic_load_explicit(&state->serialState.serialThreadState, memory_order_relaxed) == THR_RUNNING) {
-			bytesAvailable = sp_input_waiting(state->serialState.serialPort);
+			state->serialState.serialReadBuffer = newBuffer;
+			state->serialState.serialReadBufferSize = bufferSize;
 		}
 
-		if ((size_t) bytesAvailable < readSize) {
-			readSize = (size_t) bytesAvailable;
+		// Sleep until data arrives. The timeout only serves to periodically
+		// check if the thread should shut down.
+		enum sp_return waitResult = sp_wait(state->serialState.serialEventSet, 10);
+		if (waitResult < 0) {
+			// ERROR: call exceptional shut-down callback and exit.
+			if (state->serialState.serialShutdownCallback != NULL) {
+				state->serialState.serialShutdownCallback(state->serialState.serialShutdownCallbackPtr);
+			}
+			break;
 		}
 
-		// Ensure read size is a multiple of event size.
-		readSize &= (size_t) ~0x03;
+		size_t leftoverLength = state->serialState.serialReadBufferLength;
 
-		uint8_t dataBuffer[readSize];
-		int bytesRead = sp_blocking_read(state->serialState.serialPort, dataBuffer, readSize, 10);
+		// Get all data that is already there, up to the read size.
+		int bytesRead = sp_nonblocking_read(state->serialState.serialPort,
+			state->serialState.serialReadBuffer + leftoverLength, readSize);
 		if (bytesRead < 0) {
 			// ERROR: call exceptional shut-down callback and exit.
 			if (state->serialState.serialShutdownCallback != NULL) {
@@ -532,9 +616,21 @@ static int serialThreadRun(void *handlePtr) {
 			break;
 		}
 
-		if (bytesRead >= EDVS_EVENT_SIZE) {
-			// Read something (at least 1 possible event), process it and try again.
-			edvsEventTranslator(handle, dataBuffer, (size_t) bytesRead);
+		if (bytesRead == 0) {
+			// Timeout, nothing to do.
+			continue;
+		}
+
+		size_t bufferLength = leftoverLength + (size_t) bytesRead;
+
+		size_t bytesUsed = edvsEventTranslator(handle, state->serialState.serialReadBuffer, bufferLength);
+
+		// Keep the bytes of a trailing partial event for the next read.
+		state->serialState.serialReadBufferLength = bufferLength - bytesUsed;
+
+		if (state->serialState.serialReadBufferLength > 0) {
+			memmove(state->serialState.serialReadBuffer, state->serialState.serialReadBuffer + bytesUsed,
+				state->serialState.serialReadBufferLength);
 		}
 	}
 
@@ -636,11 +732,22 @@ caerEventPacketContainer edvsDataGet(caerDeviceHandle cdh) {
 	return (dataExchangeGet(&state->dataExchange, &state->serialState.serialThreadState));
 }
 
+size_t edvsDataGetBatch(caerDeviceHandle cdh, caerEventPacketContainer *containers, size_t containersMax,
+	uint32_t timeout) {
+	edvsHandle handle = (edvsHandle) cdh;
+	edvsState state = &handle->state;
+
+	return (dataExchangeGetBatch(&state->dataExchange, &state->serialState.serialThreadState, containers, containersMax,
+		timeout));
+}
+
 #define TS_WRAP_ADD 0x10000
 #define HIGH_BIT_MASK 0x80
 #define LOW_BITS_MASK 0x7F
 
-static void edvsEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSent) {
+// Returns the number of bytes used. Bytes of a trailing partial event are not
+// used, and must be passed again together with the rest of the event.
+static size_t edvsEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSent) {
 	edvsHandle handle = vhd;
 	edvsState state = &handle->state;
 
@@ -649,7 +756,7 @@ static void edvsEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSe
 	// if a TS_RESET is stuck on ring-buffer commit further down, and detects shut-down;
 	// then any subsequent buffers should also detect shut-down and not be handled.
 	if (atomic_load(&state->serialState.serialThreadState) != THR_RUNNING) {
-		return;
+		return (bytesSent);
 	}
 
 	size_t i = 0;
@@ -657,21 +764,29 @@ static void edvsEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSe
 		uint8_t yByte = buffer[i];
 
 		if ((yByte & HIGH_BIT_MASK) != HIGH_BIT_MASK) {
-			edvsLog(CAER_LOG_NOTICE, handle, "Data not aligned, skipping to next data byte (%zu of %zu).", i,
-				bytesSent);
-			i++;
+			// Lost alignment to event boundaries (bytes lost on the serial line).
+			// Skip to the next possible event start all at once, and count it,
+			// logging every skipped byte would only make things worse.
+			size_t next = edvsFindEventStart(buffer, i + 1, bytesSent);
+
+			atomic_fetch_add_explicit(&state->dvs.statisticsResyncs, 1, memory_order_relaxed);
+			atomic_fetch_add_explicit(&state->dvs.statisticsSkippedBytes, U32T(next - i), memory_order_relaxed);
+
+			edvsLog(CAER_LOG_DEBUG, handle, "Data not aligned, skipped %zu bytes to re-synchronize.", next - i);
+
+			i = next;
 			continue;
 		}
 
 		if ((i + 3) >= bytesSent) {
 			// Cannot fetch next event data, we're done with this buffer.
-			return;
+			return (i);
 		}
 
 		// Allocate new packets for next iteration as needed.
 		if (!containerGenerationAllocate(&state->container, EDVS_EVENT_TYPES)) {
 			edvsLog(CAER_LOG_CRITICAL, handle, "Failed to allocate event packet container.");
-			return;
+			return (bytesSent);
 		}
 
 		if (state->currentPackets.polarity == NULL) {
@@ -679,7 +794,7 @@ static void edvsEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSe
 				I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
 			if (state->currentPackets.polarity == NULL) {
 				edvsLog(CAER_LOG_CRITICAL, handle, "Failed to allocate polarity event packet.");
-				return;
+				return (bytesSent);
 			}
 		}
 		else if (state->currentPackets.polarityPosition
@@ -690,7 +805,7 @@ static void edvsEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSe
 				(caerEventPacketHeader) state->currentPackets.polarity, state->currentPackets.polarityPosition * 2);
 			if (grownPacket == NULL) {
 				edvsLog(CAER_LOG_CRITICAL, handle, "Failed to grow polarity event packet.");
-				return;
+				return (bytesSent);
 			}
 
 			state->currentPackets.polarity = grownPacket;
@@ -701,7 +816,7 @@ static void edvsEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSe
 				I16T(handle->info.deviceID), state->timestamps.wrapOverflow);
 			if (state->currentPackets.special == NULL) {
 				edvsLog(CAER_LOG_CRITICAL, handle, "Failed to allocate special event packet.");
-				return;
+				return (bytesSent);
 			}
 		}
 		else if (state->currentPackets.specialPosition
@@ -712,7 +827,7 @@ static void edvsEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSe
 				(caerEventPacketHeader) state->currentPackets.special, state->currentPackets.specialPosition * 2);
 			if (grownPacket == NULL) {
 				edvsLog(CAER_LOG_CRITICAL, handle, "Failed to grow special event packet.");
-				return;
+				return (bytesSent);
 			}
 
 			state->currentPackets.special = grownPacket;
@@ -869,6 +984,32 @@ static void edvsEventTranslator(void *vhd, const uint8_t *buffer, size_t bytesSe
 
 		i += 4;
 	}
+
+	return (bytesSent);
+}
+
+// Find the next byte with the high bit set, which marks the start of an
+// event, or return 'bytesSent' if there is none. Checks eight bytes at a
+// time, since misalignment usually means a long run of bytes to skip.
+static size_t edvsFindEventStart(const uint8_t *buffer, size_t start, size_t bytesSent) {
+	size_t i = start;
+
+	for (; (i + sizeof(uint64_t)) <= bytesSent; i += sizeof(uint64_t)) {
+		uint64_t bytes;
+		memcpy(&bytes, buffer + i, sizeof(uint64_t));
+
+		if ((bytes & UINT64_C(0x8080808080808080)) != 0) {
+			break;
+		}
+	}
+
+	for (; i < bytesSent; i++) {
+		if ((buffer[i] & HIGH_BIT_MASK) == HIGH_BIT_MASK) {
+			break;
+		}
+	}
+
+	return (i);
 }
 
 static bool edvsSendBiases(edvsState state, int biasID) {
@@ -4,6 +4,7 @@
 #include "devices/edvs.h"
 #include "data_exchange.h"
 #include "container_generation.h"
+#include "thread_scheduling.h"
 #include <libserialport.h>
 #include <stdatomic.h>
 
@@ -34,6 +35,12 @@ struct serial_state {
 	atomic_uint_fast32_t serialThreadState;
 	// Serial Data Transfers
 	atomic_uint_fast32_t serialReadSize;
+	struct sp_event_set *serialEventSet;
+	// Receive buffer, reused for all reads. Bytes of partial events are
+	// kept at the start of the buffer, to be completed by the next read.
+	uint8_t *serialReadBuffer;
+	size_t serialReadBufferSize;
+	size_t serialReadBufferLength;
 	// Serial Data Transfers shutdown callback
 	void (*serialShutdownCallback)(void *serialShutdownCallbackPtr);
 	void *serialShutdownCallbackPtr;
@@ -46,6 +53,8 @@ struct edvs_state {
 	struct data_exchange dataExchange;
 	// Serial Device State
 	struct serial_state serialState;
+	// Scheduling of the serial thread
+	struct thread_scheduling threadScheduling;
 	// Timestamp fields
 	struct {
 		int32_t wrapOverflow;
@@ -69,6 +78,9 @@ struct edvs_state {
 		uint8_t biases[BIAS_NUMBER][BIAS_LENGTH];
 		atomic_bool running;
 		atomic_bool tsReset;
+		// Byte-stream alignment statistics.
+		atomic_uint_fast32_t statisticsResyncs;
+		atomic_uint_fast32_t statisticsSkippedBytes;
 	} dvs;
 };
 
@@ -98,5 +110,7 @@ bool edvsDataStart(caerDeviceHandle handle, void (*dataNotifyIncrease)(void *ptr
 	void *dataShutdownUserPtr);
 bool edvsDataStop(caerDeviceHandle handle);
 caerEventPacketContainer edvsDataGet(caerDeviceHandle handle);
+size_t edvsDataGetBatch(caerDeviceHandle handle, caerEventPacketContainer *containers, size_t containersMax,
+	uint32_t timeout);
 
 #endif /* LIBCAER_SRC_EDVS_H_ */
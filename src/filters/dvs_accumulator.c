@@ -0,0 +1,533 @@
+#include "filters/dvs_accumulator.h"
+#include "../portable_aligned_alloc.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <stdalign.h> // To get alignas() macro.
+
+// Alignment specification support (with defines for cache line alignment).
+#if !defined(CACHELINE_SIZE)
+#define CACHELINE_SIZE 64 // Default (big enough for most processors), must be power of two!
+#endif
+
+// Events are processed in batches: first all addresses and increments in a
+// batch are decoded, in a tight, branch-free loop the compiler can vectorize,
+// then they are scattered into the image. Invalid and out of range events
+// decode to a zero increment, so the scatter loop has no branches either.
+#define ACCUMULATOR_BATCH_SIZE 256
+
+// Published images are exchanged between the accumulating thread and the
+// reader through three slots: one being written, one being read, and one
+// holding the latest published image. Slots are swapped atomically, so
+// neither side ever waits on the other, and the reader never sees a
+// partially written image.
+#define ACCUMULATOR_SLOTS      3
+#define ACCUMULATOR_SLOT_FRESH 0x04U
+#define ACCUMULATOR_SLOT_MASK  0x03U
+
+// Up to two channels (split polarity mode).
+#define ACCUMULATOR_MAX_CHANNELS 2
+
+struct accumulator_slot {
+	struct caer_filter_dvs_accumulator_frame info;
+	// Settings at publication time, for frame conversion by the reader.
+	enum caer_filter_dvs_accumulator_polarity polarityMode;
+	uint32_t frameScale;
+	float *pixels;
+};
+
+struct caer_filter_dvs_accumulator {
+	// Configuration.
+	enum caer_filter_dvs_accumulator_window windowType;
+	int64_t windowSize;
+	uint8_t decay;
+	enum caer_filter_dvs_accumulator_polarity polarityMode;
+	uint32_t frameScale;
+	// Maximum resolution.
+	uint16_t sizeX;
+	uint16_t sizeY;
+	size_t planeSize;
+	// Current window.
+	float *accumulation;
+	bool windowStarted;
+	int64_t windowStart;
+	int64_t windowLast;
+	int64_t windowEvents;
+	int16_t eventSource;
+	uint64_t sequence;
+	// Published images.
+	struct accumulator_slot slots[ACCUMULATOR_SLOTS];
+	uint_fast8_t writeSlot;
+	alignas(CACHELINE_SIZE) atomic_uint_fast8_t latestSlot;
+	alignas(CACHELINE_SIZE) uint_fast8_t readSlot;
+};
+
+static void accumulatorReset(caerFilterDVSAccumulator accumulator);
+static void accumulatorPublish(caerFilterDVSAccumulator accumulator);
+static void accumulatorDecayWindows(caerFilterDVSAccumulator accumulator, int64_t windows);
+static bool accumulatorAcquire(caerFilterDVSAccumulator accumulator);
+
+static inline uint8_t accumulatorChannels(enum caer_filter_dvs_accumulator_polarity polarityMode) {
+	return ((polarityMode == CAER_FILTER_DVS_ACCUMULATOR_POLARITY_SPLIT) ? (2) : (1));
+}
+
+caerFilterDVSAccumulator caerFilterDVSAccumulatorInitialize(uint16_t sizeX, uint16_t sizeY) {
+	if ((sizeX == 0) || (sizeY == 0)) {
+		return (NULL);
+	}
+
+	caerFilterDVSAccumulator accumulator = portable_aligned_alloc(CACHELINE_SIZE, sizeof(*accumulator));
+	if (accumulator == NULL) {
+		caerLog(CAER_LOG_CRITICAL, "DVS Accumulator", "Failed to allocate memory for accumulator. Error: %d.", errno);
+		return (NULL);
+	}
+
+	memset(accumulator, 0, sizeof(*accumulator));
+
+	accumulator->sizeX = sizeX;
+	accumulator->sizeY = sizeY;
+	accumulator->planeSize = (size_t) sizeX * sizeY;
+
+	size_t imageBytes = ACCUMULATOR_MAX_CHANNELS * accumulator->planeSize * sizeof(float);
+
+	accumulator->accumulation = portable_aligned_alloc(CACHELINE_SIZE, imageBytes);
+	bool allocOK = (accumulator->accumulation != NULL);
+
+	for (size_t i = 0; i < ACCUMULATOR_SLOTS; i++) {
+		accumulator->slots[i].pixels = portable_aligned_alloc(CACHELINE_SIZE, imageBytes);
+		allocOK = allocOK && (accumulator->slots[i].pixels != NULL);
+	}
+
+	if (!allocOK) {
+		caerLog(CAER_LOG_CRITICAL, "DVS Accumulator",
+			"Failed to allocate memory for images of %" PRIu16 "x%" PRIu16 " pixels. Error: %d.", sizeX, sizeY, errno);
+
+		caerFilterDVSAccumulatorDestroy(accumulator);
+		return (NULL);
+	}
+
+	// Defaults.
+	accumulator->windowType = CAER_FILTER_DVS_ACCUMULATOR_WINDOW_EVENTS;
+	accumulator->windowSize = 10000;
+	accumulator->decay = 100;
+	accumulator->polarityMode = CAER_FILTER_DVS_ACCUMULATOR_POLARITY_COUNT;
+	accumulator->frameScale = 8192;
+
+	accumulator->writeSlot = 0;
+	accumulator->readSlot = 1;
+	atomic_store_explicit(&accumulator->latestSlot, 2, memory_order_relaxed);
+
+	accumulatorReset(accumulator);
+
+	atomic_thread_fence(memory_order_release);
+
+	return (accumulator);
+}
+
+void caerFilterDVSAccumulatorDestroy(caerFilterDVSAccumulator accumulator) {
+	if (accumulator == NULL) {
+		return;
+	}
+
+	portable_aligned_free(accumulator->accumulation);
+
+	for (size_t i = 0; i < ACCUMULATOR_SLOTS; i++) {
+		portable_aligned_free(accumulator->slots[i].pixels);
+	}
+
+	portable_aligned_free(accumulator);
+}
+
+static void accumulatorReset(caerFilterDVSAccumulator accumulator) {
+	memset(accumulator->accumulation, 0, ACCUMULATOR_MAX_CHANNELS * accumulator->planeSize * sizeof(float));
+
+	accumulator->windowStarted = false;
+	accumulator->windowEvents = 0;
+}
+
+static void accumulatorPublish(caerFilterDVSAccumulator accumulator) {
+	struct accumulator_slot *slot = &accumulator->slots[accumulator->writeSlot];
+
+	slot->info.sequence = ++accumulator->sequence;
+	slot->info.timestampStart = accumulator->windowStart;
+	slot->info.timestampEnd = accumulator->windowLast;
+	slot->info.eventSource = accumulator->eventSource;
+	slot->info.sizeX = accumulator->sizeX;
+	slot->info.sizeY = accumulator->sizeY;
+	slot->info.channels = accumulatorChannels(accumulator->polarityMode);
+	slot->info.pixels = slot->pixels;
+	slot->polarityMode = accumulator->polarityMode;
+	slot->frameScale = accumulator->frameScale;
+
+	// Copy out and decay in one pass over the image.
+	float *restrict accumulation = accumulator->accumulation;
+	float *restrict pixels = slot->pixels;
+	size_t length = slot->info.channels * accumulator->planeSize;
+	float keep = (float) (100 - accumulator->decay) / 100.0f;
+
+	for (size_t i = 0; i < length; i++) {
+		pixels[i] = accumulation[i];
+		accumulation[i] *= keep;
+	}
+
+	uint_fast8_t previous = atomic_exchange_explicit(&accumulator->latestSlot,
+		accumulator->writeSlot | ACCUMULATOR_SLOT_FRESH, memory_order_acq_rel);
+
+	accumulator->writeSlot = previous & ACCUMULATOR_SLOT_MASK;
+
+	accumulator->windowEvents = 0;
+}
+
+// Decay for windows that ended without any events.
+static void accumulatorDecayWindows(caerFilterDVSAccumulator accumulator, int64_t windows) {
+	if ((windows <= 0) || (accumulator->decay == 0)) {
+		return;
+	}
+
+	float *restrict accumulation = accumulator->accumulation;
+	size_t length = accumulatorChannels(accumulator->polarityMode) * accumulator->planeSize;
+	float keep = powf((float) (100 - accumulator->decay) / 100.0f, (float) windows);
+
+	for (size_t i = 0; i < length; i++) {
+		accumulation[i] *= keep;
+	}
+}
+
+static bool accumulatorAcquire(caerFilterDVSAccumulator accumulator) {
+	if ((atomic_load_explicit(&accumulator->latestSlot, memory_order_relaxed) & ACCUMULATOR_SLOT_FRESH) == 0) {
+		return (false);
+	}
+
+	uint_fast8_t previous = atomic_exchange_explicit(&accumulator->latestSlot, accumulator->readSlot,
+		memory_order_acq_rel);
+
+	accumulator->readSlot = previous & ACCUMULATOR_SLOT_MASK;
+
+	return (true);
+}
+
+void caerFilterDVSAccumulatorApply(caerFilterDVSAccumulator accumulator, caerPolarityEventPacketConst polarity) {
+	if ((accumulator == NULL) || (polarity == NULL)) {
+		return;
+	}
+
+	int32_t eventNumber = caerEventPacketHeaderGetEventNumber(&polarity->packetHeader);
+	uint64_t tsOverflow = U64T(caerEventPacketHeaderGetEventTSOverflow(&polarity->packetHeader)) << TS_OVERFLOW_SHIFT;
+
+	accumulator->eventSource = caerEventPacketHeaderGetEventSource(&polarity->packetHeader);
+
+	float *accumulation = accumulator->accumulation;
+	uint32_t sizeX = accumulator->sizeX;
+	uint32_t sizeY = accumulator->sizeY;
+
+	// Per-mode increments: OFF events go to the second plane in split mode,
+	// and subtract in signed mode.
+	bool split = (accumulator->polarityMode == CAER_FILTER_DVS_ACCUMULATOR_POLARITY_SPLIT);
+	size_t offPlaneOffset = (split) ? (accumulator->planeSize) : (0);
+	float offIncrement = (accumulator->polarityMode == CAER_FILTER_DVS_ACCUMULATOR_POLARITY_SIGNED) ? (-1.0f) : (1.0f);
+
+	uint8_t batchUse[ACCUMULATOR_BATCH_SIZE];
+	size_t batchIndex[ACCUMULATOR_BATCH_SIZE];
+	float batchIncrement[ACCUMULATOR_BATCH_SIZE];
+	int64_t batchTimestamp[ACCUMULATOR_BATCH_SIZE];
+
+	int32_t batchStart = 0;
+
+	while (batchStart < eventNumber) {
+		size_t batchSize = (size_t) (eventNumber - batchStart);
+		if (batchSize > ACCUMULATOR_BATCH_SIZE) {
+			batchSize = ACCUMULATOR_BATCH_SIZE;
+		}
+
+		// Fixed-count windows: never decode past the end of the current window.
+		if ((accumulator->windowType == CAER_FILTER_DVS_ACCUMULATOR_WINDOW_EVENTS)
+			&& (batchSize > (size_t) (accumulator->windowSize - accumulator->windowEvents))) {
+			batchSize = (size_t) (accumulator->windowSize - accumulator->windowEvents);
+		}
+
+		caerPolarityEventConst events = polarity->events + batchStart;
+
+		// Decode pass: no branches and no writes to shared state.
+		for (size_t i = 0; i < batchSize; i++) {
+			uint32_t data = le32toh(events[i].data);
+			uint32_t x = (data >> POLARITY_X_ADDR_SHIFT) & POLARITY_X_ADDR_MASK;
+			uint32_t y = (data >> POLARITY_Y_ADDR_SHIFT) & POLARITY_Y_ADDR_MASK;
+			uint32_t pol = (data >> POLARITY_SHIFT) & POLARITY_MASK;
+
+			uint32_t inRange = (uint32_t) (x < sizeX) & (uint32_t) (y < sizeY);
+
+			batchUse[i] = U8T((data >> VALID_MARK_SHIFT) & VALID_MARK_MASK & inRange);
+
+			// Unused events add zero to the first pixel.
+			batchIndex[i] = (batchUse[i]) ? (((size_t) y * sizeX) + x + ((pol) ? (0) : (offPlaneOffset))) : (0);
+			batchIncrement[i] = (batchUse[i]) ? ((pol) ? (1.0f) : (offIncrement)) : (0.0f);
+
+			batchTimestamp[i] = I64T(tsOverflow | U64T(le32toh(events[i].timestamp)));
+		}
+
+		// Find the window start, and for fixed-time windows, the event closing
+		// the window: the batch then only extends up to that event.
+		bool windowDone = false;
+		int64_t lastTimestamp = accumulator->windowLast;
+		int64_t usedEvents = 0;
+
+		for (size_t i = 0; i < batchSize; i++) {
+			if (!batchUse[i]) {
+				continue;
+			}
+
+			if (!accumulator->windowStarted) {
+				accumulator->windowStarted = true;
+				accumulator->windowStart = batchTimestamp[i];
+			}
+
+			if (accumulator->windowType == CAER_FILTER_DVS_ACCUMULATOR_WINDOW_TIME) {
+				int64_t windowTime = batchTimestamp[i] - accumulator->windowStart;
+
+				// Time going backwards (timestamp reset) also ends the window,
+				// else none would end until its old end is reached again.
+				if ((windowTime < 0) || (windowTime >= accumulator->windowSize)) {
+					batchSize = i;
+					windowDone = true;
+					break;
+				}
+			}
+
+			lastTimestamp = batchTimestamp[i];
+			usedEvents++;
+		}
+
+		// Scatter pass.
+		for (size_t i = 0; i < batchSize; i++) {
+			accumulation[batchIndex[i]] += batchIncrement[i];
+		}
+
+		accumulator->windowLast = lastTimestamp;
+		accumulator->windowEvents += usedEvents;
+
+		if ((accumulator->windowType == CAER_FILTER_DVS_ACCUMULATOR_WINDOW_EVENTS)
+			&& (accumulator->windowEvents >= accumulator->windowSize)) {
+			windowDone = true;
+		}
+
+		if (windowDone) {
+			accumulatorPublish(accumulator);
+
+			if (accumulator->windowType == CAER_FILTER_DVS_ACCUMULATOR_WINDOW_TIME) {
+				int64_t closingTimestamp = batchTimestamp[batchSize];
+
+				if (closingTimestamp < accumulator->windowStart) {
+					// Timestamps went backwards: windows restart from the closing event.
+					accumulator->windowStart = closingTimestamp;
+				}
+				else {
+					// Next window starts where the last one ended, skipping over any
+					// windows without events, so that it contains the closing event.
+					// Publishing decayed once, the skipped windows decay too.
+					int64_t windows = (closingTimestamp - accumulator->windowStart) / accumulator->windowSize;
+
+					accumulator->windowStart += windows * accumulator->windowSize;
+
+					accumulatorDecayWindows(accumulator, windows - 1);
+				}
+			}
+			else {
+				accumulator->windowStarted = false;
+			}
+		}
+
+		batchStart += (int32_t) batchSize;
+	}
+}
+
+bool caerFilterDVSAccumulatorGetFrame(caerFilterDVSAccumulator accumulator,
+	struct caer_filter_dvs_accumulator_frame *frame) {
+	if ((accumulator == NULL) || (frame == NULL)) {
+		return (false);
+	}
+
+	if (!accumulatorAcquire(accumulator)) {
+		return (false);
+	}
+
+	*frame = accumulator->slots[accumulator->readSlot].info;
+
+	return (true);
+}
+
+static inline uint16_t accumulatorFramePixel(float value, float scale, float offset) {
+	float pixel = (value * scale) + offset;
+
+	pixel = (pixel < 0.0f) ? (0.0f) : (pixel);
+	pixel = (pixel > (float) UINT16_MAX) ? ((float) UINT16_MAX) : (pixel);
+
+	return (htole16((uint16_t) pixel));
+}
+
+caerFrameEventPacket caerFilterDVSAccumulatorGetFramePacket(caerFilterDVSAccumulator accumulator) {
+	if ((accumulator == NULL) || (!accumulatorAcquire(accumulator))) {
+		return (NULL);
+	}
+
+	const struct accumulator_slot *slot = &accumulator->slots[accumulator->readSlot];
+	struct caer_filter_dvs_accumulator_frame frame = slot->info;
+
+	enum caer_frame_event_color_channels colorChannels = (frame.channels == 2) ? (RGB) : (GRAYSCALE);
+	int32_t tsOverflow = I32T(frame.timestampEnd >> TS_OVERFLOW_SHIFT);
+
+	caerFrameEventPacket framePacket = caerFrameEventPacketAllocate(1, frame.eventSource, tsOverflow, frame.sizeX,
+		frame.sizeY, (int16_t) colorChannels);
+	if (framePacket == NULL) {
+		return (NULL);
+	}
+
+	caerFrameEvent frameEvent = caerFrameEventPacketGetEvent(framePacket, 0);
+
+	caerFrameEventSetLengthXLengthYChannelNumber(frameEvent, frame.sizeX, frame.sizeY, colorChannels, framePacket);
+
+	// Timestamps are relative to the packet's overflow counter, which is the
+	// end's. A frame that started before that overflow starts at 0 instead,
+	// so that its start never comes after its end.
+	int32_t tsStart = ((frame.timestampStart >> TS_OVERFLOW_SHIFT) == (frame.timestampEnd >> TS_OVERFLOW_SHIFT))
+						  ? (I32T(frame.timestampStart & INT32_MAX))
+						  : (0);
+	int32_t tsEnd = I32T(frame.timestampEnd & INT32_MAX);
+
+	caerFrameEventSetTSStartOfFrame(frameEvent, tsStart);
+	caerFrameEventSetTSStartOfExposure(frameEvent, tsStart);
+	caerFrameEventSetTSEndOfExposure(frameEvent, tsEnd);
+	caerFrameEventSetTSEndOfFrame(frameEvent, tsEnd);
+
+	uint16_t *framePixels = caerFrameEventGetPixelArrayUnsafe(frameEvent);
+	size_t planeSize = (size_t) frame.sizeX * frame.sizeY;
+	float scale = (float) slot->frameScale;
+
+	if (colorChannels == RGB) {
+		const float *onPixels = frame.pixels;
+		const float *offPixels = frame.pixels + planeSize;
+
+		for (size_t i = 0; i < planeSize; i++) {
+			framePixels[(i * 3) + 0] = accumulatorFramePixel(onPixels[i], scale, 0.0f);
+			framePixels[(i * 3) + 1] = accumulatorFramePixel(offPixels[i], scale, 0.0f);
+			framePixels[(i * 3) + 2] = 0;
+		}
+	}
+	else {
+		// Signed images have zero in the middle of the pixel range.
+		float offset = (slot->polarityMode == CAER_FILTER_DVS_ACCUMULATOR_POLARITY_SIGNED) ? (32768.0f) : (0.0f);
+
+		for (size_t i = 0; i < planeSize; i++) {
+			framePixels[i] = accumulatorFramePixel(frame.pixels[i], scale, offset);
+		}
+	}
+
+	caerFrameEventValidate(frameEvent, framePacket);
+
+	return (framePacket);
+}
+
+bool caerFilterDVSAccumulatorConfigSet(caerFilterDVSAccumulator accumulator, uint8_t paramAddr, uint64_t param) {
+	if (accumulator == NULL) {
+		return (false);
+	}
+
+	switch (paramAddr) {
+		case CAER_FILTER_DVS_ACCUMULATOR_WINDOW_TYPE:
+			if ((param != CAER_FILTER_DVS_ACCUMULATOR_WINDOW_EVENTS) && (param != CAER_FILTER_DVS_ACCUMULATOR_WINDOW_TIME)) {
+				return (false);
+			}
+
+			accumulator->windowType = (enum caer_filter_dvs_accumulator_window) param;
+			accumulatorReset(accumulator);
+			break;
+
+		case CAER_FILTER_DVS_ACCUMULATOR_WINDOW_SIZE:
+			if ((param == 0) || (param > INT32_MAX)) {
+				return (false);
+			}
+
+			accumulator->windowSize = I64T(param);
+			break;
+
+		case CAER_FILTER_DVS_ACCUMULATOR_DECAY:
+			if (param > 100) {
+				return (false);
+			}
+
+			accumulator->decay = U8T(param);
+			break;
+
+		case CAER_FILTER_DVS_ACCUMULATOR_POLARITY_MODE:
+			if (param > CAER_FILTER_DVS_ACCUMULATOR_POLARITY_SPLIT) {
+				return (false);
+			}
+
+			accumulator->polarityMode = (enum caer_filter_dvs_accumulator_polarity) param;
+			accumulatorReset(accumulator);
+			break;
+
+		case CAER_FILTER_DVS_ACCUMULATOR_FRAME_SCALE:
+			if ((param == 0) || (param > UINT16_MAX)) {
+				return (false);
+			}
+
+			accumulator->frameScale = U32T(param);
+			break;
+
+		case CAER_FILTER_DVS_ACCUMULATOR_RESET:
+			if (param) {
+				accumulatorReset(accumulator);
+			}
+			break;
+
+		default:
+			return (false);
+			break;
+	}
+
+	return (true);
+}
+
+bool caerFilterDVSAccumulatorConfigGet(caerFilterDVSAccumulator accumulator, uint8_t paramAddr, uint64_t *param) {
+	if (accumulator == NULL) {
+		return (false);
+	}
+
+	// Ensure default value is reset.
+	*param = 0;
+
+	switch (paramAddr) {
+		case CAER_FILTER_DVS_ACCUMULATOR_WINDOW_TYPE:
+			*param = accumulator->windowType;
+			break;
+
+		case CAER_FILTER_DVS_ACCUMULATOR_WINDOW_SIZE:
+			*param = U64T(accumulator->windowSize);
+			break;
+
+		case CAER_FILTER_DVS_ACCUMULATOR_DECAY:
+			*param = accumulator->decay;
+			break;
+
+		case CAER_FILTER_DVS_ACCUMULATOR_POLARITY_MODE:
+			*param = accumulator->polarityMode;
+			break;
+
+		case CAER_FILTER_DVS_ACCUMULATOR_FRAME_SCALE:
+			*param = accumulator->frameScale;
+			break;
+
+		case CAER_FILTER_DVS_ACCUMULATOR_RESET:
+			*param = false;
+			break;
+
+		case CAER_FILTER_DVS_ACCUMULATOR_STATISTICS:
+			*param = accumulator->sequence;
+			break;
+
+		default:
+			return (false);
+			break;
+	}
+
+	return (true);
+}
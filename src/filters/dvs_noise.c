@@ -0,0 +1,639 @@
+#include "filters/dvs_noise.h"
+#include "devices/davis.h"
+#include "../portable_aligned_alloc.h"
+
+// Alignment specification support (with defines for cache line alignment).
+#if !defined(CACHELINE_SIZE)
+#define CACHELINE_SIZE 64 // Default (big enough for most processors), must be power of two!
+#endif
+
+// The timestamp map is stored in square tiles of 8x8 pixels, so that one row
+// of a tile (8 x 64bit timestamps) fills exactly one cache line, and a whole
+// neighborhood lookup touches only a handful of consecutive cache lines.
+// The map also has a one pixel border all around, so that neighborhood lookups
+// never have to check for the sensor edges.
+#define TS_MAP_TILE_SHIFT 3
+#define TS_MAP_TILE_SIZE  (1U << TS_MAP_TILE_SHIFT)
+#define TS_MAP_TILE_MASK  (TS_MAP_TILE_SIZE - 1)
+#define TS_MAP_BORDER     1
+
+// Value of never written timestamp map entries. Far enough in the past that
+// no time constant can ever be satisfied, while still not overflowing on
+// subtraction from any valid 64bit event timestamp.
+#define TS_MAP_EMPTY (INT64_MIN / 2)
+
+// Events are processed in batches: first all addresses and timestamps in a
+// batch are decoded, in a tight, branch-free loop the compiler can vectorize,
+// then the actual filtering runs over the decoded data.
+#define FILTER_BATCH_SIZE 64
+
+// Number of FPGA pixel filters available on DAVIS devices.
+#define DAVIS_PIXEL_FILTERS_NUMBER 8
+
+// Hot pixel learning defaults: 1 second window, 5 Hz or more is hot.
+#define HOTPIXEL_LEARN_TIME_DEFAULT  1000000
+#define HOTPIXEL_LEARN_COUNT_DEFAULT 5
+
+struct caer_filter_dvs_noise {
+	// Hot pixel filter.
+	bool hotPixelEnabled;
+	uint64_t hotPixelStatistics;
+	// Hot pixel learning.
+	bool hotPixelLearn;
+	int64_t hotPixelLearnTime;
+	uint32_t hotPixelLearnCount;
+	int64_t hotPixelLearnStart;
+	uint16_t *hotPixelLearnCounts;
+	// Learned hot pixels, as bitset mask (one bit per pixel, row-major) and
+	// as list ordered by activity.
+	uint64_t *hotPixelMask;
+	size_t hotPixelsNumber;
+	struct caer_filter_dvs_pixel *hotPixels;
+	caerDeviceHandle hotPixelDevice;
+	// Background-activity filter.
+	bool backgroundActivityEnabled;
+	int64_t backgroundActivityTime;
+	uint64_t backgroundActivityStatistics;
+	// Refractory period filter.
+	bool refractoryPeriodEnabled;
+	int64_t refractoryPeriodTime;
+	uint64_t refractoryPeriodStatistics;
+	// Maximum resolution.
+	uint16_t sizeX;
+	uint16_t sizeY;
+	// Tiled per-pixel timestamp map.
+	size_t timestampsMapTilesX;
+	size_t timestampsMapLength;
+	int64_t *timestampsMap;
+};
+
+static void filterDVSNoiseReset(caerFilterDVSNoise noiseFilter);
+static bool filterDVSNoiseHotPixelLearnStart(caerFilterDVSNoise noiseFilter);
+static void filterDVSNoiseHotPixelLearnStop(caerFilterDVSNoise noiseFilter);
+static bool filterDVSNoiseHotPixelGenerate(caerFilterDVSNoise noiseFilter);
+
+static inline size_t timestampsMapIndex(size_t tilesX, uint32_t mapX, uint32_t mapY) {
+	size_t tileIndex = ((size_t) (mapY >> TS_MAP_TILE_SHIFT) * tilesX) + (size_t) (mapX >> TS_MAP_TILE_SHIFT);
+
+	return ((tileIndex << (2 * TS_MAP_TILE_SHIFT)) | (size_t) ((mapY & TS_MAP_TILE_MASK) << TS_MAP_TILE_SHIFT)
+		| (size_t) (mapX & TS_MAP_TILE_MASK));
+}
+
+static inline int64_t timestampsMapMax(int64_t a, int64_t b) {
+	return ((a > b) ? (a) : (b));
+}
+
+// Get the most recent timestamp of the eight neighbors of a pixel.
+static inline int64_t timestampsMapNeighborsLast(const int64_t *timestampsMap, size_t tilesX, size_t index,
+	uint32_t mapX, uint32_t mapY) {
+	int64_t last;
+
+	if ((((mapX & TS_MAP_TILE_MASK) - 1U) < (TS_MAP_TILE_SIZE - 2U))
+		&& (((mapY & TS_MAP_TILE_MASK) - 1U) < (TS_MAP_TILE_SIZE - 2U))) {
+		// Fast path: whole neighborhood is inside the same tile.
+		const int64_t *above = timestampsMap + index - TS_MAP_TILE_SIZE;
+		const int64_t *center = timestampsMap + index;
+		const int64_t *below = timestampsMap + index + TS_MAP_TILE_SIZE;
+
+		last = timestampsMapMax(above[-1], above[0]);
+		last = timestampsMapMax(last, above[1]);
+		last = timestampsMapMax(last, center[-1]);
+		last = timestampsMapMax(last, center[1]);
+		last = timestampsMapMax(last, below[-1]);
+		last = timestampsMapMax(last, below[0]);
+		last = timestampsMapMax(last, below[1]);
+	}
+	else {
+		// Slow path: neighborhood spans multiple tiles.
+		last = timestampsMap[timestampsMapIndex(tilesX, mapX - 1, mapY - 1)];
+		last = timestampsMapMax(last, timestampsMap[timestampsMapIndex(tilesX, mapX, mapY - 1)]);
+		last = timestampsMapMax(last, timestampsMap[timestampsMapIndex(tilesX, mapX + 1, mapY - 1)]);
+		last = timestampsMapMax(last, timestampsMap[timestampsMapIndex(tilesX, mapX - 1, mapY)]);
+		last = timestampsMapMax(last, timestampsMap[timestampsMapIndex(tilesX, mapX + 1, mapY)]);
+		last = timestampsMapMax(last, timestampsMap[timestampsMapIndex(tilesX, mapX - 1, mapY + 1)]);
+		last = timestampsMapMax(last, timestampsMap[timestampsMapIndex(tilesX, mapX, mapY + 1)]);
+		last = timestampsMapMax(last, timestampsMap[timestampsMapIndex(tilesX, mapX + 1, mapY + 1)]);
+	}
+
+	return (last);
+}
+
+caerFilterDVSNoise caerFilterDVSNoiseInitialize(uint16_t sizeX, uint16_t sizeY) {
+	if ((sizeX == 0) || (sizeY == 0)) {
+		return (NULL);
+	}
+
+	caerFilterDVSNoise noiseFilter = calloc(1, sizeof(*noiseFilter));
+	if (noiseFilter == NULL) {
+		caerLog(CAER_LOG_CRITICAL, "DVS Noise Filter", "Failed to allocate memory for filter. Error: %d.", errno);
+		return (NULL);
+	}
+
+	noiseFilter->sizeX = sizeX;
+	noiseFilter->sizeY = sizeY;
+
+	// Map includes a border on all sides, rounded up to full tiles.
+	size_t mapSizeX = (size_t) sizeX + (2 * TS_MAP_BORDER);
+	size_t mapSizeY = (size_t) sizeY + (2 * TS_MAP_BORDER);
+
+	noiseFilter->timestampsMapTilesX = (mapSizeX + TS_MAP_TILE_MASK) >> TS_MAP_TILE_SHIFT;
+	size_t tilesY = (mapSizeY + TS_MAP_TILE_MASK) >> TS_MAP_TILE_SHIFT;
+
+	noiseFilter->timestampsMapLength = noiseFilter->timestampsMapTilesX * tilesY * TS_MAP_TILE_SIZE * TS_MAP_TILE_SIZE;
+
+	noiseFilter->timestampsMap = portable_aligned_alloc(CACHELINE_SIZE,
+		noiseFilter->timestampsMapLength * sizeof(int64_t));
+	if (noiseFilter->timestampsMap == NULL) {
+		caerLog(CAER_LOG_CRITICAL, "DVS Noise Filter",
+			"Failed to allocate memory for timestamps map of %" PRIu16 "x%" PRIu16 " pixels. Error: %d.", sizeX, sizeY,
+			errno);
+
+		free(noiseFilter);
+		return (NULL);
+	}
+
+	// One bit per pixel, starts out empty (no hot pixels).
+	noiseFilter->hotPixelMask = calloc((((size_t) sizeX * sizeY) + 63) / 64, sizeof(uint64_t));
+	if (noiseFilter->hotPixelMask == NULL) {
+		caerLog(CAER_LOG_CRITICAL, "DVS Noise Filter",
+			"Failed to allocate memory for hot pixel mask of %" PRIu16 "x%" PRIu16 " pixels. Error: %d.", sizeX, sizeY,
+			errno);
+
+		portable_aligned_free(noiseFilter->timestampsMap);
+		free(noiseFilter);
+		return (NULL);
+	}
+
+	// Default time constants, same as the DAVIS FPGA filters.
+	noiseFilter->backgroundActivityTime = 20000;
+	noiseFilter->refractoryPeriodTime = 100;
+
+	noiseFilter->hotPixelLearnTime = HOTPIXEL_LEARN_TIME_DEFAULT;
+	noiseFilter->hotPixelLearnCount = HOTPIXEL_LEARN_COUNT_DEFAULT;
+
+	filterDVSNoiseReset(noiseFilter);
+
+	return (noiseFilter);
+}
+
+void caerFilterDVSNoiseDestroy(caerFilterDVSNoise noiseFilter) {
+	if (noiseFilter == NULL) {
+		return;
+	}
+
+	portable_aligned_free(noiseFilter->timestampsMap);
+
+	free(noiseFilter->hotPixelLearnCounts);
+	free(noiseFilter->hotPixelMask);
+	free(noiseFilter->hotPixels);
+
+	free(noiseFilter);
+}
+
+static void filterDVSNoiseReset(caerFilterDVSNoise noiseFilter) {
+	for (size_t i = 0; i < noiseFilter->timestampsMapLength; i++) {
+		noiseFilter->timestampsMap[i] = TS_MAP_EMPTY;
+	}
+
+	noiseFilter->hotPixelStatistics = 0;
+	noiseFilter->backgroundActivityStatistics = 0;
+	noiseFilter->refractoryPeriodStatistics = 0;
+}
+
+static bool filterDVSNoiseHotPixelLearnStart(caerFilterDVSNoise noiseFilter) {
+	// Restart from zero if already learning.
+	free(noiseFilter->hotPixelLearnCounts);
+
+	// Saturating 16bit counters, row-major. Only allocated during learning.
+	noiseFilter->hotPixelLearnCounts = calloc((size_t) noiseFilter->sizeX * noiseFilter->sizeY, sizeof(uint16_t));
+	if (noiseFilter->hotPixelLearnCounts == NULL) {
+		noiseFilter->hotPixelLearn = false;
+
+		caerLog(CAER_LOG_ERROR, "DVS Noise Filter", "Failed to allocate memory for hot pixel learning. Error: %d.",
+			errno);
+		return (false);
+	}
+
+	noiseFilter->hotPixelLearn = true;
+	noiseFilter->hotPixelLearnStart = -1; // Set by first event.
+
+	return (true);
+}
+
+static void filterDVSNoiseHotPixelLearnStop(caerFilterDVSNoise noiseFilter) {
+	free(noiseFilter->hotPixelLearnCounts);
+	noiseFilter->hotPixelLearnCounts = NULL;
+
+	noiseFilter->hotPixelLearn = false;
+}
+
+struct hot_pixel_count {
+	uint32_t index;
+	uint16_t count;
+};
+
+static int hotPixelCountCompare(const void *a, const void *b) {
+	const struct hot_pixel_count *aa = a;
+	const struct hot_pixel_count *bb = b;
+
+	// Descending by count, then ascending by address for stable results.
+	if (aa->count != bb->count) {
+		return ((aa->count > bb->count) ? (-1) : (1));
+	}
+
+	return ((aa->index < bb->index) ? (-1) : ((aa->index > bb->index) ? (1) : (0)));
+}
+
+static bool filterDVSNoiseHotPixelGenerate(caerFilterDVSNoise noiseFilter) {
+	const uint16_t *counts = noiseFilter->hotPixelLearnCounts;
+	size_t pixelsNumber = (size_t) noiseFilter->sizeX * noiseFilter->sizeY;
+
+	// Counters saturate, so clamp threshold to what they can express.
+	uint16_t threshold = (noiseFilter->hotPixelLearnCount > UINT16_MAX) ? (UINT16_MAX)
+																		: (U16T(noiseFilter->hotPixelLearnCount));
+	if (threshold == 0) {
+		threshold = 1;
+	}
+
+	size_t hotNumber = 0;
+	for (size_t i = 0; i < pixelsNumber; i++) {
+		hotNumber += (counts[i] >= threshold);
+	}
+
+	struct hot_pixel_count *hotCounts = NULL;
+	struct caer_filter_dvs_pixel *hotPixels = NULL;
+
+	if (hotNumber > 0) {
+		hotCounts = malloc(hotNumber * sizeof(*hotCounts));
+		hotPixels = malloc(hotNumber * sizeof(*hotPixels));
+
+		if ((hotCounts == NULL) || (hotPixels == NULL)) {
+			free(hotCounts);
+			free(hotPixels);
+
+			caerLog(CAER_LOG_ERROR, "DVS Noise Filter", "Failed to allocate memory for %zu hot pixels. Error: %d.",
+				hotNumber, errno);
+			return (false);
+		}
+
+		size_t idx = 0;
+		for (size_t i = 0; i < pixelsNumber; i++) {
+			if (counts[i] >= threshold) {
+				hotCounts[idx].index = U32T(i);
+				hotCounts[idx].count = counts[i];
+				idx++;
+			}
+		}
+
+		qsort(hotCounts, hotNumber, sizeof(*hotCounts), &hotPixelCountCompare);
+	}
+
+	// Rebuild mask from scratch.
+	memset(noiseFilter->hotPixelMask, 0, ((pixelsNumber + 63) / 64) * sizeof(uint64_t));
+
+	for (size_t i = 0; i < hotNumber; i++) {
+		uint32_t index = hotCounts[i].index;
+
+		noiseFilter->hotPixelMask[index >> 6] |= (U64T(1) << (index & 63));
+
+		hotPixels[i].x = U16T(index % noiseFilter->sizeX);
+		hotPixels[i].y = U16T(index / noiseFilter->sizeX);
+	}
+
+	free(hotCounts);
+
+	free(noiseFilter->hotPixels);
+	noiseFilter->hotPixels = hotPixels;
+	noiseFilter->hotPixelsNumber = hotNumber;
+
+	caerLog(CAER_LOG_DEBUG, "DVS Noise Filter", "Hot pixel learning done, found %zu hot pixels.", hotNumber);
+
+	return (true);
+}
+
+void caerFilterDVSNoiseApply(caerFilterDVSNoise noiseFilter, caerPolarityEventPacket polarity) {
+	if ((noiseFilter == NULL) || (polarity == NULL)) {
+		return;
+	}
+
+	// Nothing enabled, nothing to do.
+	if ((!noiseFilter->hotPixelLearn) && (!noiseFilter->hotPixelEnabled) && (!noiseFilter->backgroundActivityEnabled)
+		&& (!noiseFilter->refractoryPeriodEnabled)) {
+		return;
+	}
+
+	int32_t eventNumber = caerEventPacketHeaderGetEventNumber(&polarity->packetHeader);
+	uint64_t tsOverflow = U64T(caerEventPacketHeaderGetEventTSOverflow(&polarity->packetHeader)) << TS_OVERFLOW_SHIFT;
+
+	int64_t *timestampsMap = noiseFilter->timestampsMap;
+	const uint64_t *hotPixelMask = noiseFilter->hotPixelMask;
+	size_t tilesX = noiseFilter->timestampsMapTilesX;
+	uint32_t sizeX = noiseFilter->sizeX;
+	uint32_t sizeY = noiseFilter->sizeY;
+
+	uint8_t batchUse[FILTER_BATCH_SIZE];
+	uint32_t batchMapX[FILTER_BATCH_SIZE];
+	uint32_t batchMapY[FILTER_BATCH_SIZE];
+	size_t batchIndex[FILTER_BATCH_SIZE];
+	uint32_t batchPixel[FILTER_BATCH_SIZE];
+	uint8_t batchHot[FILTER_BATCH_SIZE];
+	int64_t batchTimestamp[FILTER_BATCH_SIZE];
+
+	for (int32_t batchStart = 0; batchStart < eventNumber; batchStart += FILTER_BATCH_SIZE) {
+		size_t batchSize = (size_t) (eventNumber - batchStart);
+		if (batchSize > FILTER_BATCH_SIZE) {
+			batchSize = FILTER_BATCH_SIZE;
+		}
+
+		caerPolarityEvent events = polarity->events + batchStart;
+
+		// Decode pass: no branches and no writes to shared state.
+		for (size_t i = 0; i < batchSize; i++) {
+			uint32_t data = le32toh(events[i].data);
+			uint32_t x = (data >> POLARITY_X_ADDR_SHIFT) & POLARITY_X_ADDR_MASK;
+			uint32_t y = (data >> POLARITY_Y_ADDR_SHIFT) & POLARITY_Y_ADDR_MASK;
+
+			uint32_t inRange = (uint32_t) (x < sizeX) & (uint32_t) (y < sizeY);
+
+			batchUse[i] = U8T((data >> VALID_MARK_SHIFT) & VALID_MARK_MASK & inRange);
+
+			// Out of range addresses are mapped to the border, they are never used anyway.
+			batchMapX[i] = (inRange) ? (x + TS_MAP_BORDER) : (0);
+			batchMapY[i] = (inRange) ? (y + TS_MAP_BORDER) : (0);
+
+			batchIndex[i] = timestampsMapIndex(tilesX, batchMapX[i], batchMapY[i]);
+
+			// Row-major pixel address, for hot pixel mask and learning counters.
+			batchPixel[i] = (inRange) ? ((y * sizeX) + x) : (0);
+			batchHot[i] = U8T((hotPixelMask[batchPixel[i] >> 6] >> (batchPixel[i] & 63)) & 0x01);
+
+			batchTimestamp[i] = I64T(tsOverflow | U64T(le32toh(events[i].timestamp)));
+		}
+
+		// Filter pass: sequential, as every event updates the map for the next ones.
+		for (size_t i = 0; i < batchSize; i++) {
+			if (!batchUse[i]) {
+				continue;
+			}
+
+			int64_t ts = batchTimestamp[i];
+
+			if (noiseFilter->hotPixelLearn) {
+				if (noiseFilter->hotPixelLearnStart < 0) {
+					noiseFilter->hotPixelLearnStart = ts;
+				}
+
+				if ((ts - noiseFilter->hotPixelLearnStart) < noiseFilter->hotPixelLearnTime) {
+					uint16_t *count = &noiseFilter->hotPixelLearnCounts[batchPixel[i]];
+					if (*count < UINT16_MAX) {
+						*count = U16T(*count + 1);
+					}
+				}
+				else {
+					// Learning window over, switch to new mask right away.
+					if (filterDVSNoiseHotPixelGenerate(noiseFilter) && (noiseFilter->hotPixelDevice != NULL)) {
+						caerFilterDVSNoiseHotPixelsProgramDevice(noiseFilter, noiseFilter->hotPixelDevice);
+					}
+
+					filterDVSNoiseHotPixelLearnStop(noiseFilter);
+
+					batchHot[i] = U8T((hotPixelMask[batchPixel[i] >> 6] >> (batchPixel[i] & 63)) & 0x01);
+					for (size_t j = i + 1; j < batchSize; j++) {
+						batchHot[j] = U8T((hotPixelMask[batchPixel[j] >> 6] >> (batchPixel[j] & 63)) & 0x01);
+					}
+				}
+			}
+
+			// Hot pixels are dropped completely, they don't count as activity either.
+			if (noiseFilter->hotPixelEnabled && batchHot[i]) {
+				noiseFilter->hotPixelStatistics++;
+				caerPolarityEventInvalidate(&events[i], polarity);
+				continue;
+			}
+
+			int64_t *pixelTimestamp = &timestampsMap[batchIndex[i]];
+			bool filterOut = false;
+
+			if (noiseFilter->backgroundActivityEnabled) {
+				int64_t neighborsLast = timestampsMapNeighborsLast(timestampsMap, tilesX, batchIndex[i], batchMapX[i],
+					batchMapY[i]);
+
+				if ((ts - neighborsLast) >= noiseFilter->backgroundActivityTime) {
+					filterOut = true;
+					noiseFilter->backgroundActivityStatistics++;
+				}
+			}
+
+			if ((!filterOut) && noiseFilter->refractoryPeriodEnabled) {
+				if ((ts - *pixelTimestamp) < noiseFilter->refractoryPeriodTime) {
+					filterOut = true;
+					noiseFilter->refractoryPeriodStatistics++;
+				}
+			}
+
+			// Always update the map, filtered events are still activity.
+			*pixelTimestamp = ts;
+
+			if (filterOut) {
+				caerPolarityEventInvalidate(&events[i], polarity);
+			}
+		}
+	}
+}
+
+size_t caerFilterDVSNoiseGetHotPixels(caerFilterDVSNoise noiseFilter, const struct caer_filter_dvs_pixel **hotPixels) {
+	if ((noiseFilter == NULL) || (hotPixels == NULL)) {
+		return (0);
+	}
+
+	*hotPixels = noiseFilter->hotPixels;
+
+	return (noiseFilter->hotPixelsNumber);
+}
+
+bool caerFilterDVSNoiseHotPixelsProgramDevice(caerFilterDVSNoise noiseFilter, caerDeviceHandle davisHandle) {
+	if ((noiseFilter == NULL) || (davisHandle == NULL)) {
+		return (false);
+	}
+
+	// Returns zeroed info for non-DAVIS devices, so this check covers both.
+	struct caer_davis_info davisInfo = caerDavisInfoGet(davisHandle);
+	if (!davisInfo.dvsHasPixelFilter) {
+		caerLog(CAER_LOG_ERROR, "DVS Noise Filter", "Device does not support FPGA pixel filters.");
+		return (false);
+	}
+
+	if ((davisInfo.dvsSizeX != noiseFilter->sizeX) || (davisInfo.dvsSizeY != noiseFilter->sizeY)) {
+		caerLog(CAER_LOG_WARNING, "DVS Noise Filter",
+			"Device resolution %" PRIi16 "x%" PRIi16 " differs from filter resolution %" PRIu16 "x%" PRIu16 ".",
+			davisInfo.dvsSizeX, davisInfo.dvsSizeY, noiseFilter->sizeX, noiseFilter->sizeY);
+	}
+
+	// Hot pixels are already ordered by activity, so the first ones are the worst.
+	for (uint8_t i = 0; i < DAVIS_PIXEL_FILTERS_NUMBER; i++) {
+		// Disabled filters point just outside the pixel array.
+		uint32_t row = U32T(davisInfo.dvsSizeY);
+		uint32_t column = U32T(davisInfo.dvsSizeX);
+
+		if (i < noiseFilter->hotPixelsNumber) {
+			row = noiseFilter->hotPixels[i].y;
+			column = noiseFilter->hotPixels[i].x;
+		}
+
+		uint8_t rowAddr = U8T(DAVIS_CONFIG_DVS_FILTER_PIXEL_0_ROW + (2 * i));
+		uint8_t columnAddr = U8T(DAVIS_CONFIG_DVS_FILTER_PIXEL_0_COLUMN + (2 * i));
+
+		if (!caerDeviceConfigSet(davisHandle, DAVIS_CONFIG_DVS, rowAddr, row)
+			|| !caerDeviceConfigSet(davisHandle, DAVIS_CONFIG_DVS, columnAddr, column)) {
+			caerLog(CAER_LOG_ERROR, "DVS Noise Filter", "Failed to program FPGA pixel filter %" PRIu8 ".", i);
+			return (false);
+		}
+	}
+
+	return (true);
+}
+
+void caerFilterDVSNoiseHotPixelsAttachDevice(caerFilterDVSNoise noiseFilter, caerDeviceHandle davisHandle) {
+	if (noiseFilter == NULL) {
+		return;
+	}
+
+	noiseFilter->hotPixelDevice = davisHandle;
+}
+
+bool caerFilterDVSNoiseConfigSet(caerFilterDVSNoise noiseFilter, uint8_t paramAddr, uint64_t param) {
+	if (noiseFilter == NULL) {
+		return (false);
+	}
+
+	switch (paramAddr) {
+		case CAER_FILTER_DVS_BACKGROUND_ACTIVITY_ENABLE:
+			noiseFilter->backgroundActivityEnabled = param;
+			break;
+
+		case CAER_FILTER_DVS_BACKGROUND_ACTIVITY_TIME:
+			if (param > INT32_MAX) {
+				return (false);
+			}
+
+			noiseFilter->backgroundActivityTime = I64T(param);
+			break;
+
+		case CAER_FILTER_DVS_REFRACTORY_PERIOD_ENABLE:
+			noiseFilter->refractoryPeriodEnabled = param;
+			break;
+
+		case CAER_FILTER_DVS_REFRACTORY_PERIOD_TIME:
+			if (param > INT32_MAX) {
+				return (false);
+			}
+
+			noiseFilter->refractoryPeriodTime = I64T(param);
+			break;
+
+		case CAER_FILTER_DVS_RESET:
+			if (param) {
+				filterDVSNoiseReset(noiseFilter);
+			}
+			break;
+
+		case CAER_FILTER_DVS_HOTPIXEL_ENABLE:
+			noiseFilter->hotPixelEnabled = param;
+			break;
+
+		case CAER_FILTER_DVS_HOTPIXEL_LEARN:
+			if (param) {
+				return (filterDVSNoiseHotPixelLearnStart(noiseFilter));
+			}
+
+			filterDVSNoiseHotPixelLearnStop(noiseFilter);
+			break;
+
+		case CAER_FILTER_DVS_HOTPIXEL_TIME:
+			if ((param == 0) || (param > INT32_MAX)) {
+				return (false);
+			}
+
+			noiseFilter->hotPixelLearnTime = I64T(param);
+			break;
+
+		case CAER_FILTER_DVS_HOTPIXEL_COUNT:
+			if ((param == 0) || (param > UINT16_MAX)) {
+				return (false);
+			}
+
+			noiseFilter->hotPixelLearnCount = U32T(param);
+			break;
+
+		default:
+			return (false);
+			break;
+	}
+
+	return (true);
+}
+
+bool caerFilterDVSNoiseConfigGet(caerFilterDVSNoise noiseFilter, uint8_t paramAddr, uint64_t *param) {
+	if (noiseFilter == NULL) {
+		return (false);
+	}
+
+	// Ensure default value is reset.
+	*param = 0;
+
+	switch (paramAddr) {
+		case CAER_FILTER_DVS_BACKGROUND_ACTIVITY_ENABLE:
+			*param = noiseFilter->backgroundActivityEnabled;
+			break;
+
+		case CAER_FILTER_DVS_BACKGROUND_ACTIVITY_TIME:
+			*param = U64T(noiseFilter->backgroundActivityTime);
+			break;
+
+		case CAER_FILTER_DVS_BACKGROUND_ACTIVITY_STATISTICS:
+			*param = noiseFilter->backgroundActivityStatistics;
+			break;
+
+		case CAER_FILTER_DVS_REFRACTORY_PERIOD_ENABLE:
+			*param = noiseFilter->refractoryPeriodEnabled;
+			break;
+
+		case CAER_FILTER_DVS_REFRACTORY_PERIOD_TIME:
+			*param = U64T(noiseFilter->refractoryPeriodTime);
+			break;
+
+		case CAER_FILTER_DVS_REFRACTORY_PERIOD_STATISTICS:
+			*param = noiseFilter->refractoryPeriodStatistics;
+			break;
+
+		case CAER_FILTER_DVS_RESET:
+			*param = false;
+			break;
+
+		case CAER_FILTER_DVS_HOTPIXEL_ENABLE:
+			*param = noiseFilter->hotPixelEnabled;
+			break;
+
+		case CAER_FILTER_DVS_HOTPIXEL_LEARN:
+			*param = noiseFilter->hotPixelLearn;
+			break;
+
+		case CAER_FILTER_DVS_HOTPIXEL_TIME:
+			*param = U64T(noiseFilter->hotPixelLearnTime);
+			break;
+
+		case CAER_FILTER_DVS_HOTPIXEL_COUNT:
+			*param = noiseFilter->hotPixelLearnCount;
+			break;
+
+		case CAER_FILTER_DVS_HOTPIXEL_STATISTICS:
+			*param = noiseFilter->hotPixelStatistics;
+			break;
+
+		default:
+			return (false);
+			break;
+	}
+
+	return (true);
+}
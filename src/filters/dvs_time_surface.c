@@ -0,0 +1,315 @@
+#include "filters/dvs_time_surface.h"
+#include "../portable_aligned_alloc.h"
+
+// Alignment specification support (with defines for cache line alignment).
+#if !defined(CACHELINE_SIZE)
+#define CACHELINE_SIZE 64 // Default (big enough for most processors), must be power of two!
+#endif
+
+// Timestamps are stored in square tiles of 8x8 pixels, one tile per polarity,
+// so that one row of a tile (8 x 64bit timestamps) fills exactly one cache
+// line. The two polarity tiles for the same pixels follow each other.
+#define TS_MAP_TILE_SHIFT 3
+#define TS_MAP_TILE_SIZE  (1U << TS_MAP_TILE_SHIFT)
+#define TS_MAP_TILE_MASK  (TS_MAP_TILE_SIZE - 1)
+
+// Events are processed in batches: first all addresses and timestamps in a
+// batch are decoded, in a tight, branch-free loop the compiler can vectorize,
+// then they are all stored. Invalid and out of range events are stored to an
+// extra, never read, entry at the end of the map, so storing never branches.
+#define UPDATE_BATCH_SIZE 64
+
+// Time surface export: exp(-x) is computed as 2^(-x * log2(e)), splitting the
+// exponent into integer and fractional parts. The integer part goes directly
+// into the float exponent bits, the fractional one is approximated by a
+// polynomial. Both are branch-free, so the loop can be vectorized (unlike
+// calls to expf()). The polynomial's relative error is below 3e-7; rounding
+// the exponent to float adds to that as it grows, for a total below 1e-6 up
+// to 16 decay times back, and below 1e-5 over the whole exported range.
+#define EXPORT_LOG2E     1.44269504f
+#define EXPORT_MAX_SHIFT 124.0f
+
+struct caer_filter_dvs_time_surface {
+	// Maximum resolution.
+	uint16_t sizeX;
+	uint16_t sizeY;
+	// Timestamp of latest event.
+	int64_t lastTimestamp;
+	// Tiled per-pixel, per-polarity timestamp map.
+	size_t timestampsMapTilesX;
+	size_t timestampsMapLength;
+	int64_t *timestampsMap;
+};
+
+static inline size_t timestampsMapIndex(size_t tilesX, uint32_t x, uint32_t y, uint32_t polarity) {
+	size_t tileIndex = ((size_t) (y >> TS_MAP_TILE_SHIFT) * tilesX) + (size_t) (x >> TS_MAP_TILE_SHIFT);
+
+	return (((((tileIndex << 1) | polarity)) << (2 * TS_MAP_TILE_SHIFT))
+			| (size_t) ((y & TS_MAP_TILE_MASK) << TS_MAP_TILE_SHIFT) | (size_t) (x & TS_MAP_TILE_MASK));
+}
+
+static inline int64_t timestampsMapGet(const caerFilterDVSTimeSurface surface, uint32_t x, uint32_t y,
+	enum caer_filter_dvs_time_surface_polarity polarity) {
+	size_t tilesX = surface->timestampsMapTilesX;
+
+	if (polarity == CAER_FILTER_DVS_TIME_SURFACE_BOTH) {
+		int64_t off = surface->timestampsMap[timestampsMapIndex(tilesX, x, y, 0)];
+		int64_t on = surface->timestampsMap[timestampsMapIndex(tilesX, x, y, 1)];
+
+		return ((on > off) ? (on) : (off));
+	}
+
+	return (surface->timestampsMap[timestampsMapIndex(tilesX, x, y, polarity)]);
+}
+
+caerFilterDVSTimeSurface caerFilterDVSTimeSurfaceInitialize(uint16_t sizeX, uint16_t sizeY) {
+	if ((sizeX == 0) || (sizeY == 0)) {
+		return (NULL);
+	}
+
+	caerFilterDVSTimeSurface surface = calloc(1, sizeof(*surface));
+	if (surface == NULL) {
+		caerLog(CAER_LOG_CRITICAL, "DVS Time Surface", "Failed to allocate memory for time surface. Error: %d.", errno);
+		return (NULL);
+	}
+
+	surface->sizeX = sizeX;
+	surface->sizeY = sizeY;
+
+	// Rounded up to full tiles, two polarities.
+	surface->timestampsMapTilesX = ((size_t) sizeX + TS_MAP_TILE_MASK) >> TS_MAP_TILE_SHIFT;
+	size_t tilesY = ((size_t) sizeY + TS_MAP_TILE_MASK) >> TS_MAP_TILE_SHIFT;
+
+	surface->timestampsMapLength = surface->timestampsMapTilesX * tilesY * 2 * TS_MAP_TILE_SIZE * TS_MAP_TILE_SIZE;
+
+	// One more entry at the end, to store unused events to.
+	surface->timestampsMap = portable_aligned_alloc(CACHELINE_SIZE,
+		(surface->timestampsMapLength + 1) * sizeof(int64_t));
+	if (surface->timestampsMap == NULL) {
+		caerLog(CAER_LOG_CRITICAL, "DVS Time Surface",
+			"Failed to allocate memory for timestamps map of %" PRIu16 "x%" PRIu16 " pixels. Error: %d.", sizeX, sizeY,
+			errno);
+
+		free(surface);
+		return (NULL);
+	}
+
+	caerFilterDVSTimeSurfaceReset(surface);
+
+	return (surface);
+}
+
+void caerFilterDVSTimeSurfaceDestroy(caerFilterDVSTimeSurface surface) {
+	if (surface == NULL) {
+		return;
+	}
+
+	portable_aligned_free(surface->timestampsMap);
+
+	free(surface);
+}
+
+void caerFilterDVSTimeSurfaceReset(caerFilterDVSTimeSurface surface) {
+	if (surface == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i <= surface->timestampsMapLength; i++) {
+		surface->timestampsMap[i] = CAER_FILTER_DVS_TIME_SURFACE_EMPTY;
+	}
+
+	surface->lastTimestamp = CAER_FILTER_DVS_TIME_SURFACE_EMPTY;
+}
+
+void caerFilterDVSTimeSurfaceUpdate(caerFilterDVSTimeSurface surface, caerPolarityEventPacketConst polarity) {
+	if ((surface == NULL) || (polarity == NULL)) {
+		return;
+	}
+
+	int32_t eventNumber = caerEventPacketHeaderGetEventNumber(&polarity->packetHeader);
+
+	int64_t *timestampsMap = surface->timestampsMap;
+	size_t unusedIndex = surface->timestampsMapLength;
+	size_t tilesX = surface->timestampsMapTilesX;
+	uint32_t sizeX = surface->sizeX;
+	uint32_t sizeY = surface->sizeY;
+	int64_t lastTimestamp = surface->lastTimestamp;
+
+	uint8_t batchUse[UPDATE_BATCH_SIZE];
+	size_t batchIndex[UPDATE_BATCH_SIZE];
+	int64_t batchTimestamp[UPDATE_BATCH_SIZE];
+
+	for (int32_t batchStart = 0; batchStart < eventNumber; batchStart += UPDATE_BATCH_SIZE) {
+		size_t batchSize = (size_t) (eventNumber - batchStart);
+		if (batchSize > UPDATE_BATCH_SIZE) {
+			batchSize = UPDATE_BATCH_SIZE;
+		}
+
+		caerPolarityEventConst events = polarity->events + batchStart;
+
+		// Decode pass: no branches and no writes to shared state.
+		for (size_t i = 0; i < batchSize; i++) {
+			uint32_t data = le32toh(events[i].data);
+			uint32_t x = (data >> POLARITY_X_ADDR_SHIFT) & POLARITY_X_ADDR_MASK;
+			uint32_t y = (data >> POLARITY_Y_ADDR_SHIFT) & POLARITY_Y_ADDR_MASK;
+			uint32_t pol = (data >> POLARITY_SHIFT) & POLARITY_MASK;
+
+			uint32_t inRange = (uint32_t) (x < sizeX) & (uint32_t) (y < sizeY);
+
+			batchUse[i] = U8T((data >> VALID_MARK_SHIFT) & VALID_MARK_MASK & inRange);
+
+			batchIndex[i] = (batchUse[i]) ? (timestampsMapIndex(tilesX, x, y, pol)) : (unusedIndex);
+			batchTimestamp[i] = caerPolarityEventGetTimestamp64(&events[i], polarity);
+		}
+
+		// Store pass: in order, so later events on the same pixel win.
+		for (size_t i = 0; i < batchSize; i++) {
+			timestampsMap[batchIndex[i]] = batchTimestamp[i];
+			lastTimestamp = (batchUse[i]) ? (batchTimestamp[i]) : (lastTimestamp);
+		}
+	}
+
+	surface->lastTimestamp = lastTimestamp;
+}
+
+int64_t caerFilterDVSTimeSurfaceGetLastTimestamp(caerFilterDVSTimeSurface surface) {
+	if (surface == NULL) {
+		return (CAER_FILTER_DVS_TIME_SURFACE_EMPTY);
+	}
+
+	return (surface->lastTimestamp);
+}
+
+int64_t caerFilterDVSTimeSurfaceGetTimestamp(caerFilterDVSTimeSurface surface, uint16_t x, uint16_t y,
+	enum caer_filter_dvs_time_surface_polarity polarity) {
+	if ((surface == NULL) || (x >= surface->sizeX) || (y >= surface->sizeY)
+		|| (polarity > CAER_FILTER_DVS_TIME_SURFACE_BOTH)) {
+		return (CAER_FILTER_DVS_TIME_SURFACE_EMPTY);
+	}
+
+	return (timestampsMapGet(surface, x, y, polarity));
+}
+
+void caerFilterDVSTimeSurfaceGetNeighborhood(caerFilterDVSTimeSurface surface, uint16_t x, uint16_t y, uint8_t radius,
+	enum caer_filter_dvs_time_surface_polarity polarity, int64_t *timestamps) {
+	if ((surface == NULL) || (timestamps == NULL)) {
+		return;
+	}
+
+	size_t side = (2 * (size_t) radius) + 1;
+
+	if (polarity > CAER_FILTER_DVS_TIME_SURFACE_BOTH) {
+		for (size_t i = 0; i < (side * side); i++) {
+			timestamps[i] = CAER_FILTER_DVS_TIME_SURFACE_EMPTY;
+		}
+
+		return;
+	}
+
+	int32_t startX = I32T(x) - radius;
+	int32_t startY = I32T(y) - radius;
+
+	for (size_t row = 0; row < side; row++) {
+		int32_t nY = startY + I32T(row);
+
+		for (size_t col = 0; col < side; col++) {
+			int32_t nX = startX + I32T(col);
+
+			if ((nX < 0) || (nX >= surface->sizeX) || (nY < 0) || (nY >= surface->sizeY)) {
+				timestamps[(row * side) + col] = CAER_FILTER_DVS_TIME_SURFACE_EMPTY;
+			}
+			else {
+				timestamps[(row * side) + col] = timestampsMapGet(surface, U32T(nX), U32T(nY), polarity);
+			}
+		}
+	}
+}
+
+// All selections are done on integers (and on the float result's bits), since
+// compilers won't if-convert float selects with the default -ftrapping-math.
+static inline float timeSurfaceDecay(int64_t lastTimestamp, int64_t timestamp, float decayScale, int32_t maxTimeDiff) {
+	int64_t timeDiff = timestamp - lastTimestamp;
+
+	// Time differences outside of [0, maxTimeDiff] decay to zero, as do empty
+	// pixels, even if 'timestamp' is itself CAER_FILTER_DVS_TIME_SURFACE_EMPTY.
+	// Masking to 32bit before converting to float, as such conversions vectorize well.
+	uint32_t valid = (uint32_t) ((timeDiff >= 0) & (timeDiff <= maxTimeDiff)
+		& (lastTimestamp != CAER_FILTER_DVS_TIME_SURFACE_EMPTY));
+	int32_t timeDiff32 = (int32_t) (timeDiff & -(int64_t) valid);
+
+	float exponent = (float) timeDiff32 * decayScale;
+
+	// 2^-exponent = 2^-(n + 1) * 2^(1 - fraction), with (1 - fraction) in (0, 1].
+	int32_t n = (int32_t) exponent;
+	float u = 1.0f - (exponent - (float) n);
+
+	float pow2u = 1.0f
+				  + (u
+					  * (0.6931530732f
+						  + (u * (0.2401536210f + (u * (0.0558263180f + (u * (0.0089893397f + (u * 0.0018775767f)))))))));
+
+	uint32_t scaleBits = U32T(127 - (n + 1)) << 23;
+	float scale;
+	memcpy(&scale, &scaleBits, sizeof(float));
+
+	float result = pow2u * scale;
+	uint32_t resultBits;
+	memcpy(&resultBits, &result, sizeof(float));
+
+	resultBits &= -valid;
+	memcpy(&result, &resultBits, sizeof(float));
+
+	return (result);
+}
+
+bool caerFilterDVSTimeSurfaceExport(caerFilterDVSTimeSurface surface, int64_t timestamp, float decayTime,
+	enum caer_filter_dvs_time_surface_polarity polarity, float *surfaceOut) {
+	if ((surface == NULL) || (surfaceOut == NULL) || (!(decayTime > 0.0f))
+		|| (polarity > CAER_FILTER_DVS_TIME_SURFACE_BOTH)) {
+		return (false);
+	}
+
+	float decayScale = EXPORT_LOG2E / decayTime;
+
+	// Limit time differences so that the exponent stays in the normal float range.
+	double maxTimeDiff = (double) EXPORT_MAX_SHIFT / (double) decayScale;
+	int32_t maxTimeDiff32 = (maxTimeDiff > (double) INT32_MAX) ? (INT32_MAX) : ((int32_t) maxTimeDiff);
+	size_t tilesX = surface->timestampsMapTilesX;
+	size_t sizeX = surface->sizeX;
+
+	for (uint32_t y = 0; y < surface->sizeY; y++) {
+		float *outRow = surfaceOut + (y * sizeX);
+
+		// Walk one tile row at a time: 8 consecutive timestamps for each polarity.
+		for (size_t tileX = 0; tileX < tilesX; tileX++) {
+			uint32_t x = U32T(tileX << TS_MAP_TILE_SHIFT);
+			const int64_t *offRow = surface->timestampsMap + timestampsMapIndex(tilesX, x, y, 0);
+			const int64_t *onRow = surface->timestampsMap + timestampsMapIndex(tilesX, x, y, 1);
+
+			size_t length = sizeX - x;
+			if (length > TS_MAP_TILE_SIZE) {
+				length = TS_MAP_TILE_SIZE;
+			}
+
+			float tileOut[TS_MAP_TILE_SIZE];
+
+			if (polarity == CAER_FILTER_DVS_TIME_SURFACE_BOTH) {
+				for (size_t i = 0; i < TS_MAP_TILE_SIZE; i++) {
+					int64_t last = (onRow[i] > offRow[i]) ? (onRow[i]) : (offRow[i]);
+					tileOut[i] = timeSurfaceDecay(last, timestamp, decayScale, maxTimeDiff32);
+				}
+			}
+			else {
+				const int64_t *row = (polarity == CAER_FILTER_DVS_TIME_SURFACE_ON) ? (onRow) : (offRow);
+
+				for (size_t i = 0; i < TS_MAP_TILE_SIZE; i++) {
+					tileOut[i] = timeSurfaceDecay(row[i], timestamp, decayScale, maxTimeDiff32);
+				}
+			}
+
+			memcpy(outRow + x, tileOut, length * sizeof(float));
+		}
+	}
+
+	return (true);
+}
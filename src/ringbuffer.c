@@ -117,3 +117,180 @@ void *caerRingBufferLook(caerRingBuffer rBuf) {
 	// Else, buffer is empty.
 	return (NULL);
 }
+
+size_t caerRingBufferPutBatch(caerRingBuffer rBuf, void *const *elems, size_t elemsNumber) {
+	if (elemsNumber > rBuf->size) {
+		elemsNumber = rBuf->size;
+	}
+
+	for (size_t i = 0; i < elemsNumber; i++) {
+		if (elems[i] == NULL) {
+			// NULL elements are disallowed (used as place-holders).
+			// Critical error, should never happen -> exit!
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	// Count the free places first, stopping at the first one still in use.
+	// Every place must be checked on its own: the consumer's batched NULL
+	// stores may become visible out of order, so a free place further on
+	// doesn't mean the ones before it are free already.
+	size_t freeNumber = 0;
+
+	while ((freeNumber < elemsNumber)
+		&& (atomic_load_explicit(&rBuf->elements[(rBuf->putPos + freeNumber) & (rBuf->size - 1)],
+				memory_order_relaxed)
+			== (uintptr_t) NULL)) {
+		freeNumber++;
+	}
+
+	if (freeNumber == 0) {
+		// Buffer is full.
+		return (0);
+	}
+
+	// One fence for all: the consumer is done with the places we saw free,
+	// and sees the new elements complete once it sees them non-NULL.
+	atomic_thread_fence(memory_order_acq_rel);
+
+	for (size_t i = 0; i < freeNumber; i++) {
+		atomic_store_explicit(&rBuf->elements[rBuf->putPos], (uintptr_t) elems[i], memory_order_relaxed);
+
+		// Increase local put pointer.
+		rBuf->putPos = ((rBuf->putPos + 1) & (rBuf->size - 1));
+	}
+
+	return (freeNumber);
+}
+
+size_t caerRingBufferGetBatch(caerRingBuffer rBuf, void **elems, size_t elemsMax) {
+	// Collect elements until the first empty place, which is where the
+	// producer is going to put the next one.
+	size_t getNumber = 0;
+
+	while ((getNumber < elemsMax) && (getNumber < rBuf->size)) {
+		size_t pos = ((rBuf->getPos + getNumber) & (rBuf->size - 1));
+
+		void *curr = (void *) atomic_load_explicit(&rBuf->elements[pos], memory_order_relaxed);
+		if (curr == NULL) {
+			break;
+		}
+
+		elems[getNumber] = curr;
+		getNumber++;
+	}
+
+	if (getNumber == 0) {
+		// Buffer is empty.
+		return (0);
+	}
+
+	// One fence for all: the elements we got are complete, and the producer
+	// only reuses their places after we're done with them.
+	atomic_thread_fence(memory_order_acq_rel);
+
+	for (size_t i = 0; i < getNumber; i++) {
+		atomic_store_explicit(&rBuf->elements[rBuf->getPos], (uintptr_t) NULL, memory_order_relaxed);
+
+		// Increase local get pointer.
+		rBuf->getPos = ((rBuf->getPos + 1) & (rBuf->size - 1));
+	}
+
+	return (getNumber);
+}
+
+struct caer_stream_ring_buffer {
+	// Producer side: own position, and last seen consumer position.
+	alignas(CACHELINE_SIZE) atomic_size_t writePos;
+	size_t readPosCache;
+	// Consumer side: own position, and last seen producer position.
+	alignas(CACHELINE_SIZE) atomic_size_t readPos;
+	size_t writePosCache;
+	alignas(CACHELINE_SIZE) size_t size;
+	size_t elementSize;
+	alignas(CACHELINE_SIZE) uint8_t elements[];
+};
+
+caerStreamRingBuffer caerStreamRingBufferInit(size_t size, size_t elementSize) {
+	// Force multiple of two size for performance.
+	if ((size == 0) || ((size & (size - 1)) != 0) || (elementSize == 0)) {
+		return (NULL);
+	}
+
+	if (size > ((SIZE_MAX - sizeof(struct caer_stream_ring_buffer)) / elementSize)) {
+		return (NULL);
+	}
+
+	caerStreamRingBuffer rBuf = portable_aligned_alloc(CACHELINE_SIZE,
+		sizeof(struct caer_stream_ring_buffer) + (size * elementSize));
+	if (rBuf == NULL) {
+		return (NULL);
+	}
+
+	// Initialize counter variables.
+	atomic_store_explicit(&rBuf->writePos, 0, memory_order_relaxed);
+	rBuf->readPosCache = 0;
+	atomic_store_explicit(&rBuf->readPos, 0, memory_order_relaxed);
+	rBuf->writePosCache = 0;
+	rBuf->size = size;
+	rBuf->elementSize = elementSize;
+
+	atomic_thread_fence(memory_order_release);
+
+	return (rBuf);
+}
+
+void caerStreamRingBufferFree(caerStreamRingBuffer rBuf) {
+	portable_aligned_free(rBuf);
+}
+
+void *caerStreamRingBufferReserve(caerStreamRingBuffer rBuf, size_t *length) {
+	// Positions only ever increase, and are masked on access.
+	size_t writePos = atomic_load_explicit(&rBuf->writePos, memory_order_relaxed);
+	size_t writeIdx = writePos & (rBuf->size - 1);
+
+	size_t spaceToEnd = rBuf->size - writeIdx;
+	size_t space = rBuf->size - (writePos - rBuf->readPosCache);
+
+	// Only get the consumer's position again if the last one seen limits us.
+	if (space < spaceToEnd) {
+		rBuf->readPosCache = atomic_load_explicit(&rBuf->readPos, memory_order_acquire);
+		space = rBuf->size - (writePos - rBuf->readPosCache);
+	}
+
+	*length = (space < spaceToEnd) ? (space) : (spaceToEnd);
+
+	return (&rBuf->elements[writeIdx * rBuf->elementSize]);
+}
+
+void caerStreamRingBufferCommit(caerStreamRingBuffer rBuf, size_t length) {
+	size_t writePos = atomic_load_explicit(&rBuf->writePos, memory_order_relaxed);
+
+	// Publish the new elements to the consumer.
+	atomic_store_explicit(&rBuf->writePos, writePos + length, memory_order_release);
+}
+
+const void *caerStreamRingBufferPeek(caerStreamRingBuffer rBuf, size_t *length) {
+	size_t readPos = atomic_load_explicit(&rBuf->readPos, memory_order_relaxed);
+	size_t readIdx = readPos & (rBuf->size - 1);
+
+	size_t availableToEnd = rBuf->size - readIdx;
+	size_t available = rBuf->writePosCache - readPos;
+
+	// Only get the producer's position again if the last one seen limits us.
+	if (available < availableToEnd) {
+		rBuf->writePosCache = atomic_load_explicit(&rBuf->writePos, memory_order_acquire);
+		available = rBuf->writePosCache - readPos;
+	}
+
+	*length = (available < availableToEnd) ? (available) : (availableToEnd);
+
+	return (&rBuf->elements[readIdx * rBuf->elementSize]);
+}
+
+void caerStreamRingBufferRelease(caerStreamRingBuffer rBuf, size_t length) {
+	size_t readPos = atomic_load_explicit(&rBuf->readPos, memory_order_relaxed);
+
+	// Give the space back to the producer, after we're done reading it.
+	atomic_store_explicit(&rBuf->readPos, readPos + length, memory_order_release);
+}
@@ -0,0 +1,521 @@
+#include "stream_merger.h"
+
+// Initial number of containers each queue can hold, grows as needed.
+#define CONTAINER_QUEUE_INITIAL_SIZE 16
+
+struct container_queue {
+	caerEventPacketContainer *elements;
+	size_t size;
+	size_t head;
+	size_t length;
+};
+
+struct stream_merger_input {
+	struct container_queue queue;
+	// Highest timestamp pushed so far, -1 if none.
+	int64_t lastTimestamp;
+	bool ended;
+	caerDeviceHandle device;
+};
+
+struct caer_stream_merger {
+	int64_t reorderWindow;
+	// First and most recent timestamps pushed on any input, -1 if none.
+	int64_t firstTimestamp;
+	int64_t newestTimestamp;
+	// Highest timestamp returned so far, -1 if none.
+	int64_t emittedTimestamp;
+	// Containers that arrived too late to be ordered, passed through first.
+	struct container_queue lateQueue;
+	uint64_t lateContainers;
+	// Min-heap of inputs with queued containers, by lowest timestamp of the first one.
+	size_t *heap;
+	size_t heapLength;
+	size_t inputsNumber;
+	struct stream_merger_input inputs[];
+};
+
+static bool containerQueuePut(struct container_queue *queue, caerEventPacketContainer container);
+static caerEventPacketContainer containerQueueGet(struct container_queue *queue);
+static void containerQueueFree(struct container_queue *queue);
+static int64_t streamMergerHeadTimestamp(caerStreamMerger merger, size_t input);
+static void streamMergerHeapSiftUp(caerStreamMerger merger, size_t pos);
+static void streamMergerHeapSiftDown(caerStreamMerger merger, size_t pos);
+static int64_t streamMergerSafeTimestamp(caerStreamMerger merger);
+static caerEventPacketContainer streamMergerSplit(caerEventPacketContainer container, int64_t splitTimestamp);
+static caerEventPacketHeader streamMergerPacketCopyRest(caerEventPacketHeaderConst packet, int32_t splitIndex);
+static void streamMergerPacketTruncate(caerEventPacketHeader packet, int32_t splitIndex, int32_t restValid);
+
+static bool containerQueuePut(struct container_queue *queue, caerEventPacketContainer container) {
+	if (queue->length == queue->size) {
+		size_t newSize = (queue->size == 0) ? (CONTAINER_QUEUE_INITIAL_SIZE) : (queue->size * 2);
+
+		caerEventPacketContainer *newElements = malloc(newSize * sizeof(caerEventPacketContainer));
+		if (newElements == NULL) {
+			return (false);
+		}
+
+		// Unroll circular buffer into new memory.
+		for (size_t i = 0; i < queue->length; i++) {
+			newElements[i] = queue->elements[(queue->head + i) % queue->size];
+		}
+
+		free(queue->elements);
+
+		queue->elements = newElements;
+		queue->size = newSize;
+		queue->head = 0;
+	}
+
+	queue->elements[(queue->head + queue->length) % queue->size] = container;
+	queue->length++;
+
+	return (true);
+}
+
+static caerEventPacketContainer containerQueueGet(struct container_queue *queue) {
+	if (queue->length == 0) {
+		return (NULL);
+	}
+
+	caerEventPacketContainer container = queue->elements[queue->head];
+
+	queue->head = (queue->head + 1) % queue->size;
+	queue->length--;
+
+	return (container);
+}
+
+static void containerQueueFree(struct container_queue *queue) {
+	caerEventPacketContainer container;
+
+	while ((container = containerQueueGet(queue)) != NULL) {
+		caerEventPacketContainerFree(container);
+	}
+
+	free(queue->elements);
+}
+
+caerStreamMerger caerStreamMergerInitialize(size_t inputsNumber, int64_t reorderWindow) {
+	if ((inputsNumber == 0) || (reorderWindow <= 0)) {
+		return (NULL);
+	}
+
+	caerStreamMerger merger = calloc(1, sizeof(*merger) + (inputsNumber * sizeof(struct stream_merger_input)));
+	if (merger == NULL) {
+		caerLog(CAER_LOG_CRITICAL, "Stream Merger", "Failed to allocate memory for stream merger. Error: %d.", errno);
+		return (NULL);
+	}
+
+	merger->heap = calloc(inputsNumber, sizeof(size_t));
+	if (merger->heap == NULL) {
+		caerLog(CAER_LOG_CRITICAL, "Stream Merger", "Failed to allocate memory for stream merger heap. Error: %d.",
+			errno);
+
+		free(merger);
+		return (NULL);
+	}
+
+	merger->inputsNumber = inputsNumber;
+	merger->reorderWindow = reorderWindow;
+	merger->firstTimestamp = -1;
+	merger->newestTimestamp = -1;
+	merger->emittedTimestamp = -1;
+
+	for (size_t i = 0; i < inputsNumber; i++) {
+		merger->inputs[i].lastTimestamp = -1;
+	}
+
+	return (merger);
+}
+
+void caerStreamMergerDestroy(caerStreamMerger merger) {
+	if (merger == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < merger->inputsNumber; i++) {
+		containerQueueFree(&merger->inputs[i].queue);
+	}
+
+	containerQueueFree(&merger->lateQueue);
+
+	free(merger->heap);
+	free(merger);
+}
+
+static int64_t streamMergerHeadTimestamp(caerStreamMerger merger, size_t input) {
+	const struct container_queue *queue = &merger->inputs[input].queue;
+
+	return (caerEventPacketContainerGetLowestEventTimestamp(queue->elements[queue->head]));
+}
+
+static void streamMergerHeapSiftUp(caerStreamMerger merger, size_t pos) {
+	while (pos > 0) {
+		size_t parent = (pos - 1) / 2;
+
+		if (streamMergerHeadTimestamp(merger, merger->heap[parent])
+			<= streamMergerHeadTimestamp(merger, merger->heap[pos])) {
+			break;
+		}
+
+		size_t tmp = merger->heap[parent];
+		merger->heap[parent] = merger->heap[pos];
+		merger->heap[pos] = tmp;
+
+		pos = parent;
+	}
+}
+
+static void streamMergerHeapSiftDown(caerStreamMerger merger, size_t pos) {
+	while (true) {
+		size_t smallest = pos;
+		size_t left = (2 * pos) + 1;
+		size_t right = (2 * pos) + 2;
+
+		if ((left < merger->heapLength)
+			&& (streamMergerHeadTimestamp(merger, merger->heap[left])
+				   < streamMergerHeadTimestamp(merger, merger->heap[smallest]))) {
+			smallest = left;
+		}
+
+		if ((right < merger->heapLength)
+			&& (streamMergerHeadTimestamp(merger, merger->heap[right])
+				   < streamMergerHeadTimestamp(merger, merger->heap[smallest]))) {
+			smallest = right;
+		}
+
+		if (smallest == pos) {
+			break;
+		}
+
+		size_t tmp = merger->heap[smallest];
+		merger->heap[smallest] = merger->heap[pos];
+		merger->heap[pos] = tmp;
+
+		pos = smallest;
+	}
+}
+
+bool caerStreamMergerPush(caerStreamMerger merger, size_t input, caerEventPacketContainer container) {
+	if ((merger == NULL) || (input >= merger->inputsNumber)) {
+		caerEventPacketContainerFree(container);
+		return (false);
+	}
+
+	// Nothing to order in empty containers.
+	if ((container == NULL) || (caerEventPacketContainerGetEventsNumber(container) == 0)) {
+		caerEventPacketContainerFree(container);
+		return (true);
+	}
+
+	struct stream_merger_input *in = &merger->inputs[input];
+
+	int64_t lowestTimestamp = caerEventPacketContainerGetLowestEventTimestamp(container);
+	int64_t highestTimestamp = caerEventPacketContainerGetHighestEventTimestamp(container);
+
+	// Too late to put in order: newer events were already returned.
+	bool late = (lowestTimestamp < merger->emittedTimestamp);
+
+	bool success = containerQueuePut((late) ? (&merger->lateQueue) : (&in->queue), container);
+	if (!success) {
+		caerLog(CAER_LOG_ERROR, "Stream Merger", "Failed to allocate memory for queue of input %zu. Error: %d.",
+			input, errno);
+
+		caerEventPacketContainerFree(container);
+		return (false);
+	}
+
+	if (late) {
+		merger->lateContainers++;
+	}
+	else if (in->queue.length == 1) {
+		// Queue was empty, input enters the heap.
+		merger->heap[merger->heapLength] = input;
+		merger->heapLength++;
+
+		streamMergerHeapSiftUp(merger, merger->heapLength - 1);
+	}
+
+	if (highestTimestamp > in->lastTimestamp) {
+		in->lastTimestamp = highestTimestamp;
+	}
+
+	if (merger->firstTimestamp == -1) {
+		merger->firstTimestamp = lowestTimestamp;
+	}
+
+	if (highestTimestamp > merger->newestTimestamp) {
+		merger->newestTimestamp = highestTimestamp;
+	}
+
+	return (true);
+}
+
+void caerStreamMergerInputEnd(caerStreamMerger merger, size_t input) {
+	if ((merger == NULL) || (input >= merger->inputsNumber)) {
+		return;
+	}
+
+	merger->inputs[input].ended = true;
+}
+
+// Events up to the returned timestamp are safe to return: all inputs that
+// are still being waited upon already delivered events up to it.
+static int64_t streamMergerSafeTimestamp(caerStreamMerger merger) {
+	int64_t safeTimestamp = INT64_MAX;
+
+	for (size_t i = 0; i < merger->inputsNumber; i++) {
+		const struct stream_merger_input *in = &merger->inputs[i];
+
+		if (in->ended) {
+			continue;
+		}
+
+		// Inputs without any data yet lag since the very first event.
+		int64_t reference = (in->lastTimestamp == -1) ? (merger->firstTimestamp) : (in->lastTimestamp);
+
+		if ((merger->newestTimestamp - reference) > merger->reorderWindow) {
+			continue;
+		}
+
+		if (in->lastTimestamp < safeTimestamp) {
+			safeTimestamp = in->lastTimestamp;
+		}
+	}
+
+	return (safeTimestamp);
+}
+
+caerEventPacketContainer caerStreamMergerPop(caerStreamMerger merger) {
+	if (merger == NULL) {
+		return (NULL);
+	}
+
+	// Late containers can't be ordered anyway, get rid of them first.
+	caerEventPacketContainer lateContainer = containerQueueGet(&merger->lateQueue);
+	if (lateContainer != NULL) {
+		return (lateContainer);
+	}
+
+	if (merger->heapLength == 0) {
+		return (NULL);
+	}
+
+	size_t input = merger->heap[0];
+	struct container_queue *queue = &merger->inputs[input].queue;
+	caerEventPacketContainer head = queue->elements[queue->head];
+
+	int64_t safeTimestamp = streamMergerSafeTimestamp(merger);
+
+	if (caerEventPacketContainerGetLowestEventTimestamp(head) > safeTimestamp) {
+		return (NULL);
+	}
+
+	// Events up to the next input's first event, or up to the safe point,
+	// can be returned without any other events going in between.
+	int64_t splitTimestamp = safeTimestamp;
+
+	for (size_t i = 1; (i <= 2) && (i < merger->heapLength); i++) {
+		int64_t nextTimestamp = streamMergerHeadTimestamp(merger, merger->heap[i]);
+
+		if (nextTimestamp < splitTimestamp) {
+			splitTimestamp = nextTimestamp;
+		}
+	}
+
+	caerEventPacketContainer result = NULL;
+
+	if (caerEventPacketContainerGetHighestEventTimestamp(head) <= splitTimestamp) {
+		// Whole container fits, pass it through unchanged.
+		result = containerQueueGet(queue);
+	}
+	else {
+		result = streamMergerSplit(head, splitTimestamp);
+
+		if (result == NULL) {
+			// Keep data flowing, even if out of order.
+			caerLog(CAER_LOG_ERROR, "Stream Merger",
+				"Failed to split container of input %zu, returning it whole instead.", input);
+
+			result = containerQueueGet(queue);
+		}
+	}
+
+	// First container of the input changed: re-sort heap.
+	if (queue->length == 0) {
+		merger->heapLength--;
+		merger->heap[0] = merger->heap[merger->heapLength];
+	}
+
+	streamMergerHeapSiftDown(merger, 0);
+
+	int64_t resultTimestamp = caerEventPacketContainerGetHighestEventTimestamp(result);
+	if (resultTimestamp > merger->emittedTimestamp) {
+		merger->emittedTimestamp = resultTimestamp;
+	}
+
+	return (result);
+}
+
+// Move all events up to and including 'splitTimestamp' out of the given
+// container, into a newly allocated one. On failure, nothing is changed.
+static caerEventPacketContainer streamMergerSplit(caerEventPacketContainer container, int64_t splitTimestamp) {
+	int32_t packetsNumber = caerEventPacketContainerGetEventPacketsNumber(container);
+
+	caerEventPacketContainer first = caerEventPacketContainerAllocate(packetsNumber);
+	int32_t *splitIndexes = calloc((size_t) packetsNumber, sizeof(int32_t));
+	caerEventPacketHeader *rests = calloc((size_t) packetsNumber, sizeof(caerEventPacketHeader));
+
+	bool success = ((first != NULL) && (splitIndexes != NULL) && (rests != NULL));
+
+	// First find where to split each packet, and copy out the parts after the
+	// split, without changing anything yet.
+	for (int32_t i = 0; success && (i < packetsNumber); i++) {
+		caerEventPacketHeader packet = caerEventPacketContainerGetEventPacket(container, i);
+		if (packet == NULL) {
+			continue;
+		}
+
+		// Events are ordered by timestamp, find the first one after the split.
+		// Unsigned indexes, so the compiler need not assume anything about
+		// signed overflow in 'mid + 1'.
+		size_t eventNumber = (size_t) caerEventPacketHeaderGetEventNumber(packet);
+		size_t low = 0;
+		size_t high = eventNumber;
+
+		while (low < high) {
+			size_t mid = low + ((high - low) / 2);
+
+			if (caerGenericEventGetTimestamp64(caerGenericEventGetEvent(packet, I32T(mid)), packet)
+				<= splitTimestamp) {
+				low = mid + 1;
+			}
+			else {
+				high = mid;
+			}
+		}
+
+		splitIndexes[i] = I32T(low);
+
+		if ((low > 0) && (low < eventNumber)) {
+			rests[i] = streamMergerPacketCopyRest(packet, I32T(low));
+			success = (rests[i] != NULL);
+		}
+	}
+
+	if (!success) {
+		if (rests != NULL) {
+			for (int32_t i = 0; i < packetsNumber; i++) {
+				free(rests[i]);
+			}
+		}
+
+		free(rests);
+		free(splitIndexes);
+		free(first);
+
+		return (NULL);
+	}
+
+	// Then move packets (or their first part) to the new container, without copying.
+	for (int32_t i = 0; i < packetsNumber; i++) {
+		if (splitIndexes[i] == 0) {
+			// No events before the split (or no packet), packet stays.
+			continue;
+		}
+
+		caerEventPacketHeader packet = container->eventPackets[i];
+
+		if (rests[i] != NULL) {
+			streamMergerPacketTruncate(packet, splitIndexes[i], caerEventPacketHeaderGetEventValid(rests[i]));
+		}
+
+		first->eventPackets[i] = packet;
+		container->eventPackets[i] = rests[i];
+	}
+
+	free(rests);
+	free(splitIndexes);
+
+	caerEventPacketContainerUpdateStatistics(first);
+	caerEventPacketContainerUpdateStatistics(container);
+
+	return (first);
+}
+
+// Copy the events from 'splitIndex' on into a new, exactly sized packet.
+static caerEventPacketHeader streamMergerPacketCopyRest(caerEventPacketHeaderConst packet, int32_t splitIndex) {
+	int32_t eventSize = caerEventPacketHeaderGetEventSize(packet);
+	int32_t restNumber = caerEventPacketHeaderGetEventNumber(packet) - splitIndex;
+	size_t restMem = (size_t) restNumber * (size_t) eventSize;
+
+	caerEventPacketHeader rest = malloc(CAER_EVENT_PACKET_HEADER_SIZE + restMem);
+	if (rest == NULL) {
+		return (NULL);
+	}
+
+	memcpy(rest, packet, CAER_EVENT_PACKET_HEADER_SIZE);
+	memcpy(((uint8_t *) rest) + CAER_EVENT_PACKET_HEADER_SIZE,
+		((const uint8_t *) packet) + CAER_EVENT_PACKET_HEADER_SIZE + ((size_t) splitIndex * (size_t) eventSize), restMem);
+
+	int32_t restValid = 0;
+	for (int32_t i = 0; i < restNumber; i++) {
+		if (caerGenericEventIsValid(caerGenericEventGetEvent(rest, i))) {
+			restValid++;
+		}
+	}
+
+	caerEventPacketHeaderSetEventCapacity(rest, restNumber);
+	caerEventPacketHeaderSetEventNumber(rest, restNumber);
+	caerEventPacketHeaderSetEventValid(rest, restValid);
+
+	return (rest);
+}
+
+// Drop the events from 'splitIndex' on, in place. The first part of a split
+// packet stays where it is, so only the rest has to be copied.
+static void streamMergerPacketTruncate(caerEventPacketHeader packet, int32_t splitIndex, int32_t restValid) {
+	int32_t eventSize = caerEventPacketHeaderGetEventSize(packet);
+	int32_t restNumber = caerEventPacketHeaderGetEventNumber(packet) - splitIndex;
+
+	// Unused events in a packet are always zeroed out.
+	memset(((uint8_t *) packet) + CAER_EVENT_PACKET_HEADER_SIZE + ((size_t) splitIndex * (size_t) eventSize), 0,
+		(size_t) restNumber * (size_t) eventSize);
+
+	caerEventPacketHeaderSetEventNumber(packet, splitIndex);
+	caerEventPacketHeaderSetEventValid(packet, caerEventPacketHeaderGetEventValid(packet) - restValid);
+}
+
+bool caerStreamMergerAttachDevice(caerStreamMerger merger, size_t input, caerDeviceHandle handle) {
+	if ((merger == NULL) || (input >= merger->inputsNumber)) {
+		return (false);
+	}
+
+	merger->inputs[input].device = handle;
+
+	return (true);
+}
+
+caerEventPacketContainer caerStreamMergerDataGet(caerStreamMerger merger) {
+	caerEventPacketContainer container = caerStreamMergerPop(merger);
+	if ((container != NULL) || (merger == NULL)) {
+		return (container);
+	}
+
+	for (size_t i = 0; i < merger->inputsNumber; i++) {
+		if (merger->inputs[i].device != NULL) {
+			caerStreamMergerPush(merger, i, caerDeviceDataGet(merger->inputs[i].device));
+		}
+	}
+
+	return (caerStreamMergerPop(merger));
+}
+
+uint64_t caerStreamMergerGetLateContainers(caerStreamMerger merger) {
+	if (merger == NULL) {
+		return (0);
+	}
+
+	return (merger->lateContainers);
+}
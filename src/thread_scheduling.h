@@ -0,0 +1,208 @@
+#ifndef LIBCAER_SRC_THREAD_SCHEDULING_H_
+#define LIBCAER_SRC_THREAD_SCHEDULING_H_
+
+#include "libcaer.h"
+#include "devices/device.h"
+#include "timestamps.h"
+#include <stdatomic.h>
+
+#if defined(HAVE_PTHREADS)
+#include "c11threads_posix.h"
+#endif
+
+// Settings for the data acquisition threads (see CAER_HOST_CONFIG_THREAD).
+// Scheduling can only reliably be changed by a thread for itself, so each
+// thread calls threadSchedulingUpdate() regularly, which applies the settings
+// whenever 'generation' moved on since its last call.
+// Up to THREAD_SCHEDULING_MAX_THREADS threads (USB and decode threads) share
+// the settings, each one reports its own results in its slot.
+#define THREAD_SCHEDULING_MAX_THREADS 2
+
+struct thread_scheduling {
+	atomic_uint_fast32_t cpuAffinity;
+	atomic_uint_fast32_t realtimePriority;
+	atomic_int_fast32_t niceValue;
+	atomic_uint_fast32_t generation;
+	atomic_uint_fast32_t status[THREAD_SCHEDULING_MAX_THREADS];
+	atomic_uint_fast32_t failed[THREAD_SCHEDULING_MAX_THREADS];
+};
+
+typedef struct thread_scheduling *threadScheduling;
+
+// Kept by each thread for itself, see threadSchedulingThreadInit().
+struct thread_scheduling_thread {
+	size_t slot;
+	uint32_t generation;
+	uint32_t status;
+	int originalNiceValue;
+};
+
+static inline void threadSchedulingSettingsInit(threadScheduling state) {
+	atomic_store(&state->cpuAffinity, 0);
+	atomic_store(&state->realtimePriority, 0);
+	atomic_store(&state->niceValue, 0);
+	atomic_store(&state->generation, 0);
+
+	for (size_t i = 0; i < THREAD_SCHEDULING_MAX_THREADS; i++) {
+		atomic_store(&state->status[i], 0);
+		atomic_store(&state->failed[i], 0);
+	}
+}
+
+// Called by each thread when it starts, with its own slot. The generation
+// starts at zero so that settings made before are applied right away. The
+// nice value the thread started with is restored when set back to zero.
+static inline void threadSchedulingThreadInit(
+	threadScheduling state, struct thread_scheduling_thread *thread, size_t slot) {
+	thread->slot = slot;
+	thread->generation = 0;
+	thread->status = 0;
+
+	if (thrd_get_priority(&thread->originalNiceValue) != thrd_success) {
+		thread->originalNiceValue = 0;
+	}
+
+	atomic_store(&state->status[slot], 0);
+	atomic_store(&state->failed[slot], 0);
+}
+
+static inline void threadSchedulingUpdate(threadScheduling state, struct thread_scheduling_thread *thread,
+	const char *deviceString, uint8_t deviceLogLevel) {
+	uint32_t generation = U32T(atomic_load_explicit(&state->generation, memory_order_acquire));
+
+	if (generation == thread->generation) {
+		return;
+	}
+
+	thread->generation = generation;
+
+	uint32_t cpuAffinity = U32T(atomic_load(&state->cpuAffinity));
+	uint32_t realtimePriority = U32T(atomic_load(&state->realtimePriority));
+	int32_t niceValue = I32T(atomic_load(&state->niceValue));
+	uint32_t threadStatus = thread->status;
+	uint32_t failed = 0;
+
+	// Settings are only touched if requested, or to undo what was applied
+	// before, so the process' own scheduling is kept otherwise.
+	if ((cpuAffinity != 0) || (threadStatus & CAER_HOST_CONFIG_THREAD_STATUS_AFFINITY)) {
+		if (thrd_set_affinity(cpuAffinity) == thrd_success) {
+			threadStatus = (cpuAffinity != 0) ? (threadStatus | CAER_HOST_CONFIG_THREAD_STATUS_AFFINITY)
+											  : (threadStatus & ~U32T(CAER_HOST_CONFIG_THREAD_STATUS_AFFINITY));
+		}
+		else {
+			failed |= CAER_HOST_CONFIG_THREAD_STATUS_AFFINITY;
+
+			commonLog(CAER_LOG_ERROR, deviceString, deviceLogLevel,
+				"Failed to set CPU affinity of thread to 0x%" PRIX32 ". Error: %d.", cpuAffinity, errno);
+		}
+	}
+
+	if ((realtimePriority != 0) || (threadStatus & CAER_HOST_CONFIG_THREAD_STATUS_REALTIME)) {
+		if (thrd_set_realtime((int) realtimePriority) == thrd_success) {
+			threadStatus = (realtimePriority != 0) ? (threadStatus | CAER_HOST_CONFIG_THREAD_STATUS_REALTIME)
+												   : (threadStatus & ~U32T(CAER_HOST_CONFIG_THREAD_STATUS_REALTIME));
+		}
+		else {
+			failed |= CAER_HOST_CONFIG_THREAD_STATUS_REALTIME;
+
+			commonLog(CAER_LOG_ERROR, deviceString, deviceLogLevel,
+				"Failed to set real-time priority of thread to %" PRIu32 ".", realtimePriority);
+		}
+	}
+
+	// The nice value has no effect on real-time threads. Zero means the
+	// thread's original one, to which it is reset.
+	if ((realtimePriority == 0)
+		&& ((niceValue != 0) || (threadStatus & CAER_HOST_CONFIG_THREAD_STATUS_NICE))) {
+		int applyNiceValue = (niceValue != 0) ? (niceValue) : (thread->originalNiceValue);
+
+		if (thrd_set_priority(applyNiceValue) == thrd_success) {
+			threadStatus = (niceValue != 0) ? (threadStatus | CAER_HOST_CONFIG_THREAD_STATUS_NICE)
+											: (threadStatus & ~U32T(CAER_HOST_CONFIG_THREAD_STATUS_NICE));
+		}
+		else {
+			failed |= CAER_HOST_CONFIG_THREAD_STATUS_NICE;
+
+			commonLog(CAER_LOG_ERROR, deviceString, deviceLogLevel,
+				"Failed to set nice value of thread to %d. Error: %d.", applyNiceValue, errno);
+		}
+	}
+
+	thread->status = threadStatus;
+
+	atomic_store(&state->status[thread->slot], threadStatus);
+	atomic_store(&state->failed[thread->slot], failed);
+}
+
+static inline bool threadSchedulingConfigSet(threadScheduling state, uint8_t paramAddr, uint32_t param) {
+	switch (paramAddr) {
+		case CAER_HOST_CONFIG_THREAD_CPU_AFFINITY:
+			atomic_store(&state->cpuAffinity, param);
+			break;
+
+		case CAER_HOST_CONFIG_THREAD_REALTIME_PRIORITY:
+			if (param > 99) {
+				return (false);
+			}
+
+			atomic_store(&state->realtimePriority, param);
+			break;
+
+		case CAER_HOST_CONFIG_THREAD_NICE:
+			if ((I32T(param) < -20) || (I32T(param) > 19)) {
+				return (false);
+			}
+
+			atomic_store(&state->niceValue, I32T(param));
+			break;
+
+		default:
+			return (false);
+			break;
+	}
+
+	// Threads pick the new settings up on their next update.
+	atomic_fetch_add_explicit(&state->generation, 1, memory_order_release);
+
+	return (true);
+}
+
+static inline bool threadSchedulingConfigGet(threadScheduling state, uint8_t paramAddr, uint32_t *param) {
+	switch (paramAddr) {
+		case CAER_HOST_CONFIG_THREAD_CPU_AFFINITY:
+			*param = U32T(atomic_load(&state->cpuAffinity));
+			break;
+
+		case CAER_HOST_CONFIG_THREAD_REALTIME_PRIORITY:
+			*param = U32T(atomic_load(&state->realtimePriority));
+			break;
+
+		case CAER_HOST_CONFIG_THREAD_NICE:
+			*param = U32T(atomic_load(&state->niceValue));
+			break;
+
+		// Results of all threads together: a setting shows up if it is in
+		// effect on, or failed on, any of them.
+		case CAER_HOST_CONFIG_THREAD_STATUS:
+			*param = 0;
+			for (size_t i = 0; i < THREAD_SCHEDULING_MAX_THREADS; i++) {
+				*param |= U32T(atomic_load(&state->status[i]));
+			}
+			break;
+
+		case CAER_HOST_CONFIG_THREAD_FAILED:
+			*param = 0;
+			for (size_t i = 0; i < THREAD_SCHEDULING_MAX_THREADS; i++) {
+				*param |= U32T(atomic_load(&state->failed[i]));
+			}
+			break;
+
+		default:
+			return (false);
+			break;
+	}
+
+	return (true);
+}
+
+#endif /* LIBCAER_SRC_THREAD_SCHEDULING_H_ */
@@ -5,11 +5,13 @@
 
 #include <cstdlib>
 #include <cstdint>
+#include <cerrno>
 
 #else
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <errno.h>
 
 #endif
 
@@ -20,9 +22,13 @@ extern "C" {
 #include <pthread.h>
 #include <sys/time.h>
 
+#include <sched.h>
+
 #if defined(__linux__)
 	#include <sys/prctl.h>
 	#include <sys/resource.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
 #endif
 
 #define MAX_THREAD_NAME_LENGTH 15
@@ -90,6 +96,66 @@ static inline int thrd_set_priority(int priority) {
 #endif
 }
 
+// NON STANDARD!
+static inline int thrd_get_priority(int *priority) {
+#if defined(__linux__)
+	// -1 is a valid nice value, only errno tells failures apart.
+	errno = 0;
+
+	int value = getpriority(PRIO_PROCESS, 0);
+	if (errno != 0) {
+		return (thrd_error);
+	}
+
+	*priority = value;
+
+	return (thrd_success);
+#else
+	(void)(priority); // UNUSED.
+
+	return (thrd_error);
+#endif
+}
+
+// NON STANDARD! Bit N of the mask stands for CPU N, zero means all CPUs.
+static inline int thrd_set_affinity(uint32_t cpuMask) {
+#if defined(__linux__)
+	// Direct system call, the glibc wrapper and cpu_set_t need _GNU_SOURCE.
+	// Covers up to 1024 CPUs, the kernel ignores CPUs that do not exist.
+	unsigned long mask[1024 / (8 * sizeof(unsigned long))];
+
+	for (size_t i = 0; i < (sizeof(mask) / sizeof(mask[0])); i++) {
+		mask[i] = (cpuMask == 0) ? (~0UL) : (0);
+	}
+
+	if (cpuMask != 0) {
+		mask[0] = cpuMask;
+	}
+
+	if (syscall(SYS_sched_setaffinity, 0, sizeof(mask), mask) != 0) {
+		return (thrd_error);
+	}
+
+	return (thrd_success);
+#else
+	(void)(cpuMask); // UNUSED.
+
+	return (thrd_error);
+#endif
+}
+
+// NON STANDARD! Priority zero means normal scheduling.
+static inline int thrd_set_realtime(int priority) {
+	struct sched_param param;
+	param.sched_priority = priority;
+
+	if (pthread_setschedparam(pthread_self(), (priority > 0) ? (SCHED_FIFO) : (SCHED_OTHER), &param) != 0) {
+		return (thrd_error);
+	}
+
+	return (thrd_success);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,589 @@
+#include "usb_utils.h"
+#include "portable_time.h"
+#include "davis.h"
+#include "dvs128.h"
+#include "dynapse.h"
+
+// In-process stand-in for a DAVIS, DVS128 or Dynap-se USB device, so that
+// the whole device stack can be run and benchmarked without hardware.
+// Selected in usbDeviceOpen() when the environment variable
+// CAER_USB_TRANSPORT is set to "mock"; CAER_USB_MOCK_RATE sets the event
+// rate in events per second (0 = as fast as possible).
+// FPGA configuration requests read and write a register file, pre-loaded
+// with the values a DAVIS346 (or Dynap-se) reports about itself. Other
+// vendor requests succeed; IN requests return the request code followed
+// by zeros, which is what the Dynap-se verification expects.
+// Data transfers are filled with random DVS/spike events in the format of
+// the device, with a timestamp reset at the start of the stream.
+#define MOCK_BUS_NUMBER 1
+#define MOCK_DEVICE_ADDRESS 1
+#define MOCK_SERIAL_NUMBER "MOCK0001"
+#define MOCK_DEFAULT_EVENT_RATE 1000000
+// Like the device FIFOs, send data at least every millisecond, full or not.
+#define MOCK_TRANSFER_TIMEOUT 1000
+#define MOCK_IDLE_SLEEP_NS 100000
+#define MOCK_QUEUE_INITIAL_SIZE 16
+
+enum usb_mock_format {
+	MOCK_FORMAT_DAVIS, MOCK_FORMAT_DVS128, MOCK_FORMAT_DYNAPSE,
+};
+
+struct usb_mock_transfer {
+	struct libusb_transfer *transfer;
+	bool cancelled;
+};
+
+struct usb_mock_state {
+	enum usb_mock_format format;
+	uint16_t sizeX;
+	uint16_t sizeY;
+	// Submitted transfers, in submission order.
+	mtx_t queueLock;
+	struct usb_mock_transfer *queue; // LOCK PROTECTED.
+	size_t queueLength; // LOCK PROTECTED.
+	size_t queueCapacity; // LOCK PROTECTED.
+	// Everything below is only accessed by the USB thread.
+	uint32_t registers[SPI_CONFIG_SHADOW_MODULES][SPI_CONFIG_SHADOW_PARAMS];
+	uint64_t eventRate;
+	struct timespec openTime;
+	bool streaming;
+	uint64_t streamStart;
+	uint64_t streamEvents;
+	uint64_t lastCompletion;
+	// Timestamp as the host sees it, relative to the stream start.
+	uint64_t timestamp;
+	bool timestampReset;
+	uint32_t lcgState;
+};
+
+typedef struct usb_mock_state *usbMockState;
+
+// Spike words encode the source core in codes 1, 2, 5 and 6.
+static const uint16_t dynapseCoreCodes[4] = { 1, 2, 5, 6 };
+
+static void usbMockLog(enum caer_log_level logLevel, usbState state, const char *format, ...) ATTRIBUTE_FORMAT(3);
+static void usbMockControl(usbMockState mock, struct libusb_transfer *transfer);
+static size_t usbMockGenerate(usbMockState mock, uint8_t *buffer, size_t bufferSize, uint64_t eventsNumber,
+	uint64_t now, uint64_t *eventsGenerated);
+
+static void usbMockLog(enum caer_log_level logLevel, usbState state, const char *format, ...) {
+	va_list argumentList;
+	va_start(argumentList, format);
+	caerLogVAFull(caerLogFileDescriptorsGetFirst(), caerLogFileDescriptorsGetSecond(),
+		atomic_load_explicit(&state->usbLogLevel, memory_order_relaxed), logLevel, state->usbThreadName, format,
+		argumentList);
+	va_end(argumentList);
+}
+
+static inline uint32_t usbMockRandom(usbMockState mock) {
+	mock->lcgState = (mock->lcgState * 1103515245U) + 12345U;
+	return (mock->lcgState >> 8);
+}
+
+static uint64_t usbMockTime(usbMockState mock) {
+	struct timespec now;
+	portable_clock_gettime_monotonic(&now);
+
+	return ((uint64_t) ((now.tv_sec - mock->openTime.tv_sec) * 1000000LL)
+		+ (uint64_t) ((now.tv_nsec - mock->openTime.tv_nsec) / 1000));
+}
+
+static inline void usbMockPut16(uint8_t *buffer, size_t *position, uint16_t word) {
+	buffer[(*position)++] = U8T(word);
+	buffer[(*position)++] = U8T(word >> 8);
+}
+
+static bool usbMockOpen(usbState state, uint16_t devVID, uint16_t devPID, uint8_t busNumber, uint8_t devAddress,
+	const char *serialNumber, int32_t requiredLogicRevision, int32_t requiredFirmwareVersion) {
+	// The mock firmware is always recent enough.
+	(void) (requiredFirmwareVersion);
+
+	enum usb_mock_format format;
+
+	if (devVID != USB_DEFAULT_DEVICE_VID) {
+		return (false);
+	}
+
+	switch (devPID) {
+		case DAVIS_FX2_DEVICE_PID:
+		case DAVIS_FX3_DEVICE_PID:
+			format = MOCK_FORMAT_DAVIS;
+			break;
+
+		case DVS_DEVICE_PID:
+			format = MOCK_FORMAT_DVS128;
+			break;
+
+		case DYNAPSE_DEVICE_PID:
+			format = MOCK_FORMAT_DYNAPSE;
+			break;
+
+		default:
+			return (false);
+	}
+
+	// Honor the same restrictions as a real device would.
+	if (((busNumber > 0) && (busNumber != MOCK_BUS_NUMBER))
+		|| ((devAddress > 0) && (devAddress != MOCK_DEVICE_ADDRESS))) {
+		usbMockLog(CAER_LOG_ERROR, state, "USB port restriction is present, the mock device didn't match it.");
+		return (false);
+	}
+
+	if ((serialNumber != NULL) && (!caerStrEquals(serialNumber, ""))
+		&& (!caerStrEquals(serialNumber, MOCK_SERIAL_NUMBER))) {
+		usbMockLog(CAER_LOG_ERROR, state,
+			"USB serial number restriction is present (%s), the mock device didn't match it (%s).", serialNumber,
+			MOCK_SERIAL_NUMBER);
+		return (false);
+	}
+
+	usbMockState mock = calloc(1, sizeof(struct usb_mock_state));
+	if (mock == NULL) {
+		usbMockLog(CAER_LOG_CRITICAL, state, "Failed to allocate mock device memory.");
+		return (false);
+	}
+
+	if (mtx_init(&mock->queueLock, mtx_plain) != thrd_success) {
+		free(mock);
+		return (false);
+	}
+
+	mock->format = format;
+	mock->lcgState = 12345;
+	portable_clock_gettime_monotonic(&mock->openTime);
+
+	const char *eventRate = getenv("CAER_USB_MOCK_RATE");
+	mock->eventRate = (eventRate != NULL) ? (strtoull(eventRate, NULL, 10)) : (MOCK_DEFAULT_EVENT_RATE);
+
+	uint32_t logicVersion = (requiredLogicRevision > 0) ? (U32T(requiredLogicRevision)) : (0);
+
+	switch (format) {
+		case MOCK_FORMAT_DAVIS:
+			mock->sizeX = 346;
+			mock->sizeY = 260;
+
+			mock->registers[DAVIS_CONFIG_SYSINFO][DAVIS_CONFIG_SYSINFO_LOGIC_VERSION] = logicVersion;
+			mock->registers[DAVIS_CONFIG_SYSINFO][DAVIS_CONFIG_SYSINFO_CHIP_IDENTIFIER] = DAVIS_CHIP_DAVIS346B;
+			mock->registers[DAVIS_CONFIG_SYSINFO][DAVIS_CONFIG_SYSINFO_DEVICE_IS_MASTER] = true;
+			mock->registers[DAVIS_CONFIG_SYSINFO][DAVIS_CONFIG_SYSINFO_LOGIC_CLOCK] = 80;
+			mock->registers[DAVIS_CONFIG_SYSINFO][DAVIS_CONFIG_SYSINFO_ADC_CLOCK] = 30;
+			mock->registers[DAVIS_CONFIG_DVS][DAVIS_CONFIG_DVS_SIZE_COLUMNS] = mock->sizeX;
+			mock->registers[DAVIS_CONFIG_DVS][DAVIS_CONFIG_DVS_SIZE_ROWS] = mock->sizeY;
+			mock->registers[DAVIS_CONFIG_APS][DAVIS_CONFIG_APS_SIZE_COLUMNS] = mock->sizeX;
+			mock->registers[DAVIS_CONFIG_APS][DAVIS_CONFIG_APS_SIZE_ROWS] = mock->sizeY;
+			mock->registers[DAVIS_CONFIG_APS][DAVIS_CONFIG_APS_HAS_GLOBAL_SHUTTER] = true;
+			break;
+
+		case MOCK_FORMAT_DVS128:
+			// No FPGA, configuration is done with dedicated requests.
+			mock->sizeX = DVS_ARRAY_SIZE_X;
+			mock->sizeY = DVS_ARRAY_SIZE_Y;
+			break;
+
+		case MOCK_FORMAT_DYNAPSE:
+			// 256 neurons per core, 4 chips.
+			mock->sizeX = 256;
+			mock->sizeY = 4;
+
+			mock->registers[DYNAPSE_CONFIG_SYSINFO][DYNAPSE_CONFIG_SYSINFO_LOGIC_VERSION] = logicVersion;
+			mock->registers[DYNAPSE_CONFIG_SYSINFO][DYNAPSE_CONFIG_SYSINFO_CHIP_IDENTIFIER] = DYNAPSE_CHIP_DYNAPSE;
+			mock->registers[DYNAPSE_CONFIG_SYSINFO][DYNAPSE_CONFIG_SYSINFO_DEVICE_IS_MASTER] = true;
+			mock->registers[DYNAPSE_CONFIG_SYSINFO][DYNAPSE_CONFIG_SYSINFO_LOGIC_CLOCK] = 30;
+			break;
+	}
+
+	state->transportState = mock;
+	state->deviceContext = NULL;
+	state->deviceHandle = NULL;
+
+	usbMockLog(CAER_LOG_NOTICE, state, "Using in-process mock device (PID 0x%04" PRIX16 "), %" PRIu64 " events/s.",
+		devPID, mock->eventRate);
+
+	return (true);
+}
+
+static void usbMockClose(usbState state) {
+	usbMockState mock = state->transportState;
+
+	mtx_destroy(&mock->queueLock);
+	free(mock->queue);
+	free(mock);
+
+	state->transportState = NULL;
+}
+
+static bool usbMockInfo(usbState state, uint8_t *busNumber, uint8_t *devAddress,
+	char serialNumber[MAX_SERIAL_NUMBER_LENGTH + 1]) {
+	(void) (state);
+
+	*busNumber = MOCK_BUS_NUMBER;
+	*devAddress = MOCK_DEVICE_ADDRESS;
+	strncpy(serialNumber, MOCK_SERIAL_NUMBER, MAX_SERIAL_NUMBER_LENGTH + 1);
+
+	return (true);
+}
+
+static int usbMockSubmitTransfer(usbState state, struct libusb_transfer *transfer) {
+	usbMockState mock = state->transportState;
+
+	mtx_lock(&mock->queueLock);
+
+	if (mock->queueLength == mock->queueCapacity) {
+		size_t newCapacity = (mock->queueCapacity == 0) ? (MOCK_QUEUE_INITIAL_SIZE) : (mock->queueCapacity * 2);
+
+		struct usb_mock_transfer *newQueue = realloc(mock->queue, newCapacity * sizeof(struct usb_mock_transfer));
+		if (newQueue == NULL) {
+			mtx_unlock(&mock->queueLock);
+			return (LIBUSB_ERROR_NO_MEM);
+		}
+
+		mock->queue = newQueue;
+		mock->queueCapacity = newCapacity;
+	}
+
+	mock->queue[mock->queueLength].transfer = transfer;
+	mock->queue[mock->queueLength].cancelled = false;
+	mock->queueLength++;
+
+	mtx_unlock(&mock->queueLock);
+
+	return (LIBUSB_SUCCESS);
+}
+
+static int usbMockCancelTransfer(usbState state, struct libusb_transfer *transfer) {
+	usbMockState mock = state->transportState;
+	int retVal = LIBUSB_ERROR_NOT_FOUND;
+
+	mtx_lock(&mock->queueLock);
+
+	for (size_t i = 0; i < mock->queueLength; i++) {
+		if ((mock->queue[i].transfer == transfer) && (!mock->queue[i].cancelled)) {
+			mock->queue[i].cancelled = true;
+			retVal = LIBUSB_SUCCESS;
+			break;
+		}
+	}
+
+	mtx_unlock(&mock->queueLock);
+
+	return (retVal);
+}
+
+// Remove the next transfer that can be completed right away from the queue:
+// cancelled and control transfers first, else the oldest data transfer if
+// 'dataReady' says so. Interrupt transfers (FX3 debug) never complete.
+static struct libusb_transfer *usbMockDequeue(usbState state, bool *cancelled, bool *dataPending,
+	bool (*dataReady)(usbMockState mock, struct libusb_transfer *transfer)) {
+	usbMockState mock = state->transportState;
+	size_t index = SIZE_MAX;
+	size_t dataIndex = SIZE_MAX;
+
+	mtx_lock(&mock->queueLock);
+
+	for (size_t i = 0; i < mock->queueLength; i++) {
+		const struct usb_mock_transfer *entry = &mock->queue[i];
+
+		if (entry->cancelled || (entry->transfer->type == LIBUSB_TRANSFER_TYPE_CONTROL)) {
+			if (index == SIZE_MAX) {
+				index = i;
+			}
+		}
+		else if ((entry->transfer->type == LIBUSB_TRANSFER_TYPE_BULK)
+			&& (entry->transfer->endpoint == state->dataEndPoint) && (dataIndex == SIZE_MAX)) {
+			dataIndex = i;
+		}
+	}
+
+	*dataPending = (dataIndex != SIZE_MAX);
+
+	if ((index == SIZE_MAX) && (dataIndex != SIZE_MAX) && (*dataReady)(mock, mock->queue[dataIndex].transfer)) {
+		index = dataIndex;
+	}
+
+	struct libusb_transfer *transfer = NULL;
+
+	if (index != SIZE_MAX) {
+		transfer = mock->queue[index].transfer;
+		*cancelled = mock->queue[index].cancelled;
+
+		memmove(&mock->queue[index], &mock->queue[index + 1],
+			(mock->queueLength - index - 1) * sizeof(struct usb_mock_transfer));
+		mock->queueLength--;
+	}
+
+	mtx_unlock(&mock->queueLock);
+
+	return (transfer);
+}
+
+// Typical bytes per event, to decide if a data transfer would be full.
+static inline size_t usbMockEventSize(usbMockState mock) {
+	return ((mock->format == MOCK_FORMAT_DYNAPSE) ? (2) : (4));
+}
+
+static uint64_t usbMockEventsDue(usbMockState mock, uint64_t now) {
+	if (mock->eventRate == 0) {
+		return (UINT64_MAX);
+	}
+
+	return ((((now - mock->streamStart) * mock->eventRate) / 1000000) - mock->streamEvents);
+}
+
+static bool usbMockDataReady(usbMockState mock, struct libusb_transfer *transfer) {
+	uint64_t now = usbMockTime(mock);
+
+	if (!mock->streaming) {
+		// First data transfer of a new stream.
+		mock->streaming = true;
+		mock->streamStart = now;
+		mock->streamEvents = 0;
+		mock->lastCompletion = now;
+		mock->timestamp = 0;
+		mock->timestampReset = true;
+	}
+
+	uint64_t eventsDue = usbMockEventsDue(mock, now);
+
+	if (eventsDue >= ((size_t) transfer->length / usbMockEventSize(mock))) {
+		return (true);
+	}
+
+	return ((eventsDue > 0) && ((now - mock->lastCompletion) >= MOCK_TRANSFER_TIMEOUT));
+}
+
+static void usbMockHandleEvents(usbState state, struct timeval *timeout) {
+	usbMockState mock = state->transportState;
+	bool completedAny = false;
+
+	// Handle at most the transfers queued right now, like one libusb event
+	// round: completed data transfers are resubmitted from their callback,
+	// and at unlimited rate would keep this loop, and the USB thread's own
+	// checks around it, from ever ending.
+	mtx_lock(&mock->queueLock);
+	size_t transfersNumber = mock->queueLength;
+	mtx_unlock(&mock->queueLock);
+
+	while (transfersNumber-- > 0) {
+		bool cancelled = false;
+		bool dataPending = false;
+
+		struct libusb_transfer *transfer = usbMockDequeue(state, &cancelled, &dataPending, &usbMockDataReady);
+
+		if (!dataPending) {
+			// No data transfers left, the next one starts a new stream.
+			mock->streaming = false;
+		}
+
+		if (transfer == NULL) {
+			break;
+		}
+
+		completedAny = true;
+
+		if (cancelled) {
+			transfer->status = LIBUSB_TRANSFER_CANCELLED;
+			transfer->actual_length = 0;
+		}
+		else if (transfer->type == LIBUSB_TRANSFER_TYPE_CONTROL) {
+			usbMockControl(mock, transfer);
+		}
+		else {
+			uint64_t now = usbMockTime(mock);
+			uint64_t eventsGenerated = 0;
+
+			transfer->status = LIBUSB_TRANSFER_COMPLETED;
+			transfer->actual_length = (int) usbMockGenerate(mock, transfer->buffer, (size_t) transfer->length,
+				usbMockEventsDue(mock, now), now, &eventsGenerated);
+
+			mock->streamEvents += eventsGenerated;
+			mock->lastCompletion = now;
+		}
+
+		(*transfer->callback)(transfer);
+	}
+
+	if (!completedAny) {
+		// Nothing to do, wait a little; always shorter than the timeout.
+		(void) (timeout);
+
+		struct timespec idleSleep = { .tv_sec = 0, .tv_nsec = MOCK_IDLE_SLEEP_NS };
+		thrd_sleep(&idleSleep, NULL);
+	}
+}
+
+static void usbMockControl(usbMockState mock, struct libusb_transfer *transfer) {
+	struct libusb_control_setup *setup = libusb_control_transfer_get_setup(transfer);
+	uint8_t *data = libusb_control_transfer_get_data(transfer);
+
+	uint16_t wValue = libusb_le16_to_cpu(setup->wValue);
+	uint16_t wIndex = libusb_le16_to_cpu(setup->wIndex);
+	uint16_t wLength = libusb_le16_to_cpu(setup->wLength);
+	bool directionIn = ((setup->bmRequestType & LIBUSB_ENDPOINT_IN) != 0);
+
+	if (setup->bRequest == VENDOR_REQUEST_FPGA_CONFIG) {
+		bool validAddress = (wValue < SPI_CONFIG_SHADOW_MODULES) && (wIndex < SPI_CONFIG_SHADOW_PARAMS)
+			&& (wLength >= 4);
+
+		if (directionIn) {
+			uint32_t param = (validAddress) ? (mock->registers[wValue][wIndex]) : (0);
+
+			memset(data, 0, wLength);
+			if (wLength >= 4) {
+				data[0] = U8T(param >> 24);
+				data[1] = U8T(param >> 16);
+				data[2] = U8T(param >> 8);
+				data[3] = U8T(param >> 0);
+			}
+		}
+		else if (validAddress) {
+			mock->registers[wValue][wIndex] = (U32T(data[0]) << 24) | (U32T(data[1]) << 16) | (U32T(data[2]) << 8)
+				| (U32T(data[3]) << 0);
+		}
+	}
+	else if ((setup->bRequest == VENDOR_REQUEST_FPGA_CONFIG_MULTIPLE) && (!directionIn)) {
+		for (size_t i = 0; (i < wValue) && (((i + 1) * SPI_CONFIG_MSG_SIZE) <= wLength); i++) {
+			const uint8_t *message = &data[i * SPI_CONFIG_MSG_SIZE];
+
+			if (message[0] < SPI_CONFIG_SHADOW_MODULES) {
+				mock->registers[message[0]][message[1]] = (U32T(message[2]) << 24) | (U32T(message[3]) << 16)
+					| (U32T(message[4]) << 8) | (U32T(message[5]) << 0);
+			}
+		}
+	}
+	else if (directionIn) {
+		memset(data, 0, wLength);
+		if (wLength > 0) {
+			data[0] = setup->bRequest;
+		}
+	}
+
+	transfer->status = LIBUSB_TRANSFER_COMPLETED;
+	transfer->actual_length = wLength;
+}
+
+// Emit timestamp wrap and timestamp words in the 16 bit word format of DAVIS
+// and Dynap-se (15 bit timestamps), so that the host is at 'timestamp'.
+// Returns false if that and 'eventSize' more bytes don't fit.
+static bool usbMockTimestamp16(usbMockState mock, uint8_t *buffer, size_t bufferSize, size_t *position,
+	uint64_t timestamp, size_t eventSize) {
+	while ((timestamp >> 15) > (mock->timestamp >> 15)) {
+		if ((*position + 2) > bufferSize) {
+			return (false);
+		}
+
+		uint64_t wraps = (timestamp >> 15) - (mock->timestamp >> 15);
+		if (wraps > 0x0FFF) {
+			wraps = 0x0FFF;
+		}
+
+		usbMockPut16(buffer, position, U16T(0x7000 | wraps));
+		mock->timestamp = ((mock->timestamp >> 15) + wraps) << 15;
+	}
+
+	// After a wrap the host is at the start of the new period already.
+	if (timestamp != mock->timestamp) {
+		if ((*position + 2 + eventSize) > bufferSize) {
+			return (false);
+		}
+
+		usbMockPut16(buffer, position, U16T(0x8000 | (timestamp & 0x7FFF)));
+		mock->timestamp = timestamp;
+	}
+
+	return ((*position + eventSize) <= bufferSize);
+}
+
+// Same for the DVS128, where every event carries a 14 bit timestamp, and
+// each wrap word adds 2^14 µs.
+static bool usbMockTimestamp14(usbMockState mock, uint8_t *buffer, size_t bufferSize, size_t *position,
+	uint64_t timestamp) {
+	while ((timestamp >> 14) > (mock->timestamp >> 14)) {
+		if ((*position + 4) > bufferSize) {
+			return (false);
+		}
+
+		usbMockPut16(buffer, position, 0);
+		usbMockPut16(buffer, position, 0x8000);
+		mock->timestamp = ((mock->timestamp >> 14) + 1) << 14;
+	}
+
+	return ((*position + 4) <= bufferSize);
+}
+
+static size_t usbMockGenerate(usbMockState mock, uint8_t *buffer, size_t bufferSize, uint64_t eventsNumber,
+	uint64_t now, uint64_t *eventsGenerated) {
+	size_t position = 0;
+
+	if (mock->timestampReset) {
+		if (mock->format == MOCK_FORMAT_DVS128) {
+			usbMockPut16(buffer, &position, 0);
+			usbMockPut16(buffer, &position, 0x4000);
+		}
+		else {
+			usbMockPut16(buffer, &position, 0x0001);
+		}
+
+		mock->timestampReset = false;
+	}
+
+	// Spread the events evenly over the time since the last transfer.
+	uint64_t streamTime = now - mock->streamStart;
+	uint64_t lastTimestamp = mock->timestamp;
+	uint64_t eventsSpread = bufferSize / usbMockEventSize(mock);
+
+	if (eventsNumber < eventsSpread) {
+		eventsSpread = eventsNumber;
+	}
+
+	uint64_t i;
+	for (i = 0; i < eventsNumber; i++) {
+		uint64_t timestamp = lastTimestamp;
+		if (streamTime > lastTimestamp) {
+			timestamp += ((streamTime - lastTimestamp) * ((i < eventsSpread) ? (i + 1) : (eventsSpread)))
+				/ eventsSpread;
+		}
+
+		uint32_t random = usbMockRandom(mock);
+		uint16_t x = U16T((random & 0xFFFF) % mock->sizeX);
+		uint16_t y = U16T(((random >> 8) & 0xFFFF) % mock->sizeY);
+		uint16_t polarity = U16T((random >> 23) & 0x01);
+
+		if (mock->format == MOCK_FORMAT_DVS128) {
+			if (!usbMockTimestamp14(mock, buffer, bufferSize, &position, timestamp)) {
+				break;
+			}
+
+			usbMockPut16(buffer, &position, U16T((y << 8) | (x << 1) | polarity));
+			usbMockPut16(buffer, &position, U16T(timestamp & 0x3FFF));
+			mock->timestamp = timestamp;
+		}
+		else if (mock->format == MOCK_FORMAT_DAVIS) {
+			if (!usbMockTimestamp16(mock, buffer, bufferSize, &position, timestamp, 4)) {
+				break;
+			}
+
+			// Row address, then column address with polarity.
+			usbMockPut16(buffer, &position, U16T(0x1000 | y));
+			usbMockPut16(buffer, &position, U16T(0x2000 | (polarity << 12) | x));
+		}
+		else {
+			if (!usbMockTimestamp16(mock, buffer, bufferSize, &position, timestamp, 2)) {
+				break;
+			}
+
+			// Neuron address from the random X, Y gives the chip. Like the
+			// real board, chip IDs go out shifted up by DYNAPSE_CHIPID_SHIFT.
+			usbMockPut16(buffer, &position,
+				U16T((dynapseCoreCodes[random & 0x03] << 12) | ((x & 0xFF) << 4)
+					| ((y & 0x03) + DYNAPSE_CHIPID_SHIFT)));
+		}
+	}
+
+	*eventsGenerated = i;
+
+	return (position);
+}
+
+const struct usb_transport usbTransportMock = { .name = "mock", .open = &usbMockOpen, .close = &usbMockClose, .info =
+	&usbMockInfo, .submitTransfer = &usbMockSubmitTransfer, .cancelTransfer = &usbMockCancelTransfer, .handleEvents =
+	&usbMockHandleEvents, .memAlloc = NULL, .memFree = NULL, };
@@ -1,4 +1,20 @@
 #include "usb_utils.h"
+#include "portable_aligned_alloc.h"
+#include "portable_time.h"
+
+// Alignment of data transfer buffers not in device memory. Page alignment
+// lets the OS map them for DMA where it supports it, instead of copying.
+#define USB_DATA_BUFFER_ALIGNMENT 4096
+
+// Transfer auto-tuning: sizes are multiples of the SuperSpeed bulk packet
+// size (also a multiple of the High-Speed one), the data rate is measured
+// over windows of 100ms, and enough transfers are kept in flight to hold
+// 10ms of data.
+#define USB_AUTO_TUNE_SIZE_STEP 1024
+#define USB_AUTO_TUNE_MIN_NUMBER 2
+#define USB_AUTO_TUNE_WINDOW_US 100000
+#define USB_AUTO_TUNE_QUEUE_US 10000
+#define USB_AUTO_TUNE_DEFAULT_LATENCY_US 1000
 
 struct usb_control_struct {
 	union {
@@ -6,6 +22,7 @@ struct usb_control_struct {
 		void (*controlInCallback)(void *controlInCallbackPtr, int status, const uint8_t *buffer, size_t bufferSize);
 	};
 	void *controlCallbackPtr;
+	usbState state;
 };
 
 typedef struct usb_control_struct *usbControl;
@@ -18,6 +35,13 @@ struct usb_data_completion_struct {
 
 typedef struct usb_data_completion_struct *usbDataCompletion;
 
+struct usb_decode_buffer {
+	uint8_t *buffer;
+	size_t length;
+};
+
+typedef struct usb_decode_buffer *usbDecodeBuffer;
+
 struct usb_config_receive_struct {
 	void (*configReceiveCallback)(void *configReceiveCallbackPtr, int status, uint32_t param);
 	void *configReceiveCallbackPtr;
@@ -25,11 +49,38 @@ struct usb_config_receive_struct {
 
 typedef struct usb_config_receive_struct *usbConfigReceive;
 
+// Process-wide libusb contexts shared by devices, each with one thread
+// handling the events of all its devices (see caerDeviceUSBSharedContextSet()).
+struct usb_shared_context {
+	libusb_context *context;
+	size_t users;
+	thrd_t thread;
+	atomic_bool threadRun;
+	char threadName[MAX_THREAD_NAME_LENGTH + 1]; // +1 for terminating NUL character.
+};
+
+static once_flag usbSharedContextsInitFlag = ONCE_FLAG_INIT;
+static mtx_t usbSharedContextsLock;
+static struct usb_shared_context *usbSharedContexts = NULL; // LOCK PROTECTED.
+static uint32_t usbSharedContextsNumber = 0; // LOCK PROTECTED.
+
 static void caerUSBLog(enum caer_log_level logLevel, usbState state, const char *format, ...) ATTRIBUTE_FORMAT(3);
 static int usbThreadRun(void *usbStatePtr);
+static void usbSharedContextsInit(void);
+static bool usbSharedContextAcquire(usbState state);
+static void usbSharedContextRelease(usbState state);
+static int usbSharedContextThreadRun(void *sharedContextPtr);
 static bool usbAllocateTransfers(usbState state);
 static void usbCancelAndDeallocateTransfers(usbState state);
 static void LIBUSB_CALL usbDataTransferCallback(struct libusb_transfer *transfer);
+static bool usbAutoTune(usbState state, struct libusb_transfer *transfer);
+static void usbAutoTuneUpdate(usbState state, uint64_t windowTime);
+static bool usbDataBuffersAllocate(usbState state, size_t bufferNum, size_t bufferSize);
+static void usbDataBuffersFree(usbState state);
+static bool usbDecodeThreadStart(usbState state, uint32_t bufferNum, uint8_t **spareBuffers);
+static void usbDecodeThreadStop(usbState state);
+static int usbDecodeThreadRun(void *usbStatePtr);
+static void usbDecodeBufferHandOff(usbState state, struct libusb_transfer *transfer);
 static bool usbControlTransferAsync(usbState state, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint8_t *data,
 	size_t dataSize, void (*controlOutCallback)(void *controlOutCallbackPtr, int status),
 	void (*controlInCallback)(void *controlInCallbackPtr, int status, const uint8_t *buffer, size_t bufferSize),
@@ -39,6 +90,10 @@ static void LIBUSB_CALL usbControlInCallback(struct libusb_transfer *transfer);
 static void syncControlOutCallback(void *controlOutCallbackPtr, int status);
 static void syncControlInCallback(void *controlInCallbackPtr, int status, const uint8_t *buffer, size_t bufferSize);
 static void spiConfigReceiveCallback(void *configReceiveCallbackPtr, int status, const uint8_t *buffer, size_t bufferSize);
+static inline bool spiConfigBatchActive(usbState state);
+static bool spiConfigBatchFlush(usbState state);
+static void spiConfigBatchCallback(void *configBatchCallbackPtr, int status);
+static void spiConfigShadowUpdate(usbState state, struct libusb_transfer *transfer);
 
 static void caerUSBLog(enum caer_log_level logLevel, usbState state, const char *format, ...) {
 	va_list argumentList;
@@ -50,25 +105,83 @@ static void caerUSBLog(enum caer_log_level logLevel, usbState state, const char
 }
 
 bool usbDeviceOpen(usbState state, uint16_t devVID, uint16_t devPID, uint8_t busNumber, uint8_t devAddress,
+	const char *serialNumber, int32_t requiredLogicRevision, int32_t requiredFirmwareVersion) {
+	// The configuration shadow is on by default, and starts out empty.
+	atomic_store(&state->spiConfigShadowEnabled, true);
+	spiConfigShadowClear(state);
+
+	atomic_store(&state->autoTuneLatency, USB_AUTO_TUNE_DEFAULT_LATENCY_US);
+
+	threadSchedulingSettingsInit(&state->threadScheduling);
+
+	// The in-process mock replaces the hardware if requested, see usb_mock.c.
+	const char *transportName = getenv("CAER_USB_TRANSPORT");
+
+	if ((transportName != NULL) && caerStrEquals(transportName, usbTransportMock.name)) {
+		state->transport = &usbTransportMock;
+	}
+	else {
+		state->transport = &usbTransportLibUSB;
+	}
+
+	if (!state->transport->open(state, devVID, devPID, busNumber, devAddress, serialNumber, requiredLogicRevision,
+		requiredFirmwareVersion)) {
+		return (false);
+	}
+
+	// Initialize transfers mutex.
+	if (mtx_init(&state->dataTransfersLock, mtx_plain) != thrd_success) {
+		state->transport->close(state);
+		return (false);
+	}
+
+	// Initialize configuration batch mutex.
+	if (mtx_init(&state->spiConfigBatchLock, mtx_plain) != thrd_success) {
+		mtx_destroy(&state->dataTransfersLock);
+		state->transport->close(state);
+		return (false);
+	}
+
+	return (true);
+}
+
+void usbDeviceClose(usbState state) {
+	// Device memory must be freed while the device is still open.
+	usbDataBuffersFree(state);
+
+	mtx_destroy(&state->dataTransfersLock);
+	mtx_destroy(&state->spiConfigBatchLock);
+
+	state->transport->close(state);
+}
+
+static bool usbLibUSBOpen(usbState state, uint16_t devVID, uint16_t devPID, uint8_t busNumber, uint8_t devAddress,
 	const char *serialNumber, int32_t requiredLogicRevision, int32_t requiredFirmwareVersion) {
 	// Search for device and open it.
-	// Initialize libusb using a separate context for each device.
+	// Use a shared context if enabled, else initialize libusb using a
+	// separate context for each device.
 	// This is to correctly support one thread per device.
-	// libusb may create its own threads at this stage, so we temporarily set
-	// a different thread name.
-	char originalThreadName[MAX_THREAD_NAME_LENGTH + 1]; // +1 for terminating NUL character.
-	thrd_get_name(originalThreadName, MAX_THREAD_NAME_LENGTH);
-	originalThreadName[MAX_THREAD_NAME_LENGTH] = '\0';
+	if (!usbSharedContextAcquire(state)) {
+		return (false);
+	}
 
-	thrd_set_name(state->usbThreadName);
+	if (state->sharedContext == NULL) {
+		// libusb may create its own threads at this stage, so we temporarily set
+		// a different thread name.
+		char originalThreadName[MAX_THREAD_NAME_LENGTH + 1]; // +1 for terminating NUL character.
+		thrd_get_name(originalThreadName, MAX_THREAD_NAME_LENGTH);
+		originalThreadName[MAX_THREAD_NAME_LENGTH] = '\0';
 
-	int res = libusb_init(&state->deviceContext);
+		thrd_set_name(state->usbThreadName);
 
-	thrd_set_name(originalThreadName);
+		int res = libusb_init(&state->deviceContext);
 
-	if (res != LIBUSB_SUCCESS) {
-		caerUSBLog(CAER_LOG_CRITICAL, state, "Failed to initialize libusb context. Error: %d.", res);
-		return (false);
+		thrd_set_name(originalThreadName);
+
+		if (res != LIBUSB_SUCCESS) {
+			caerUSBLog(CAER_LOG_CRITICAL, state, "Failed to initialize libusb context. Error: %d.", res);
+			return (false);
+		}
 	}
 
 	libusb_device_handle *devHandle = NULL;
@@ -208,15 +321,6 @@ bool usbDeviceOpen(usbState state, uint16_t devVID, uint16_t devPID, uint8_t bus
 					}
 				}
 
-				// Initialize transfers mutex.
-				if (mtx_init(&state->dataTransfersLock, mtx_plain) != thrd_success) {
-					libusb_release_interface(devHandle, 0);
-					libusb_close(devHandle);
-					devHandle = NULL;
-
-					continue;
-				}
-
 				break;
 			}
 		}
@@ -231,23 +335,251 @@ bool usbDeviceOpen(usbState state, uint16_t devVID, uint16_t devPID, uint8_t bus
 	}
 
 	// Didn't find anything.
-	libusb_exit(state->deviceContext);
-	state->deviceContext = NULL;
+	if (state->sharedContext != NULL) {
+		usbSharedContextRelease(state);
+	}
+	else {
+		libusb_exit(state->deviceContext);
+		state->deviceContext = NULL;
+	}
 
 	return (false);
 }
 
-void usbDeviceClose(usbState state) {
-	mtx_destroy(&state->dataTransfersLock);
-
+static void usbLibUSBClose(usbState state) {
 	// Release interface 0 (default).
 	libusb_release_interface(state->deviceHandle, 0);
 
 	libusb_close(state->deviceHandle);
 
-	libusb_exit(state->deviceContext);
+	if (state->sharedContext != NULL) {
+		usbSharedContextRelease(state);
+	}
+	else {
+		libusb_exit(state->deviceContext);
+	}
+}
+
+static void usbSharedContextsInit(void) {
+	mtx_init(&usbSharedContextsLock, mtx_plain);
+}
+
+bool caerDeviceUSBSharedContextSet(uint32_t eventThreads) {
+	if (eventThreads > CAER_USB_SHARED_CONTEXTS_MAX) {
+		caerLog(CAER_LOG_ERROR, "USB", "Cannot use %" PRIu32 " shared contexts, maximum is %d.", eventThreads,
+			CAER_USB_SHARED_CONTEXTS_MAX);
+		return (false);
+	}
+
+	call_once(&usbSharedContextsInitFlag, &usbSharedContextsInit);
+
+	mtx_lock(&usbSharedContextsLock);
+
+	for (size_t i = 0; i < usbSharedContextsNumber; i++) {
+		if (usbSharedContexts[i].users > 0) {
+			mtx_unlock(&usbSharedContextsLock);
+
+			caerLog(CAER_LOG_ERROR, "USB", "Cannot change shared contexts while devices are using them.");
+			return (false);
+		}
+	}
+
+	free(usbSharedContexts);
+	usbSharedContexts = NULL;
+	usbSharedContextsNumber = 0;
+
+	if (eventThreads > 0) {
+		usbSharedContexts = calloc(eventThreads, sizeof(struct usb_shared_context));
+		if (usbSharedContexts == NULL) {
+			mtx_unlock(&usbSharedContextsLock);
+
+			caerLog(CAER_LOG_CRITICAL, "USB", "Failed to allocate memory for %" PRIu32 " shared contexts.",
+				eventThreads);
+			return (false);
+		}
+
+		usbSharedContextsNumber = eventThreads;
+	}
+
+	mtx_unlock(&usbSharedContextsLock);
+
+	return (true);
+}
+
+uint32_t caerDeviceUSBSharedContextGet(void) {
+	call_once(&usbSharedContextsInitFlag, &usbSharedContextsInit);
+
+	mtx_lock(&usbSharedContextsLock);
+	uint32_t eventThreads = usbSharedContextsNumber;
+	mtx_unlock(&usbSharedContextsLock);
+
+	return (eventThreads);
+}
+
+// Join the shared context with the fewest devices, starting it up if this
+// is its first one. Leaves 'sharedContext' at NULL if sharing is disabled.
+static bool usbSharedContextAcquire(usbState state) {
+	call_once(&usbSharedContextsInitFlag, &usbSharedContextsInit);
+
+	mtx_lock(&usbSharedContextsLock);
+
+	if (usbSharedContextsNumber == 0) {
+		mtx_unlock(&usbSharedContextsLock);
+		return (true);
+	}
+
+	size_t sharedIndex = 0;
+
+	for (size_t i = 1; i < usbSharedContextsNumber; i++) {
+		if (usbSharedContexts[i].users < usbSharedContexts[sharedIndex].users) {
+			sharedIndex = i;
+		}
+	}
+
+	struct usb_shared_context *shared = &usbSharedContexts[sharedIndex];
+
+	if (shared->users == 0) {
+		// At most CAER_USB_SHARED_CONTEXTS_MAX contexts, so the index fits.
+		snprintf(shared->threadName, MAX_THREAD_NAME_LENGTH + 1, "USB events %" PRIu8, U8T(sharedIndex));
+
+		// libusb may create its own threads at this stage, so we temporarily set
+		// a different thread name.
+		char originalThreadName[MAX_THREAD_NAME_LENGTH + 1]; // +1 for terminating NUL character.
+		thrd_get_name(originalThreadName, MAX_THREAD_NAME_LENGTH);
+		originalThreadName[MAX_THREAD_NAME_LENGTH] = '\0';
+
+		thrd_set_name(shared->threadName);
+
+		int res = libusb_init(&shared->context);
+
+		thrd_set_name(originalThreadName);
+
+		if (res != LIBUSB_SUCCESS) {
+			mtx_unlock(&usbSharedContextsLock);
+
+			caerUSBLog(CAER_LOG_CRITICAL, state, "Failed to initialize shared libusb context. Error: %d.", res);
+			return (false);
+		}
+
+		atomic_store(&shared->threadRun, true);
+
+		if ((errno = thrd_create(&shared->thread, &usbSharedContextThreadRun, shared)) != thrd_success) {
+			libusb_exit(shared->context);
+			shared->context = NULL;
+
+			mtx_unlock(&usbSharedContextsLock);
+
+			caerUSBLog(CAER_LOG_CRITICAL, state, "Failed to create shared USB thread. Error: %d.", errno);
+			return (false);
+		}
+	}
+
+	shared->users++;
+
+	state->sharedContext = shared;
+	state->deviceContext = shared->context;
+
+	mtx_unlock(&usbSharedContextsLock);
+
+	caerUSBLog(CAER_LOG_DEBUG, state, "Using shared libusb context %zu.", sharedIndex);
+
+	return (true);
+}
+
+// The last device to leave shuts the shared context down.
+static void usbSharedContextRelease(usbState state) {
+	struct usb_shared_context *shared = state->sharedContext;
+
+	mtx_lock(&usbSharedContextsLock);
+
+	shared->users--;
+
+	if (shared->users == 0) {
+		atomic_store(&shared->threadRun, false);
+
+#if defined(LIBUSB_API_VERSION) && (LIBUSB_API_VERSION >= 0x01000105)
+		// Wake the thread up, instead of waiting for its timeout.
+		libusb_interrupt_event_handler(shared->context);
+#endif
+
+		if ((errno = thrd_join(shared->thread, NULL)) != thrd_success) {
+			// This should never happen!
+			caerUSBLog(CAER_LOG_CRITICAL, state, "Failed to join shared USB thread. Error: %d.", errno);
+		}
+
+		libusb_exit(shared->context);
+		shared->context = NULL;
+	}
+
+	mtx_unlock(&usbSharedContextsLock);
+
+	state->sharedContext = NULL;
+	state->deviceContext = NULL;
+}
+
+static int usbSharedContextThreadRun(void *sharedContextPtr) {
+	struct usb_shared_context *shared = sharedContextPtr;
+
+	thrd_set_name(shared->threadName);
+
+	// Handle USB events of all devices on this context (1 second timeout).
+	struct timeval te = { .tv_sec = 1, .tv_usec = 0 };
+
+	while (atomic_load_explicit(&shared->threadRun, memory_order_relaxed)) {
+		libusb_handle_events_timeout(shared->context, &te);
+	}
+
+	return (EXIT_SUCCESS);
 }
 
+static bool usbLibUSBInfo(usbState state, uint8_t *busNumber, uint8_t *devAddress,
+	char serialNumber[MAX_SERIAL_NUMBER_LENGTH + 1]) {
+	*busNumber = libusb_get_bus_number(libusb_get_device(state->deviceHandle));
+	*devAddress = libusb_get_device_address(libusb_get_device(state->deviceHandle));
+
+	int getStringDescResult = libusb_get_string_descriptor_ascii(state->deviceHandle, 3, (unsigned char *) serialNumber,
+	MAX_SERIAL_NUMBER_LENGTH + 1);
+
+	// Check serial number success and length.
+	return ((getStringDescResult >= 0) && (getStringDescResult <= MAX_SERIAL_NUMBER_LENGTH));
+}
+
+static int usbLibUSBSubmitTransfer(usbState state, struct libusb_transfer *transfer) {
+	(void) (state);
+
+	return (libusb_submit_transfer(transfer));
+}
+
+static int usbLibUSBCancelTransfer(usbState state, struct libusb_transfer *transfer) {
+	(void) (state);
+
+	return (libusb_cancel_transfer(transfer));
+}
+
+static void usbLibUSBHandleEvents(usbState state, struct timeval *timeout) {
+	libusb_handle_events_timeout(state->deviceContext, timeout);
+}
+
+#if defined(LIBUSB_API_VERSION) && (LIBUSB_API_VERSION >= 0x01000105)
+static uint8_t *usbLibUSBMemAlloc(usbState state, size_t size) {
+	return (libusb_dev_mem_alloc(state->deviceHandle, size));
+}
+
+static void usbLibUSBMemFree(usbState state, uint8_t *buffer, size_t size) {
+	libusb_dev_mem_free(state->deviceHandle, buffer, size);
+}
+#endif
+
+const struct usb_transport usbTransportLibUSB = { .name = "libusb", .open = &usbLibUSBOpen, .close = &usbLibUSBClose,
+	.info = &usbLibUSBInfo, .submitTransfer = &usbLibUSBSubmitTransfer, .cancelTransfer = &usbLibUSBCancelTransfer,
+	.handleEvents = &usbLibUSBHandleEvents,
+#if defined(LIBUSB_API_VERSION) && (LIBUSB_API_VERSION >= 0x01000105)
+	.memAlloc = &usbLibUSBMemAlloc, .memFree = &usbLibUSBMemFree,
+#else
+	.memAlloc = NULL, .memFree = NULL,
+#endif
+};
+
 void usbSetThreadName(usbState state, const char *threadName) {
 	strncpy(state->usbThreadName, threadName, MAX_THREAD_NAME_LENGTH);
 	state->usbThreadName[MAX_THREAD_NAME_LENGTH] = '\0';
@@ -305,6 +637,48 @@ void usbSetTransfersSize(usbState state, uint32_t transfersSize) {
 	mtx_unlock(&state->dataTransfersLock);
 }
 
+void usbSetDecodeThread(usbState state, bool decodeThread) {
+	atomic_store(&state->decodeThreadEnabled, decodeThread);
+
+	// Cancel transfers, wait for them to terminate, deallocate, and
+	// then reallocate with or without the decode thread.
+	mtx_lock(&state->dataTransfersLock);
+	if (usbDataTransfersAreRunning(state)) {
+		usbCancelAndDeallocateTransfers(state);
+
+		// Check again, for exceptional shutdown may have set this to false.
+		if (usbDataTransfersAreRunning(state)) {
+			usbAllocateTransfers(state);
+		}
+	}
+	mtx_unlock(&state->dataTransfersLock);
+}
+
+bool usbGetDecodeThread(usbState state) {
+	return (atomic_load(&state->decodeThreadEnabled));
+}
+
+void usbSetAutoTune(usbState state, bool autoTune) {
+	atomic_store(&state->autoTuneEnabled, autoTune);
+
+	// Cancel transfers, wait for them to terminate, deallocate, and
+	// then reallocate them all at full size/number.
+	mtx_lock(&state->dataTransfersLock);
+	if (usbDataTransfersAreRunning(state)) {
+		usbCancelAndDeallocateTransfers(state);
+
+		// Check again, for exceptional shutdown may have set this to false.
+		if (usbDataTransfersAreRunning(state)) {
+			usbAllocateTransfers(state);
+		}
+	}
+	mtx_unlock(&state->dataTransfersLock);
+}
+
+bool usbGetAutoTune(usbState state) {
+	return (atomic_load(&state->autoTuneEnabled));
+}
+
 uint32_t usbGetTransfersNumber(usbState state) {
 	return (U32T(atomic_load(&state->usbBufferNumber)));
 }
@@ -316,15 +690,11 @@ uint32_t usbGetTransfersSize(usbState state) {
 struct usb_info usbGenerateInfo(usbState state, const char *deviceName, uint16_t deviceID) {
 	// At this point we can get some more precise data on the device and update
 	// the logging string to reflect that and be more informative.
-	uint8_t busNumber = libusb_get_bus_number(libusb_get_device(state->deviceHandle));
-	uint8_t devAddress = libusb_get_device_address(libusb_get_device(state->deviceHandle));
-
+	uint8_t busNumber = 0;
+	uint8_t devAddress = 0;
 	char serialNumber[MAX_SERIAL_NUMBER_LENGTH + 1] = { 0 };
-	int getStringDescResult = libusb_get_string_descriptor_ascii(state->deviceHandle, 3, (unsigned char *) serialNumber,
-	MAX_SERIAL_NUMBER_LENGTH + 1);
 
-	// Check serial number success and length.
-	if ((getStringDescResult < 0) || (getStringDescResult > MAX_SERIAL_NUMBER_LENGTH)) {
+	if (!state->transport->info(state, &busNumber, &devAddress, serialNumber)) {
 		caerUSBLog(CAER_LOG_CRITICAL, state, "Unable to get serial number for %s device.", deviceName);
 
 		struct usb_info emptyInfo = { 0, .deviceString = NULL };
@@ -356,6 +726,12 @@ struct usb_info usbGenerateInfo(usbState state, const char *deviceName, uint16_t
 }
 
 bool usbThreadStart(usbState state) {
+	// The events of devices on a shared context are handled by its thread.
+	if (state->sharedContext != NULL) {
+		atomic_store(&state->usbThreadRun, true);
+		return (true);
+	}
+
 	// Start USB thread.
 	if ((errno = thrd_create(&state->usbThread, &usbThreadRun, state)) != thrd_success) {
 		caerUSBLog(CAER_LOG_CRITICAL, state, "Failed to create USB thread. Error: %d.", errno);
@@ -374,6 +750,10 @@ void usbThreadStop(usbState state) {
 	// Shut down USB thread.
 	atomic_store(&state->usbThreadRun, false);
 
+	if (state->sharedContext != NULL) {
+		return;
+	}
+
 	// Wait for USB thread to terminate.
 	if ((errno = thrd_join(state->usbThread, NULL)) != thrd_success) {
 		// This should never happen!
@@ -399,8 +779,14 @@ static int usbThreadRun(void *usbStatePtr) {
 	// Handle USB events (1 second timeout).
 	struct timeval te = { .tv_sec = 1, .tv_usec = 0 };
 
+	struct thread_scheduling_thread scheduling;
+	threadSchedulingThreadInit(&state->threadScheduling, &scheduling, 0);
+
 	while (atomic_load_explicit(&state->usbThreadRun, memory_order_relaxed)) {
-		libusb_handle_events_timeout(state->deviceContext, &te);
+		threadSchedulingUpdate(&state->threadScheduling, &scheduling, state->usbThreadName,
+			atomic_load_explicit(&state->usbLogLevel, memory_order_relaxed));
+
+		state->transport->handleEvents(state, &te);
 	}
 
 	caerUSBLog(CAER_LOG_DEBUG, state, "USB thread shut down.");
@@ -409,6 +795,9 @@ static int usbThreadRun(void *usbStatePtr) {
 }
 
 bool usbDataTransfersStart(usbState state) {
+	atomic_store(&state->dataBytesReceived, 0);
+	atomic_store(&state->decodeStalls, 0);
+
 	mtx_lock(&state->dataTransfersLock);
 	bool retVal = usbAllocateTransfers(state);
 	if (retVal) {
@@ -431,15 +820,51 @@ static bool usbAllocateTransfers(usbState state) {
 	uint32_t bufferNum = usbGetTransfersNumber(state);
 	uint32_t bufferSize = usbGetTransfersSize(state);
 
+	// The decode thread needs one spare buffer per transfer.
+	bool decodeThread = atomic_load(&state->decodeThreadEnabled);
+
+	if (!usbDataBuffersAllocate(state, (decodeThread) ? (2 * (size_t) bufferNum) : (bufferNum), bufferSize)) {
+		caerUSBLog(CAER_LOG_CRITICAL, state, "Failed to allocate memory for %" PRIu32 " libusb transfer buffers.",
+			bufferNum);
+		return (false);
+	}
+
+	// The decode thread must be ready before the first transfer completes.
+	if (decodeThread && !usbDecodeThreadStart(state, bufferNum, &state->dataBuffers[bufferNum])) {
+		caerUSBLog(CAER_LOG_ERROR, state, "Failed to start decode thread, decoding in USB thread instead.");
+	}
+
 	// Set number of transfers and allocate memory for the main transfer array.
 	state->dataTransfers = calloc(bufferNum, sizeof(struct libusb_transfer *));
 	if (state->dataTransfers == NULL) {
+		usbDecodeThreadStop(state);
+
 		caerUSBLog(CAER_LOG_CRITICAL, state, "Failed to allocate memory for %" PRIu32 " libusb transfers. Error: %d.",
 			bufferNum, errno);
 		return (false);
 	}
 	state->dataTransfersLength = bufferNum;
 
+	state->dataTransfersParked = calloc(bufferNum, sizeof(bool));
+	if (state->dataTransfersParked == NULL) {
+		free(state->dataTransfers);
+		state->dataTransfers = NULL;
+		state->dataTransfersLength = 0;
+
+		usbDecodeThreadStop(state);
+
+		caerUSBLog(CAER_LOG_CRITICAL, state, "Failed to allocate memory for %" PRIu32 " libusb transfers. Error: %d.",
+			bufferNum, errno);
+		return (false);
+	}
+
+	// Auto-tuning starts out from the full size/number and goes down from
+	// there, the configured values are its upper limits.
+	atomic_store(&state->autoTuneNumber, bufferNum);
+	atomic_store(&state->autoTuneSize, bufferSize);
+	portable_clock_gettime_monotonic(&state->autoTuneWindowStart);
+	state->autoTuneWindowBytes = 0;
+
 	// Allocate transfers and set them up.
 	for (size_t i = 0; i < bufferNum; i++) {
 		state->dataTransfers[i] = libusb_alloc_transfer(0);
@@ -449,18 +874,9 @@ static bool usbAllocateTransfers(usbState state) {
 			continue;
 		}
 
-		// Create data buffer.
+		// Assign data buffer, owned by the buffer pool.
 		state->dataTransfers[i]->length = (int) bufferSize;
-		state->dataTransfers[i]->buffer = malloc(bufferSize);
-		if (state->dataTransfers[i]->buffer == NULL) {
-			caerUSBLog(CAER_LOG_CRITICAL, state, "Unable to allocate buffer for libusb transfer %zu. Error: %d.", i,
-			errno);
-
-			libusb_free_transfer(state->dataTransfers[i]);
-			state->dataTransfers[i] = NULL;
-
-			continue;
-		}
+		state->dataTransfers[i]->buffer = state->dataBuffers[i];
 
 		// Initialize Transfer.
 		state->dataTransfers[i]->dev_handle = state->deviceHandle;
@@ -469,17 +885,15 @@ static bool usbAllocateTransfers(usbState state) {
 		state->dataTransfers[i]->callback = &usbDataTransferCallback;
 		state->dataTransfers[i]->user_data = state;
 		state->dataTransfers[i]->timeout = 0;
-		state->dataTransfers[i]->flags = LIBUSB_TRANSFER_FREE_BUFFER;
+		state->dataTransfers[i]->flags = 0;
 
-		if ((errno = libusb_submit_transfer(state->dataTransfers[i])) == LIBUSB_SUCCESS) {
+		if ((errno = usbTransferSubmit(state, state->dataTransfers[i])) == LIBUSB_SUCCESS) {
 			atomic_fetch_add(&state->activeDataTransfers, 1);
 		}
 		else {
 			caerUSBLog(CAER_LOG_CRITICAL, state, "Unable to submit libusb transfer %zu. Error: %s (%d).", i,
 				libusb_strerror(errno), errno);
 
-			// The transfer buffer is freed automatically here thanks to
-			// the LIBUSB_TRANSFER_FREE_BUFFER flag set above.
 			libusb_free_transfer(state->dataTransfers[i]);
 			state->dataTransfers[i] = NULL;
 		}
@@ -491,6 +905,11 @@ static bool usbAllocateTransfers(usbState state) {
 		state->dataTransfers = NULL;
 		state->dataTransfersLength = 0;
 
+		free(state->dataTransfersParked);
+		state->dataTransfersParked = NULL;
+
+		usbDecodeThreadStop(state);
+
 		caerUSBLog(CAER_LOG_CRITICAL, state, "Unable to allocate any libusb transfers.");
 		return (false);
 	}
@@ -508,7 +927,7 @@ static void usbCancelAndDeallocateTransfers(usbState state) {
 		// It seems like one cancel pass is not enough and some hang around.
 		for (size_t i = 0; i < state->dataTransfersLength; i++) {
 			if (state->dataTransfers[i] != NULL) {
-				errno = libusb_cancel_transfer(state->dataTransfers[i]);
+				errno = usbTransferCancel(state, state->dataTransfers[i]);
 				if ((errno != LIBUSB_SUCCESS) && (errno != LIBUSB_ERROR_NOT_FOUND)) {
 					caerUSBLog(CAER_LOG_CRITICAL, state, "Unable to cancel libusb transfer %zu. Error: %s (%d).", i,
 						libusb_strerror(errno), errno);
@@ -533,6 +952,247 @@ static void usbCancelAndDeallocateTransfers(usbState state) {
 	free(state->dataTransfers);
 	state->dataTransfers = NULL;
 	state->dataTransfersLength = 0;
+
+	free(state->dataTransfersParked);
+	state->dataTransfersParked = NULL;
+
+	// All data was handed over, let the decode thread finish it.
+	usbDecodeThreadStop(state);
+}
+
+// MUST LOCK ON 'dataTransfersLock'.
+static bool usbDataBuffersAllocate(usbState state, size_t bufferNum, size_t bufferSize) {
+	// Reuse the existing buffers if possible, they're not in use here.
+	if ((state->dataBuffers != NULL) && (state->dataBuffersSize == bufferSize)
+		&& (state->dataBuffersLength >= bufferNum)) {
+		return (true);
+	}
+
+	usbDataBuffersFree(state);
+
+	state->dataBuffers = calloc(bufferNum, sizeof(uint8_t *));
+	if (state->dataBuffers == NULL) {
+		return (false);
+	}
+
+	state->dataBuffersLength = bufferNum;
+	state->dataBuffersSize = bufferSize;
+
+	// Device memory is mapped to user-space by the kernel (Linux usbfs),
+	// so transfers don't need to be copied. Use it only if all buffers fit.
+	if (state->transport->memAlloc != NULL) {
+		state->dataBuffersDeviceMemory = true;
+
+		for (size_t i = 0; i < bufferNum; i++) {
+			state->dataBuffers[i] = state->transport->memAlloc(state, bufferSize);
+			if (state->dataBuffers[i] == NULL) {
+				usbDataBuffersFree(state);
+
+				// Try again with normal memory.
+				state->dataBuffers = calloc(bufferNum, sizeof(uint8_t *));
+				if (state->dataBuffers == NULL) {
+					return (false);
+				}
+
+				state->dataBuffersLength = bufferNum;
+				state->dataBuffersSize = bufferSize;
+				break;
+			}
+		}
+
+		if (state->dataBuffersDeviceMemory) {
+			caerUSBLog(CAER_LOG_DEBUG, state, "Using USB device memory for %zu transfer buffers.", bufferNum);
+			return (true);
+		}
+	}
+
+	// Aligned allocation requires the size to be a multiple of the alignment.
+	size_t alignedSize = (bufferSize + (USB_DATA_BUFFER_ALIGNMENT - 1)) & ~((size_t) USB_DATA_BUFFER_ALIGNMENT - 1);
+
+	for (size_t i = 0; i < bufferNum; i++) {
+		state->dataBuffers[i] = portable_aligned_alloc(USB_DATA_BUFFER_ALIGNMENT, alignedSize);
+		if (state->dataBuffers[i] == NULL) {
+			caerUSBLog(CAER_LOG_CRITICAL, state, "Unable to allocate buffer for libusb transfer %zu. Error: %d.", i,
+			errno);
+
+			usbDataBuffersFree(state);
+			return (false);
+		}
+	}
+
+	return (true);
+}
+
+// MUST LOCK ON 'dataTransfersLock', or be sure no transfers exist anymore.
+static void usbDataBuffersFree(usbState state) {
+	if (state->dataBuffers == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < state->dataBuffersLength; i++) {
+		if (state->dataBuffers[i] == NULL) {
+			continue;
+		}
+
+		if (state->dataBuffersDeviceMemory) {
+			state->transport->memFree(state, state->dataBuffers[i], state->dataBuffersSize);
+			continue;
+		}
+
+		portable_aligned_free(state->dataBuffers[i]);
+	}
+
+	free(state->dataBuffers);
+	state->dataBuffers = NULL;
+	state->dataBuffersLength = 0;
+	state->dataBuffersSize = 0;
+	state->dataBuffersDeviceMemory = false;
+}
+
+// MUST LOCK ON 'dataTransfersLock'.
+static bool usbDecodeThreadStart(usbState state, uint32_t bufferNum, uint8_t **spareBuffers) {
+	// One spare buffer per transfer: a completed transfer swaps its buffer
+	// with a spare one and is resubmitted at once, while the decode thread
+	// works on the data. Ring buffer sizes must be a power of two.
+	size_t ringSize = 1;
+	while (ringSize < bufferNum) {
+		ringSize <<= 1;
+	}
+
+	state->decodeBuffers = calloc(bufferNum, sizeof(struct usb_decode_buffer));
+	state->decodeFreeBuffers = caerRingBufferInit(ringSize);
+	state->decodeFullBuffers = caerRingBufferInit(ringSize);
+
+	if ((state->decodeBuffers == NULL) || (state->decodeFreeBuffers == NULL) || (state->decodeFullBuffers == NULL)) {
+		caerUSBLog(CAER_LOG_CRITICAL, state, "Failed to allocate memory for decode thread buffers.");
+		usbDecodeThreadStop(state);
+		return (false);
+	}
+
+	state->decodeBuffersLength = bufferNum;
+
+	for (size_t i = 0; i < bufferNum; i++) {
+		state->decodeBuffers[i].buffer = spareBuffers[i];
+
+		caerRingBufferPut(state->decodeFreeBuffers, &state->decodeBuffers[i]);
+	}
+
+	atomic_store(&state->decodeThreadRun, true);
+
+	if ((errno = thrd_create(&state->decodeThread, &usbDecodeThreadRun, state)) != thrd_success) {
+		caerUSBLog(CAER_LOG_CRITICAL, state, "Failed to create decode thread. Error: %d.", errno);
+		atomic_store(&state->decodeThreadRun, false);
+		usbDecodeThreadStop(state);
+		return (false);
+	}
+
+	atomic_store(&state->decodeThreadActive, true);
+
+	return (true);
+}
+
+// MUST LOCK ON 'dataTransfersLock'. No transfers may be active anymore.
+static void usbDecodeThreadStop(usbState state) {
+	if (atomic_load(&state->decodeThreadRun)) {
+		atomic_store(&state->decodeThreadRun, false);
+
+		if ((errno = thrd_join(state->decodeThread, NULL)) != thrd_success) {
+			// This should never happen!
+			caerUSBLog(CAER_LOG_CRITICAL, state, "Failed to join decode thread. Error: %d.", errno);
+		}
+	}
+
+	atomic_store(&state->decodeThreadActive, false);
+
+	// Buffers were swapped around between transfers and descriptors, but
+	// they all belong to the buffer pool, which keeps them.
+	if (state->decodeBuffers != NULL) {
+		free(state->decodeBuffers);
+		state->decodeBuffers = NULL;
+		state->decodeBuffersLength = 0;
+	}
+
+	if (state->decodeFreeBuffers != NULL) {
+		caerRingBufferFree(state->decodeFreeBuffers);
+		state->decodeFreeBuffers = NULL;
+	}
+
+	if (state->decodeFullBuffers != NULL) {
+		caerRingBufferFree(state->decodeFullBuffers);
+		state->decodeFullBuffers = NULL;
+	}
+}
+
+static int usbDecodeThreadRun(void *usbStatePtr) {
+	usbState state = usbStatePtr;
+
+	caerUSBLog(CAER_LOG_DEBUG, state, "Decode thread running.");
+
+	// Set thread name.
+	thrd_set_name(state->usbThreadName);
+
+	struct timespec noDataSleep = { .tv_sec = 0, .tv_nsec = 100000 };
+
+	struct thread_scheduling_thread scheduling;
+	threadSchedulingThreadInit(&state->threadScheduling, &scheduling, 1);
+
+	while (atomic_load_explicit(&state->decodeThreadRun, memory_order_relaxed)) {
+		threadSchedulingUpdate(&state->threadScheduling, &scheduling, state->usbThreadName,
+			atomic_load_explicit(&state->usbLogLevel, memory_order_relaxed));
+
+		usbDecodeBuffer decodeBuffer = caerRingBufferGet(state->decodeFullBuffers);
+
+		if (decodeBuffer == NULL) {
+			// Sleep for 100µs to avoid busy loop.
+			thrd_sleep(&noDataSleep, NULL);
+			continue;
+		}
+
+		(*state->usbDataCallback)(state->usbDataCallbackPtr, decodeBuffer->buffer, decodeBuffer->length);
+
+		caerRingBufferPut(state->decodeFreeBuffers, decodeBuffer);
+	}
+
+	// Stopped only after all transfers are gone: decode what is left.
+	usbDecodeBuffer decodeBuffer;
+
+	while ((decodeBuffer = caerRingBufferGet(state->decodeFullBuffers)) != NULL) {
+		(*state->usbDataCallback)(state->usbDataCallbackPtr, decodeBuffer->buffer, decodeBuffer->length);
+
+		caerRingBufferPut(state->decodeFreeBuffers, decodeBuffer);
+	}
+
+	caerUSBLog(CAER_LOG_DEBUG, state, "Decode thread shut down.");
+
+	return (EXIT_SUCCESS);
+}
+
+// Called from the USB thread: give the transfer's data to the decode
+// thread, and a spare buffer to the transfer, so it can be resubmitted.
+static void usbDecodeBufferHandOff(usbState state, struct libusb_transfer *transfer) {
+	usbDecodeBuffer decodeBuffer = caerRingBufferGet(state->decodeFreeBuffers);
+
+	if (decodeBuffer == NULL) {
+		// Decode thread is behind, wait for it to release a buffer.
+		// It never waits on the USB thread, so this always ends.
+		atomic_fetch_add(&state->decodeStalls, 1);
+
+		struct timespec waitForBufferSleep = { .tv_sec = 0, .tv_nsec = 100000 };
+
+		while ((decodeBuffer = caerRingBufferGet(state->decodeFreeBuffers)) == NULL) {
+			// Sleep for 100µs to avoid busy loop.
+			thrd_sleep(&waitForBufferSleep, NULL);
+		}
+	}
+
+	uint8_t *fullBuffer = transfer->buffer;
+	transfer->buffer = decodeBuffer->buffer;
+
+	decodeBuffer->buffer = fullBuffer;
+	decodeBuffer->length = (size_t) transfer->actual_length;
+
+	// Cannot fail, there are never more spare buffers than ring slots.
+	caerRingBufferPut(state->decodeFullBuffers, decodeBuffer);
 }
 
 static void LIBUSB_CALL usbDataTransferCallback(struct libusb_transfer *transfer) {
@@ -542,8 +1202,17 @@ static void LIBUSB_CALL usbDataTransferCallback(struct libusb_transfer *transfer
 	// if they do have data attached, try to parse them.
 	if (((transfer->status == LIBUSB_TRANSFER_COMPLETED) || (transfer->status == LIBUSB_TRANSFER_CANCELLED))
 		&& (transfer->actual_length > 0)) {
-		// Handle data.
-		(*state->usbDataCallback)(state->usbDataCallbackPtr, transfer->buffer, (size_t) transfer->actual_length);
+		atomic_fetch_add_explicit(&state->dataBytesReceived, (uint64_t) transfer->actual_length,
+			memory_order_relaxed);
+
+		if (atomic_load_explicit(&state->decodeThreadActive, memory_order_relaxed)) {
+			// Hand data to the decode thread.
+			usbDecodeBufferHandOff(state, transfer);
+		}
+		else {
+			// Handle data.
+			(*state->usbDataCallback)(state->usbDataCallbackPtr, transfer->buffer, (size_t) transfer->actual_length);
+		}
 	}
 
 	// Only status that indicates a new transfer can be really submitted is
@@ -551,8 +1220,13 @@ static void LIBUSB_CALL usbDataTransferCallback(struct libusb_transfer *transfer
 	// are not recoverable, as all of them appear on different OSes when a
 	// device is physically unplugged for example.
 	if (transfer->status == LIBUSB_TRANSFER_COMPLETED) {
+		if (atomic_load_explicit(&state->autoTuneEnabled, memory_order_relaxed) && usbAutoTune(state, transfer)) {
+			// Parked, fewer transfers are needed in flight right now.
+			return;
+		}
+
 		// Submit transfer again.
-		if (libusb_submit_transfer(transfer) == LIBUSB_SUCCESS) {
+		if (usbTransferSubmit(state, transfer) == LIBUSB_SUCCESS) {
 			return;
 		}
 	}
@@ -605,6 +1279,103 @@ static void LIBUSB_CALL usbDataTransferCallback(struct libusb_transfer *transfer
 	}
 }
 
+// Called in the USB thread for each completed data transfer, before it is
+// resubmitted. Returns true if the transfer was parked instead, in which case
+// it is not active anymore. The new size is picked up by each transfer on its
+// next resubmission, so changes spread gradually over the pool.
+static bool usbAutoTune(usbState state, struct libusb_transfer *transfer) {
+	state->autoTuneWindowBytes += (uint64_t) transfer->actual_length;
+
+	struct timespec now;
+	portable_clock_gettime_monotonic(&now);
+
+	uint64_t windowTime = (uint64_t) ((now.tv_sec - state->autoTuneWindowStart.tv_sec) * 1000000LL)
+						  + (uint64_t) ((now.tv_nsec - state->autoTuneWindowStart.tv_nsec) / 1000);
+
+	if (windowTime >= USB_AUTO_TUNE_WINDOW_US) {
+		usbAutoTuneUpdate(state, windowTime);
+
+		state->autoTuneWindowStart = now;
+		state->autoTuneWindowBytes = 0;
+	}
+
+	transfer->length = (int) atomic_load_explicit(&state->autoTuneSize, memory_order_relaxed);
+
+	// Revive parked transfers while fewer are active than wanted. They are
+	// counted before this one could be parked, so 'activeDataTransfers'
+	// never drops to zero here.
+	uint32_t number = U32T(atomic_load_explicit(&state->autoTuneNumber, memory_order_relaxed));
+	uint32_t active = U32T(atomic_load(&state->activeDataTransfers));
+
+	for (size_t i = 0; (i < state->dataTransfersLength) && (active < number); i++) {
+		if (state->dataTransfersParked[i] && usbDataTransfersAreRunning(state)) {
+			state->dataTransfers[i]->length = transfer->length;
+
+			if (usbTransferSubmit(state, state->dataTransfers[i]) == LIBUSB_SUCCESS) {
+				state->dataTransfersParked[i] = false;
+				atomic_fetch_add(&state->activeDataTransfers, 1);
+				active++;
+			}
+		}
+	}
+
+	if (active <= number) {
+		return (false);
+	}
+
+	for (size_t i = 0; i < state->dataTransfersLength; i++) {
+		if (state->dataTransfers[i] == transfer) {
+			state->dataTransfersParked[i] = true;
+			atomic_fetch_sub(&state->activeDataTransfers, 1);
+			return (true);
+		}
+	}
+
+	return (false);
+}
+
+static void usbAutoTuneUpdate(usbState state, uint64_t windowTime) {
+	uint64_t bytesPerSecond = (state->autoTuneWindowBytes * 1000000) / windowTime;
+
+	// Size transfers to fill up in the target latency, limited by the
+	// configured buffer size. Grow right away to keep up with rising rates,
+	// but only shrink once much less is needed, to not oscillate.
+	uint64_t maxSize = usbGetTransfersSize(state);
+	uint64_t size = (bytesPerSecond * atomic_load(&state->autoTuneLatency)) / 1000000;
+
+	size = ((size / USB_AUTO_TUNE_SIZE_STEP) + 1) * USB_AUTO_TUNE_SIZE_STEP;
+	if (size > maxSize) {
+		size = maxSize;
+	}
+
+	uint64_t currentSize = atomic_load_explicit(&state->autoTuneSize, memory_order_relaxed);
+
+	if ((size > currentSize) || ((size * 2) < currentSize)) {
+		atomic_store(&state->autoTuneSize, size);
+		currentSize = size;
+	}
+
+	// Keep enough transfers in flight to absorb short stalls in the USB
+	// thread. Grow right away, shrink one transfer at a time.
+	uint64_t maxNumber = state->dataTransfersLength;
+	uint64_t number = (((bytesPerSecond * USB_AUTO_TUNE_QUEUE_US) / 1000000) / currentSize) + 1;
+
+	if (number < USB_AUTO_TUNE_MIN_NUMBER) {
+		number = USB_AUTO_TUNE_MIN_NUMBER;
+	}
+	if (number > maxNumber) {
+		number = maxNumber;
+	}
+
+	uint64_t currentNumber = atomic_load_explicit(&state->autoTuneNumber, memory_order_relaxed);
+
+	if (number < currentNumber) {
+		number = currentNumber - 1;
+	}
+
+	atomic_store(&state->autoTuneNumber, number);
+}
+
 static bool usbControlTransferAsync(usbState state, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint8_t *data,
 	size_t dataSize, void (*controlOutCallback)(void *controlOutCallbackPtr, int status),
 	void (*controlInCallback)(void *controlInCallbackPtr, int status, const uint8_t *buffer, size_t bufferSize),
@@ -647,6 +1418,7 @@ static bool usbControlTransferAsync(usbState state, uint8_t bRequest, uint16_t w
 		extraControlData->controlInCallback = controlInCallback;
 	}
 	extraControlData->controlCallbackPtr = controlCallbackPtr;
+	extraControlData->state = state;
 
 	// Initialize Transfer.
 	uint8_t direction = (directionOut) ? (LIBUSB_ENDPOINT_OUT) : (LIBUSB_ENDPOINT_IN);
@@ -664,7 +1436,7 @@ static bool usbControlTransferAsync(usbState state, uint8_t bRequest, uint16_t w
 		memcpy(controlTransferBuffer + LIBUSB_CONTROL_SETUP_SIZE, data, dataSize);
 	}
 
-	if ((errno = libusb_submit_transfer(controlTransfer)) != LIBUSB_SUCCESS) {
+	if ((errno = usbTransferSubmit(state, controlTransfer)) != LIBUSB_SUCCESS) {
 		// The transfer buffer is freed automatically here thanks to
 		// the LIBUSB_TRANSFER_FREE_BUFFER flag set above.
 		libusb_free_transfer(controlTransfer);
@@ -677,6 +1449,11 @@ static bool usbControlTransferAsync(usbState state, uint8_t bRequest, uint16_t w
 
 bool usbControlTransferOutAsync(usbState state, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint8_t *data,
 	size_t dataSize, void (*controlOutCallback)(void *controlOutCallbackPtr, int status), void *controlOutCallbackPtr) {
+	// Queued configuration must reach the device before anything else.
+	if (spiConfigBatchActive(state) && !spiConfigBatchFlush(state)) {
+		return (false);
+	}
+
 	return (usbControlTransferAsync(state, bRequest, wValue, wIndex, data, dataSize, controlOutCallback, NULL,
 		controlOutCallbackPtr, true));
 }
@@ -684,6 +1461,11 @@ bool usbControlTransferOutAsync(usbState state, uint8_t bRequest, uint16_t wValu
 bool usbControlTransferInAsync(usbState state, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, size_t dataSize,
 	void (*controlInCallback)(void *controlInCallbackPtr, int status, const uint8_t *buffer, size_t bufferSize),
 	void *controlInCallbackPtr) {
+	// Queued configuration must reach the device before anything else.
+	if (spiConfigBatchActive(state) && !spiConfigBatchFlush(state)) {
+		return (false);
+	}
+
 	return (usbControlTransferAsync(state, bRequest, wValue, wIndex, NULL, dataSize, NULL, controlInCallback,
 		controlInCallbackPtr, false));
 }
@@ -694,6 +1476,9 @@ bool usbControlTransferInAsync(usbState state, uint8_t bRequest, uint16_t wValue
 static void LIBUSB_CALL usbControlOutCallback(struct libusb_transfer *transfer) {
 	usbControl extraControlData = transfer->user_data;
 
+	// Update before notifying, so that waiters see the new values.
+	spiConfigShadowUpdate(extraControlData->state, transfer);
+
 	if (extraControlData->controlOutCallback != NULL) {
 		(*extraControlData->controlOutCallback)(extraControlData->controlCallbackPtr, transfer->status);
 	}
@@ -798,7 +1583,183 @@ static void syncControlInCallback(void *controlInCallbackPtr, int status, const
 	}
 }
 
+static inline bool spiConfigBatchActive(usbState state) {
+	mtx_lock(&state->spiConfigBatchLock);
+
+	bool active = ((state->spiConfigBatchDepth > 0) && thrd_equal(state->spiConfigBatchThread, thrd_current()));
+
+	mtx_unlock(&state->spiConfigBatchLock);
+
+	return (active);
+}
+
+void spiConfigBatchBegin(usbState state) {
+	mtx_lock(&state->spiConfigBatchLock);
+
+	if (state->spiConfigBatchDepth == 0) {
+		state->spiConfigBatchThread = thrd_current();
+		state->spiConfigBatchNumber = 0;
+		atomic_store(&state->spiConfigBatchFailed, false);
+	}
+	else if (!thrd_equal(state->spiConfigBatchThread, thrd_current())) {
+		// Batch owned by another thread, configuration from this one
+		// is sent directly, see spiConfigBatchActive().
+		mtx_unlock(&state->spiConfigBatchLock);
+		return;
+	}
+
+	state->spiConfigBatchDepth++;
+
+	mtx_unlock(&state->spiConfigBatchLock);
+}
+
+bool spiConfigBatchEnd(usbState state) {
+	mtx_lock(&state->spiConfigBatchLock);
+
+	if ((state->spiConfigBatchDepth == 0) || !thrd_equal(state->spiConfigBatchThread, thrd_current())) {
+		mtx_unlock(&state->spiConfigBatchLock);
+		return (true);
+	}
+
+	if (state->spiConfigBatchDepth > 1) {
+		// Nested batch, the outermost one sends everything.
+		state->spiConfigBatchDepth--;
+
+		mtx_unlock(&state->spiConfigBatchLock);
+		return (!atomic_load(&state->spiConfigBatchFailed));
+	}
+
+	mtx_unlock(&state->spiConfigBatchLock);
+
+	// Only the owner gets here, other threads keep sending directly.
+	spiConfigBatchFlush(state);
+
+	mtx_lock(&state->spiConfigBatchLock);
+	state->spiConfigBatchDepth = 0;
+	mtx_unlock(&state->spiConfigBatchLock);
+
+	// Wait for all queued transfers to complete.
+	struct timespec waitForCompletionSleep = { .tv_sec = 0, .tv_nsec = 100000 };
+
+	while (atomic_load(&state->spiConfigBatchInFlight) > 0) {
+		// Sleep for 100µs to avoid busy loop.
+		thrd_sleep(&waitForCompletionSleep, NULL);
+	}
+
+	return (!atomic_load(&state->spiConfigBatchFailed));
+}
+
+static bool spiConfigBatchFlush(usbState state) {
+	if (state->spiConfigBatchNumber == 0) {
+		return (true);
+	}
+
+	size_t configNum = state->spiConfigBatchNumber;
+	state->spiConfigBatchNumber = 0;
+
+	// Limit transfers in flight, to not flood the device's control endpoint.
+	struct timespec waitForCompletionSleep = { .tv_sec = 0, .tv_nsec = 100000 };
+
+	while (atomic_load(&state->spiConfigBatchInFlight) >= SPI_CONFIG_MAX_TRANSFERS) {
+		// Sleep for 100µs to avoid busy loop.
+		thrd_sleep(&waitForCompletionSleep, NULL);
+	}
+
+	atomic_fetch_add(&state->spiConfigBatchInFlight, 1);
+
+	// Data is copied at submission, the batch buffer can be reused right away.
+	if (!usbControlTransferAsync(state, VENDOR_REQUEST_FPGA_CONFIG_MULTIPLE, U16T(configNum), 0,
+		state->spiConfigBatch, configNum * SPI_CONFIG_MSG_SIZE, &spiConfigBatchCallback, NULL, state, true)) {
+		atomic_fetch_sub(&state->spiConfigBatchInFlight, 1);
+		atomic_store(&state->spiConfigBatchFailed, true);
+
+		caerUSBLog(CAER_LOG_ERROR, state, "Failed to send batch of %zu configuration parameters.", configNum);
+
+		return (false);
+	}
+
+	return (true);
+}
+
+static void spiConfigBatchCallback(void *configBatchCallbackPtr, int status) {
+	usbState state = configBatchCallbackPtr;
+
+	if (status != LIBUSB_TRANSFER_COMPLETED) {
+		atomic_store(&state->spiConfigBatchFailed, true);
+	}
+
+	atomic_fetch_sub(&state->spiConfigBatchInFlight, 1);
+}
+
+void spiConfigShadowClear(usbState state) {
+	for (size_t mod = 0; mod < SPI_CONFIG_SHADOW_MODULES; mod++) {
+		for (size_t param = 0; param < SPI_CONFIG_SHADOW_PARAMS; param++) {
+			atomic_store_explicit(&state->spiConfigShadow[mod][param], 0, memory_order_relaxed);
+		}
+	}
+}
+
+static inline void spiConfigShadowStore(usbState state, uint8_t moduleAddr, uint8_t paramAddr, const uint8_t *value,
+	bool valid) {
+	if (moduleAddr >= SPI_CONFIG_SHADOW_MODULES) {
+		return;
+	}
+
+	uint64_t entry = 0;
+
+	// Failed writes leave the register in an unknown state.
+	if (valid) {
+		entry = SPI_CONFIG_SHADOW_VALID | U32T(value[0] << 24) | U32T(value[1] << 16) | U32T(value[2] << 8)
+				| U32T(value[3] << 0);
+	}
+
+	atomic_store(&state->spiConfigShadow[moduleAddr][paramAddr], entry);
+}
+
+// Called on completion of every control OUT transfer: track the values
+// of completed SPI configuration writes, single or multiple.
+static void spiConfigShadowUpdate(usbState state, struct libusb_transfer *transfer) {
+	struct libusb_control_setup *setup = libusb_control_transfer_get_setup(transfer);
+	const uint8_t *data = libusb_control_transfer_get_data(transfer);
+	bool completed = (transfer->status == LIBUSB_TRANSFER_COMPLETED);
+
+	if (setup->bRequest == VENDOR_REQUEST_FPGA_CONFIG) {
+		if (libusb_le16_to_cpu(setup->wLength) == 4) {
+			spiConfigShadowStore(state, U8T(libusb_le16_to_cpu(setup->wValue)),
+				U8T(libusb_le16_to_cpu(setup->wIndex)), data, completed);
+		}
+	}
+	else if (setup->bRequest == VENDOR_REQUEST_FPGA_CONFIG_MULTIPLE) {
+		size_t configNum = libusb_le16_to_cpu(setup->wLength) / SPI_CONFIG_MSG_SIZE;
+
+		for (size_t i = 0; i < configNum; i++) {
+			const uint8_t *spiConfigMsg = &data[i * SPI_CONFIG_MSG_SIZE];
+
+			spiConfigShadowStore(state, spiConfigMsg[0], spiConfigMsg[1], &spiConfigMsg[2], completed);
+		}
+	}
+}
+
 bool spiConfigSend(usbState state, uint8_t moduleAddr, uint8_t paramAddr, uint32_t param) {
+	if (spiConfigBatchActive(state)) {
+		uint8_t *spiConfigMsg = &state->spiConfigBatch[state->spiConfigBatchNumber * SPI_CONFIG_MSG_SIZE];
+
+		spiConfigMsg[0] = moduleAddr;
+		spiConfigMsg[1] = paramAddr;
+		spiConfigMsg[2] = U8T(param >> 24);
+		spiConfigMsg[3] = U8T(param >> 16);
+		spiConfigMsg[4] = U8T(param >> 8);
+		spiConfigMsg[5] = U8T(param >> 0);
+
+		state->spiConfigBatchNumber++;
+
+		if (state->spiConfigBatchNumber == SPI_CONFIG_MAX) {
+			return (spiConfigBatchFlush(state));
+		}
+
+		return (true);
+	}
+
 	uint8_t spiConfig[4] = { 0 };
 
 	spiConfig[0] = U8T(param >> 24);
@@ -839,6 +1800,32 @@ bool spiConfigReceive(usbState state, uint8_t moduleAddr, uint8_t paramAddr, uin
 	return (true);
 }
 
+bool spiConfigReceiveCached(usbState state, uint8_t moduleAddr, uint8_t paramAddr, uint32_t *param) {
+	bool cacheable = (moduleAddr < SPI_CONFIG_SHADOW_MODULES) && atomic_load(&state->spiConfigShadowEnabled);
+
+	if (cacheable) {
+		uint64_t entry = atomic_load(&state->spiConfigShadow[moduleAddr][paramAddr]);
+
+		if (entry & SPI_CONFIG_SHADOW_VALID) {
+			*param = U32T(entry);
+			return (true);
+		}
+	}
+
+	if (!spiConfigReceive(state, moduleAddr, paramAddr, param)) {
+		return (false);
+	}
+
+	if (cacheable) {
+		// Don't overwrite a value from a write that completed meanwhile.
+		uint_fast64_t expected = 0;
+		atomic_compare_exchange_strong(&state->spiConfigShadow[moduleAddr][paramAddr], &expected,
+			SPI_CONFIG_SHADOW_VALID | *param);
+	}
+
+	return (true);
+}
+
 bool spiConfigReceiveAsync(usbState state, uint8_t moduleAddr, uint8_t paramAddr,
 	void (*configReceiveCallback)(void *configReceiveCallbackPtr, int status, uint32_t param),
 	void *configReceiveCallbackPtr) {
@@ -3,6 +3,8 @@
 
 #include "libcaer.h"
 #include "devices/usb.h"
+#include "ringbuffer.h"
+#include "thread_scheduling.h"
 #include <libusb.h>
 #include <stdatomic.h>
 
@@ -19,18 +21,63 @@
 #define VENDOR_REQUEST_FPGA_CONFIG          0xBF
 #define VENDOR_REQUEST_FPGA_CONFIG_MULTIPLE 0xC2
 
+// Multi-config requests carry up to SPI_CONFIG_MAX messages of
+// SPI_CONFIG_MSG_SIZE bytes (module, parameter, 4 value bytes).
+#define SPI_CONFIG_MSG_SIZE 6
+#define SPI_CONFIG_MAX      85
+// Maximum number of multi-config USB transfers in flight at the same time.
+#define SPI_CONFIG_MAX_TRANSFERS 8
+
+// Host-side copy of the SPI configuration registers, see spiConfigReceiveCached().
+#define SPI_CONFIG_SHADOW_MODULES 32
+#define SPI_CONFIG_SHADOW_PARAMS  256
+#define SPI_CONFIG_SHADOW_VALID   (UINT64_C(1) << 32)
+
 enum { TRANS_STOPPED = 0, TRANS_RUNNING = 1 };
 
+struct usb_state;
+struct usb_shared_context;
+
+// Everything usb_utils does with the device goes through a transport: real
+// hardware via libusb, or the in-process mock (see usb_mock.c), selected in
+// usbDeviceOpen(). Control and data transfers are both libusb_transfer
+// structures; the transport completes them by calling their callback from
+// handleEvents(), which runs in the USB thread.
+struct usb_transport {
+	const char *name;
+	bool (*open)(struct usb_state *state, uint16_t devVID, uint16_t devPID, uint8_t busNumber, uint8_t devAddress,
+		const char *serialNumber, int32_t requiredLogicRevision, int32_t requiredFirmwareVersion);
+	void (*close)(struct usb_state *state);
+	bool (*info)(struct usb_state *state, uint8_t *busNumber, uint8_t *devAddress,
+		char serialNumber[MAX_SERIAL_NUMBER_LENGTH + 1]);
+	int (*submitTransfer)(struct usb_state *state, struct libusb_transfer *transfer);
+	int (*cancelTransfer)(struct usb_state *state, struct libusb_transfer *transfer);
+	void (*handleEvents)(struct usb_state *state, struct timeval *timeout);
+	// Optional (NULL if not supported): DMA-able memory for data transfers.
+	uint8_t *(*memAlloc)(struct usb_state *state, size_t size);
+	void (*memFree)(struct usb_state *state, uint8_t *buffer, size_t size);
+};
+
+extern const struct usb_transport usbTransportLibUSB;
+extern const struct usb_transport usbTransportMock;
+
 struct usb_state {
 	// Per-device log-level (USB functions)
 	atomic_uint_fast8_t usbLogLevel;
 	// USB Device State
+	const struct usb_transport *transport;
+	void *transportState;
 	libusb_context *deviceContext;
 	libusb_device_handle *deviceHandle;
+	// Shared context in use (see caerDeviceUSBSharedContextSet()), NULL if the
+	// device has its own context and USB thread.
+	struct usb_shared_context *sharedContext;
 	// USB thread state
 	char usbThreadName[MAX_THREAD_NAME_LENGTH + 1]; // +1 for terminating NUL character.
 	thrd_t usbThread;
 	atomic_bool usbThreadRun;
+	// Scheduling of the USB and decode threads (see CAER_HOST_CONFIG_THREAD).
+	struct thread_scheduling threadScheduling;
 	// USB Data Transfers
 	atomic_uint_fast32_t usbBufferNumber;
 	atomic_uint_fast32_t usbBufferSize;
@@ -39,14 +86,56 @@ struct usb_state {
 	mtx_t dataTransfersLock;
 	struct libusb_transfer **dataTransfers; // LOCK PROTECTED.
 	uint32_t dataTransfersLength; // LOCK PROTECTED.
+	// USB Data Transfers buffers, kept until the size/number changes or
+	// the device is closed. From libusb_dev_mem_alloc() if possible.
+	uint8_t **dataBuffers; // LOCK PROTECTED.
+	size_t dataBuffersLength; // LOCK PROTECTED.
+	size_t dataBuffersSize; // LOCK PROTECTED.
+	bool dataBuffersDeviceMemory; // LOCK PROTECTED.
 	atomic_uint_fast32_t activeDataTransfers;
 	uint32_t failedDataTransfers;
+	// Decode thread (see CAER_HOST_CONFIG_USB_DECODE_THREAD).
+	atomic_bool decodeThreadEnabled;
+	atomic_bool decodeThreadActive;
+	atomic_bool decodeThreadRun;
+	thrd_t decodeThread;
+	struct usb_decode_buffer *decodeBuffers; // LOCK PROTECTED.
+	size_t decodeBuffersLength; // LOCK PROTECTED.
+	caerRingBuffer decodeFreeBuffers;
+	caerRingBuffer decodeFullBuffers;
+	// Transfer auto-tuning (see CAER_HOST_CONFIG_USB_AUTO_TUNE). Parked
+	// transfers are allocated but not submitted. The window counters are
+	// only used by the USB thread.
+	atomic_bool autoTuneEnabled;
+	atomic_uint_fast32_t autoTuneLatency;
+	atomic_uint_fast32_t autoTuneNumber;
+	atomic_uint_fast32_t autoTuneSize;
+	bool *dataTransfersParked; // LOCK PROTECTED.
+	struct timespec autoTuneWindowStart;
+	uint64_t autoTuneWindowBytes;
+	// USB Data Transfers statistics
+	atomic_uint_fast64_t dataBytesReceived;
+	atomic_uint_fast64_t decodeStalls;
 	// USB Data Transfers handling callback
 	void (*usbDataCallback)(void *usbDataCallbackPtr, const uint8_t *buffer, size_t bytesSent);
 	void *usbDataCallbackPtr;
 	// USB Data Transfers shutdown callback
 	void (*usbShutdownCallback)(void *usbShutdownCallbackPtr);
 	void *usbShutdownCallbackPtr;
+	// SPI configuration batching (see spiConfigBatchBegin()). Only the thread
+	// that started the batch touches the buffer, others send directly.
+	// Depth and owning thread are guarded by the lock.
+	mtx_t spiConfigBatchLock;
+	uint32_t spiConfigBatchDepth;
+	thrd_t spiConfigBatchThread;
+	uint8_t spiConfigBatch[SPI_CONFIG_MAX * SPI_CONFIG_MSG_SIZE];
+	size_t spiConfigBatchNumber;
+	atomic_uint_fast32_t spiConfigBatchInFlight;
+	atomic_bool spiConfigBatchFailed;
+	// SPI configuration shadow: value in the lower 32 bits, valid if
+	// SPI_CONFIG_SHADOW_VALID is set. Updated when writes complete.
+	atomic_bool spiConfigShadowEnabled;
+	atomic_uint_fast64_t spiConfigShadow[SPI_CONFIG_SHADOW_MODULES][SPI_CONFIG_SHADOW_PARAMS];
 };
 
 typedef struct usb_state *usbState;
@@ -72,6 +161,19 @@ void usbSetTransfersNumber(usbState state, uint32_t transfersNumber);
 void usbSetTransfersSize(usbState state, uint32_t transfersSize);
 uint32_t usbGetTransfersNumber(usbState state);
 uint32_t usbGetTransfersSize(usbState state);
+void usbSetDecodeThread(usbState state, bool decodeThread);
+bool usbGetDecodeThread(usbState state);
+void usbSetAutoTune(usbState state, bool autoTune);
+bool usbGetAutoTune(usbState state);
+void spiConfigShadowClear(usbState state);
+
+static inline int usbTransferSubmit(usbState state, struct libusb_transfer *transfer) {
+	return (state->transport->submitTransfer(state, transfer));
+}
+
+static inline int usbTransferCancel(usbState state, struct libusb_transfer *transfer) {
+	return (state->transport->cancelTransfer(state, transfer));
+}
 
 static inline bool usbConfigSet(usbState state, uint8_t paramAddr, uint32_t param) {
 	switch (paramAddr) {
@@ -83,6 +185,33 @@ static inline bool usbConfigSet(usbState state, uint8_t paramAddr, uint32_t para
 			usbSetTransfersSize(state, param);
 			break;
 
+		case CAER_HOST_CONFIG_USB_CONFIG_CACHE:
+			atomic_store(&state->spiConfigShadowEnabled, param);
+			spiConfigShadowClear(state);
+			break;
+
+		case CAER_HOST_CONFIG_USB_CONFIG_CACHE_REFRESH:
+			if (param) {
+				spiConfigShadowClear(state);
+			}
+			break;
+
+		case CAER_HOST_CONFIG_USB_DECODE_THREAD:
+			usbSetDecodeThread(state, param);
+			break;
+
+		case CAER_HOST_CONFIG_USB_AUTO_TUNE:
+			usbSetAutoTune(state, param);
+			break;
+
+		case CAER_HOST_CONFIG_USB_AUTO_TUNE_LATENCY:
+			if (param == 0) {
+				return (false);
+			}
+
+			atomic_store(&state->autoTuneLatency, param);
+			break;
+
 		default:
 			return (false);
 			break;
@@ -101,6 +230,51 @@ static inline bool usbConfigGet(usbState state, uint8_t paramAddr, uint32_t *par
 			*param = usbGetTransfersSize(state);
 			break;
 
+		case CAER_HOST_CONFIG_USB_CONFIG_CACHE:
+			*param = atomic_load(&state->spiConfigShadowEnabled);
+			break;
+
+		case CAER_HOST_CONFIG_USB_CONFIG_CACHE_REFRESH:
+			// Impulse, always false.
+			*param = false;
+			break;
+
+		case CAER_HOST_CONFIG_USB_DECODE_THREAD:
+			*param = usbGetDecodeThread(state);
+			break;
+
+		case CAER_HOST_CONFIG_USB_AUTO_TUNE:
+			*param = usbGetAutoTune(state);
+			break;
+
+		case CAER_HOST_CONFIG_USB_AUTO_TUNE_LATENCY:
+			*param = U32T(atomic_load(&state->autoTuneLatency));
+			break;
+
+		case CAER_HOST_CONFIG_USB_AUTO_TUNE_BUFFER_NUMBER:
+			*param = U32T(atomic_load(&state->autoTuneNumber));
+			break;
+
+		case CAER_HOST_CONFIG_USB_AUTO_TUNE_BUFFER_SIZE:
+			*param = U32T(atomic_load(&state->autoTuneSize));
+			break;
+
+		case CAER_HOST_CONFIG_USB_STATISTICS_BYTES:
+			*param = U32T(atomic_load(&state->dataBytesReceived) >> 32);
+			break;
+
+		case CAER_HOST_CONFIG_USB_STATISTICS_BYTES + 1:
+			*param = U32T(atomic_load(&state->dataBytesReceived));
+			break;
+
+		case CAER_HOST_CONFIG_USB_STATISTICS_DECODE_STALLS:
+			*param = U32T(atomic_load(&state->decodeStalls) >> 32);
+			break;
+
+		case CAER_HOST_CONFIG_USB_STATISTICS_DECODE_STALLS + 1:
+			*param = U32T(atomic_load(&state->decodeStalls));
+			break;
+
 		default:
 			return (false);
 			break;
@@ -130,10 +304,21 @@ bool usbControlTransferOut(usbState state, uint8_t bRequest, uint16_t wValue, ui
 bool usbControlTransferIn(usbState state, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint8_t *data,
 	size_t dataSize);
 
+// While a batch is open, spiConfigSend() calls from the same thread are
+// queued and sent as pipelined multi-config requests. Any other control
+// transfer from that thread sends out the queued ones first, so ordering
+// is kept. Batches nest, spiConfigBatchEnd() returns false if any queued
+// configuration failed. Only one thread at a time should open batches.
+void spiConfigBatchBegin(usbState state);
+bool spiConfigBatchEnd(usbState state);
+
 bool spiConfigSend(usbState state, uint8_t moduleAddr, uint8_t paramAddr, uint32_t param);
 bool spiConfigSendAsync(usbState state, uint8_t moduleAddr, uint8_t paramAddr, uint32_t param,
 	void (*configSendCallback)(void *configSendCallbackPtr, int status), void *configSendCallbackPtr);
 bool spiConfigReceive(usbState state, uint8_t moduleAddr, uint8_t paramAddr, uint32_t *param);
+// Same as spiConfigReceive(), but served from the configuration shadow if
+// possible. Only use for registers the device never changes on its own.
+bool spiConfigReceiveCached(usbState state, uint8_t moduleAddr, uint8_t paramAddr, uint32_t *param);
 bool spiConfigReceiveAsync(usbState state, uint8_t moduleAddr, uint8_t paramAddr,
 	void (*configReceiveCallback)(void *configReceiveCallbackPtr, int status, uint32_t param),
 	void *configReceiveCallbackPtr);